@@ -5,6 +5,7 @@
 // * synchronization only
 // * synchronization with kernel launch
 // * kernel launch without synchronization
+// * mark insert and wait, timeline signal and wait
 // * empty kernel with varying number of
 //   parameters, mesh and bundle size
 
@@ -18,7 +19,8 @@
 
 
 const char * ops_tbl[] = { "sync", "synck", "kern",
-                           "params", "ctx", "ctxfeed"
+                           "params", "ctx", "ctxfeed",
+                           "markwait", "tlwait"
                          };
 
 using namespace boost::aura;
@@ -59,6 +61,19 @@ inline void run_kern(feed & f, kernel & k)
 	invoke(k, mesh(1), bundle(1), f);
 }
 
+inline void run_markwait(feed & f, kernel & k)
+{
+	invoke(k, mesh(1), bundle(1), f);
+	mark m(f);
+	wait_for(m);
+}
+
+inline void run_tlwait(timeline & t, feed & f, kernel & k)
+{
+	invoke(k, mesh(1), bundle(1), f);
+	t.wait(t.signal());
+}
+
 inline void run_params(feed & f, kernel & k,
                        svec<std::size_t, AURA_MAX_MESH_DIMS> & mesh,
                        svec<std::size_t, AURA_MAX_BUNDLE_DIMS> & bundle,
@@ -170,6 +185,23 @@ inline void run_tests(
 					min, max, mean, stdev, runs, runtime);
 			wait_for(f); // we did not synchronize in this benchmark
 		}
+		if(ops[6]) { // markwait
+			kernel nak = create_kernel(m, "kernel_0arg");
+			run_markwait(f, nak); // dry run
+			AURA_BENCHMARK(run_markwait(f, nak), runtime, 
+					min, max, mean, stdev, runs);
+			print_benchmark_results(ops_tbl[6], 
+					min, max, mean, stdev, runs, runtime);
+		}
+		if(ops[7]) { // tlwait
+			kernel nak = create_kernel(m, "kernel_0arg");
+			timeline t(f);
+			run_tlwait(t, f, nak); // dry run
+			AURA_BENCHMARK(run_tlwait(t, f, nak), runtime, 
+					min, max, mean, stdev, runs);
+			print_benchmark_results(ops_tbl[7], 
+					min, max, mean, stdev, runs, runtime);
+		}
 		if(ops[3]) { // params
 			for(std::size_t p=0; p<params.size(); p++) {
 
@@ -184,7 +216,7 @@ inline void run_tests(
 						run_params(f, k, meshes[m], bundles[b], params[p][0]);
 						AURA_BENCHMARK(run_params(f, k, meshes[m], bundles[b],
 						                          params[p][0]), runtime, min, max, mean, stdev, runs);
-						std::cout << ops_tbl[6] << "m (" << meshes[m] << ") b (" <<
+						std::cout << ops_tbl[3] << "m (" << meshes[m] << ") b (" <<
 						          bundles[m] << ") p " << params[p][0] << " min " << min <<
 						          " max " << max << " mean " << mean << " stdev " << stdev <<
 						          " runs " << runs << " runtime " << runtime << std::endl;
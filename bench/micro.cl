@@ -8,6 +8,12 @@ __kernel void simple_add(__global float * A)
 	A[id] += 1.0;
 }
 
+__kernel void mixed_args(__global float * A, char c, int i, float f)
+{
+	int id = get_mesh_id();
+	A[id] = c + i + f;
+}
+
 __kernel void four_mad(__global float * A)
 {
 	int id = get_mesh_id();
@@ -1,6 +1,9 @@
 // run various micro-benchmarks (simple kernels)
 
+#include <new>
+#include <atomic>
 #include <vector>
+#include <cstdlib>
 #include <boost/aura/backend.hpp>
 #include <boost/aura/misc/benchmark.hpp>
 
@@ -15,6 +18,38 @@ const char * kernel_file = "bench/micro.ptx";
 // run each subtest for a specific number of seconds
 const int duration_per_test = 2*1e6;
 
+// count heap allocations made through malloc and operator new, packed
+// arguments were allocated with malloc, drivers may allocate as well
+std::atomic<std::size_t> num_allocations(0);
+
+#ifdef __GLIBC__
+extern "C" void* __libc_malloc(std::size_t size);
+
+extern "C" void* malloc(std::size_t size)
+{
+	num_allocations++;
+	return __libc_malloc(size);
+}
+#endif
+
+void* operator new(std::size_t size)
+{
+#ifndef __GLIBC__
+	// malloc is not interposed, count operator new only
+	num_allocations++;
+#endif
+	void* p = std::malloc(size);
+	if (nullptr == p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
 // benchmark how long it takes to launch an empty kernel on 1...N GPUs
 
 inline void bench_noarg_expr(std::vector<feed> & feeds,
@@ -106,6 +141,35 @@ void bench_onearg(std::vector<device> & devices,
 
 // ----
 
+// count heap allocations per kernel launch with mixed size arguments
+
+void bench_alloc(std::vector<device> & devices,
+                 std::vector<feed> & feeds, std::size_t size)
+{
+	const std::size_t launches = 1000;
+	module m = create_module_from_file(kernel_file, devices[0],
+	                                   AURA_BACKEND_COMPILE_FLAGS);
+	kernel k = create_kernel(m, "mixed_args");
+	device_ptr<float> dm = device_malloc<float>(size, devices[0]);
+	invoke(k, size, args(dm.get_base(), (char)1, (int)2, (float)3.),
+	       feeds[0]);
+	wait_for(feeds[0]);
+
+	std::size_t before = num_allocations;
+	for(std::size_t n=0; n<launches; n++) {
+		invoke(k, size, args(dm.get_base(), (char)1, (int)2, (float)3.),
+		       feeds[0]);
+	}
+	std::size_t after = num_allocations;
+	wait_for(feeds[0]);
+	printf("mixed_args_kernel (%ld): launches %lu allocations %lu "
+	       "per launch %f\n", size, launches, after-before,
+	       (double)(after-before)/launches);
+	device_free(dm);
+}
+
+// ----
+
 int main()
 {
 	initialize();
@@ -120,6 +184,7 @@ int main()
 		feeds.push_back(feed(devices[n]));
 	}
 
+	bench_alloc(devices, feeds, 1024);
 	bench_noarg(devices, feeds, "noarg");
 	bench_onearg(devices, feeds, "simple_add", 32, 32, 32, 32);
 	bench_onearg(devices, feeds, "four_mad", 32, 32, 32, 32);
@@ -6,6 +6,12 @@ extern "C" __global__ void simple_add(float * A)
 	A[id] += 1.0;
 }
 
+extern "C" __global__ void mixed_args(float * A, char c, int i, float f)
+{
+	int id = blockIdx.x * blockDim.x + threadIdx.x;
+	A[id] = c + i + f;
+}
+
 extern "C" __global__ void four_mad(float * A)
 {
 	int id = blockIdx.x * blockDim.x + threadIdx.x;
@@ -8,6 +8,8 @@
 // * ondevice throughput (triad)
 // * bus throughput (host to device)
 // * bus throughput (device to host)
+// * bus throughput with pinned host memory (host to device, device to host)
+// * pinned host memory allocation (one vector per frame)
 
 
 #include <iostream>
@@ -21,7 +23,7 @@
 
 const char * ops_tbl[] = { "sflop", "dflop", "devcopy", "devscale",
                            "devadd", "devtriad", "tphtd", "tpdth",
-			   "tphtdp", "tpdthp"
+			   "tphtdp", "tpdthp", "pinalloc"
                          };
 
 using namespace boost::aura;
@@ -59,6 +61,17 @@ inline void run_device_to_host_pinned(feed & f,
 	wait_for(f);
 }
 
+/// allocate a pinned vector, upload it and free it (a frame)
+inline void run_host_to_device_pinned_alloc(feed & f,
+		device_ptr<float> dst, std::size_t size)
+{
+	boost::aura::host_allocator<float> alloc(f);
+	std::vector<float, boost::aura::host_allocator<float>> src(
+			size, alloc);
+	copy(dst, &src[0], src.size(), f);
+	wait_for(f);
+}
+
 
 template <typename T>
 inline void run_kernel(feed & f, kernel & k,
@@ -546,6 +559,26 @@ inline void run_tests(
 		}
 	}
 
+	if(ops[10]) { // pinalloc
+		for(std::size_t s=0; s<sizes.size(); s++) {
+			device_ptr<float> m =
+			        device_malloc<float>(sizes[s][0], d);
+			// the first frame pins memory, later frames reuse it
+			run_host_to_device_pinned_alloc(f, m, sizes[s][0]);
+			AURA_BENCHMARK(run_host_to_device_pinned_alloc(f, m,
+						sizes[s][0]),
+			               runtime, min, max, mean, stdev, runs);
+			std::cout << ops_tbl[10] << " " << sizes[s] <<
+			          " min " << min << " max " << max <<
+			          " mean " << mean << " stdev " <<
+			          stdev << " runs " << runs <<
+			          " runtime " << runtime << " pooled " <<
+			          d.get_context()->get_host_pool().size() <<
+			          std::endl;
+			device_free(m);
+		}
+	}
+
 }
 
 
@@ -0,0 +1,174 @@
+#ifndef AURA_AUTOTUNE_HPP
+#define AURA_AUTOTUNE_HPP
+
+#include <limits>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <functional>
+#include <boost/aura/config.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/tuning_db.hpp>
+#include <boost/aura/misc/now.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// identity of a device in the tuning database, see device::get_key
+inline std::string get_device_key(device& d)
+{
+	device_info di = device_get_info(d);
+	return d.get_key() + " (" + di.vendor + ")";
+}
+
+/**
+ * bundle sizes worth trying on a device, powers of two from 32 up to the
+ * maximum bundle size of the device
+ *
+ * @param d device
+ * @param first configuration tried first (the default)
+ */
+inline std::vector<launch_config> get_bundle_candidates(device& d,
+		const launch_config& first = launch_config())
+{
+	std::vector<launch_config> r(1, first);
+	std::size_t max = device_get_info(d).max_fibers_per_bundle;
+	for (std::size_t b=32; b<=max; b*=2) {
+		launch_config c = first;
+		c.bundle = b;
+		if (c != first) {
+			r.push_back(c);
+		}
+	}
+	return r;
+}
+
+/**
+ * time candidate launch configurations and store the fastest
+ *
+ * every candidate is run once to warm up (compile the kernel) and
+ * AURA_AUTOTUNE_RUNS times to measure, run must have the same effect
+ * each time it is called
+ *
+ * @param d device
+ * @param f feed run issues its commands to
+ * @param name kernel identity
+ * @param n number of elements
+ * @param candidates configurations to try
+ * @param run issue the operation using a configuration
+ * @param db database the fastest configuration is stored in
+ * @return fastest configuration
+ */
+inline launch_config autotune(device& d, feed& f, const std::string& name,
+		std::size_t n, const std::vector<launch_config>& candidates,
+		std::function<void(const launch_config&)> run,
+		tuning_db& db = get_tuning_db())
+{
+	assert(!candidates.empty());
+	launch_config best = candidates[0];
+	double best_time = std::numeric_limits<double>::max();
+	for (auto& c : candidates) {
+		run(c);
+		wait_for(f);
+		double t = now();
+		for (int i=0; i<AURA_AUTOTUNE_RUNS; i++) {
+			run(c);
+		}
+		wait_for(f);
+		t = now() - t;
+		if (t < best_time) {
+			best_time = t;
+			best = c;
+		}
+	}
+	db.insert(get_device_key(d), name, n, best);
+	return best;
+}
+
+/**
+ * launch configuration of an operation
+ *
+ * the configuration stored in the database, if there is none and
+ * AURA_AUTOTUNE is 1 the candidates are tuned, otherwise the first
+ * candidate is used
+ *
+ * @param d device
+ * @param f feed run issues its commands to
+ * @param name kernel identity
+ * @param n number of elements
+ * @param candidates configurations to try, the first is the default
+ * @param run issue the operation using a configuration
+ * @param db database
+ */
+inline launch_config tuned_config(device& d, feed& f,
+		const std::string& name, std::size_t n,
+		const std::vector<launch_config>& candidates,
+		std::function<void(const launch_config&)> run,
+		tuning_db& db = get_tuning_db())
+{
+	launch_config c;
+	if (db.find(get_device_key(d), name, n, c)) {
+		return c;
+	}
+	if (AURA_AUTOTUNE) {
+		return autotune(d, f, name, n, candidates, run, db);
+	}
+	return candidates[0];
+}
+
+/**
+ * make invoke use the tuned bundle sizes of a kernel, invoke with bounds
+ * limits the bundle size to the tuned size of the size class
+ *
+ * invoke does not read the tuning database, without a call after the
+ * kernel is loaded the default bundle sizes are used (sum, dot and norm2
+ * read the database themselves)
+ *
+ * @param d device the kernel was loaded on
+ * @param k kernel
+ * @param name kernel identity
+ * @param db database
+ */
+inline void apply_tuning(device& d, kernel& k, const std::string& name,
+		tuning_db& db = get_tuning_db())
+{
+	for (auto& it : db.get(get_device_key(d), name)) {
+		d.get_context()->get_launch_cache().set_bundle(k, it.first,
+				it.second.bundle);
+	}
+}
+
+/**
+ * tune the bundle size invoke uses for a kernel launched with bounds
+ *
+ * @param d device the kernel was loaded on
+ * @param f feed run issues its commands to
+ * @param k kernel
+ * @param name kernel identity
+ * @param n number of elements
+ * @param run issue invoke(k, n, ...)
+ * @param db database the fastest bundle size is stored in
+ * @return fastest configuration, bundle size 0 if the default is fastest
+ */
+inline launch_config autotune_invoke(device& d, feed& f, kernel& k,
+		const std::string& name, std::size_t n,
+		std::function<void()> run, tuning_db& db = get_tuning_db())
+{
+	auto& cache = d.get_context()->get_launch_cache();
+	std::size_t sc = detail::get_size_class(n);
+	launch_config best = autotune(d, f, name, n,
+			get_bundle_candidates(d), [&](const launch_config& c) {
+				cache.set_bundle(k, sc, c.bundle);
+				run();
+			}, db);
+	cache.set_bundle(k, sc, best.bundle);
+	return best;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_AUTOTUNE_HPP
+
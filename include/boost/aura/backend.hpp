@@ -16,6 +16,7 @@
 		#include <boost/aura/backend/cuda/device.hpp>
 		#include <boost/aura/backend/cuda/device_ptr.hpp>
 		#include <boost/aura/backend/cuda/mark.hpp>
+		#include <boost/aura/backend/cuda/timeline.hpp>
 		#include <boost/aura/backend/cuda/feed.hpp>
 		#include <boost/aura/backend/cuda/fft.hpp>
 		#include <boost/aura/backend/cuda/mesh.hpp>
@@ -37,6 +38,7 @@
 		#include <boost/aura/backend/opencl/args.hpp>
 		#include <boost/aura/backend/opencl/bundle.hpp>
 		#include <boost/aura/backend/opencl/call.hpp>
+		#include <boost/aura/backend/opencl/command_graph.hpp>
 		#include <boost/aura/backend/opencl/device.hpp>
 		#include <boost/aura/backend/opencl/device_ptr.hpp>
 		#include <boost/aura/backend/opencl/feed.hpp>
@@ -50,6 +52,7 @@
 		#include <boost/aura/backend/opencl/init.hpp>
 		#include <boost/aura/backend/opencl/invoke.hpp>
 		#include <boost/aura/backend/opencl/mark.hpp>
+		#include <boost/aura/backend/opencl/timeline.hpp>
 		#include <boost/aura/backend/opencl/memory.hpp>
 		#include <boost/aura/backend/opencl/module.hpp>
 	#endif // defined __OPENCL_VERSION__
@@ -80,6 +83,7 @@ using backend::print_device_info;
 
 using backend::feed;
 using backend::wait_for;
+using backend::wait_list;
 
 using backend::device_ptr;
 
@@ -20,38 +20,75 @@ typedef void * arg_t;
 template<unsigned long N>
 using args_tt = std::array<arg_t, N>;
 
-// alias for returned packed arguments
-template<unsigned long N>
-using args_t = std::pair<char*, args_tt<N>>;
-
-/// Copy arguments to memory block recursively
-template <typename T0>
-void fill_args_(char* p, args_tt<0>::iterator it, const T0 a0)
+/**
+ * packed arguments
+ *
+ * copies of the arguments are stored inline, every argument at an offset
+ * that is a multiple of its alignment, packing does not allocate
+ */
+template <typename... Targs>
+class args_t
 {
-	std::memcpy(p, &a0, sizeof(T0));
-	*it=p;
-}
+	typedef tlayout<0, Targs...> layout;
+
+public:
+	/// pack arguments
+	explicit args_t(const Targs&... ar)
+	{
+		fill_<0>(ar...);
+	}
+
+	/// number of arguments
+	std::size_t size() const
+	{
+		return sizeof...(Targs);
+	}
+
+	/// pointer to argument i
+	arg_t operator[](std::size_t i) const
+	{
+		return const_cast<char*>(&data_[layout::offset(i)]);
+	}
+
+private:
+	template <std::size_t I>
+	void fill_() {}
+
+	template <std::size_t I, typename T0, typename... Tr>
+	void fill_(const T0& a0, const Tr&... ar)
+	{
+		std::memcpy(&data_[layout::offset(I)], &a0, sizeof(T0));
+		fill_<I+1>(ar...);
+	}
+
+	/// copies of the arguments
+	alignas(talignof<Targs...>::al)
+		std::array<char, layout::sz> data_;
+};
 
-template <typename T0, typename... Targs>
-void fill_args_(char* p, args_tt<0>::iterator it,
-		const T0 a0, const Targs... ar)
+/// Pack arguments
+template <typename... Targs>
+args_t<Targs...> args(const Targs... ar)
 {
-	std::memcpy(p, &a0, sizeof(T0));
-	*it = p;
-	fill_args_(p+sizeof(T0), ++it, ar...);
+	return args_t<Targs...>(ar...);
 }
 
-/// Pack arguments
+/// pointers to the packed arguments as cuLaunchKernel expects them
 template <typename... Targs>
-args_t<sizeof...(Targs)> args(const Targs... ar)
+inline args_tt<sizeof...(Targs)> get_args(const args_t<Targs...>& a)
 {
-	args_tt<sizeof...(Targs)> pa;
-	char* p = (char*)malloc(tsizeof<Targs...>::sz);
-	char* ptr = p;
-	fill_args_(p, pa.begin(), ar...);
-	return std::make_pair(ptr, pa);
+	args_tt<sizeof...(Targs)> r;
+	for (std::size_t i=0; i<r.size(); i++) {
+		r[i] = a[i];
+	}
+	return r;
 }
 
+/// release packed arguments after invoke, nothing to do
+template <typename... Targs>
+inline void release_args(const args_t<Targs...>&) {}
+
+
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 
 typedef void * arg_t;
@@ -601,6 +638,18 @@ args_t args(const T0 & a0, const T1 & a1, const T2 & a2, const T3 & a3,
   );
 }
 
+/// pointers to the packed arguments as cuLaunchKernel expects them
+inline const args_tt& get_args(const args_t& a)
+{
+	return a.second;
+}
+
+/// release packed arguments after invoke
+inline void release_args(const args_t& a)
+{
+	free(a.first);
+}
+
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 
 } // cuda
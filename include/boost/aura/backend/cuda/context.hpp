@@ -2,14 +2,24 @@
 #ifndef AURA_BACKEND_CUDA_CONTEXT_HPP
 #define AURA_BACKEND_CUDA_CONTEXT_HPP
 
+#include <mutex>
+#include <cstdio>
+#include <cstring>
 #include <cuda.h>
 #include <boost/aura/backend/cuda/call.hpp>
+#include <boost/aura/detail/host_pool.hpp>
+#include <boost/aura/detail/launch_cache.hpp>
+#include <boost/aura/detail/svec.hpp>
+#include <boost/aura/config.hpp>
 
 namespace boost
 {
 namespace aura {
 namespace backend_detail {
 namespace cuda {
+
+#include <boost/aura/backend/shared/device_info.hpp>
+
 namespace detail {
 
 /**
@@ -28,13 +38,23 @@ public:
    * @param ordinal context number
    */
   inline explicit context(std::size_t ordinal) : 
-      ordinal_(ordinal), pinned_(false) {
+      ordinal_(ordinal), pinned_(false),
+      host_pool_(new aura::detail::host_pool()),
+      launch_cache_(new aura::detail::launch_cache()) {
     AURA_CUDA_SAFE_CALL(cuDeviceGet(&device_, ordinal));
     AURA_CUDA_SAFE_CALL(cuCtxCreate(&context_, 0, device_));
   }
 
   /// destroy context
   inline ~context() {
+    if (host_pool_->count() > 0) {
+      AURA_CUDA_SAFE_CALL(cuCtxSetCurrent(context_));
+      host_pool_->clear([](void* ptr, std::uintptr_t) {
+        AURA_CUDA_SAFE_CALL(cuMemFreeHost(ptr));
+      });
+    }
+    delete host_pool_;
+    delete launch_cache_;
     AURA_CUDA_SAFE_CALL(cuCtxDestroy(context_));
   }
 
@@ -82,8 +102,83 @@ public:
   inline std::size_t get_ordinal() const {
     return ordinal_;
   }
+
+  /// access the pinned host memory pool
+  inline aura::detail::host_pool & get_host_pool() {
+    return *host_pool_;
+  }
+
+  /// access the launch geometries calculated by invoke
+  inline aura::detail::launch_cache & get_launch_cache() {
+    return *launch_cache_;
+  }
+
+  /// identity of the device in the tuning database, the device name
+  inline std::string get_key() {
+    return get_info().name;
+  }
+
+  /// access the device properties, queried on first access
+  inline const device_info & get_info() {
+    std::call_once(info_once_, [this]() { query_info(); });
+    return info_;
+  }
   
 private:
+  /// value of a device attribute
+  inline std::size_t query(CUdevice_attribute attribute) const {
+    int r = 0;
+    AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r, attribute, device_));
+    return r;
+  }
+
+  /// query the device properties
+  inline void query_info() {
+    std::memset(info_.name, 0, sizeof(info_.name));
+    std::memset(info_.vendor, 0, sizeof(info_.vendor));
+    AURA_CUDA_SAFE_CALL(cuDeviceGetName(info_.name,
+      sizeof(info_.name)-1, device_));
+    std::strncpy(info_.vendor, "Nvidia", sizeof(info_.vendor)-1);
+    int driver = 0;
+    AURA_CUDA_SAFE_CALL(cuDriverGetVersion(&driver));
+    std::snprintf(info_.driver, sizeof(info_.driver), "%d", driver);
+
+    // mesh
+    info_.max_mesh.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_X));
+    info_.max_mesh.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_Y));
+    info_.max_mesh.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_Z));
+    // bundle
+    info_.max_bundle.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_X));
+    info_.max_bundle.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Y));
+    info_.max_bundle.push_back(query(CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Z));
+    // fibers in bundle
+    info_.max_fibers_per_bundle =
+      query(CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_BLOCK);
+
+    info_.compute_units = query(CU_DEVICE_ATTRIBUTE_MULTIPROCESSOR_COUNT);
+    // reported in kHz
+    info_.clock = query(CU_DEVICE_ATTRIBUTE_CLOCK_RATE) / 1000;
+    std::size_t total = 0;
+    AURA_CUDA_SAFE_CALL(cuDeviceTotalMem(&total, device_));
+    info_.global_memory = total;
+    info_.max_alloc = total;
+    info_.local_memory =
+      query(CU_DEVICE_ATTRIBUTE_MAX_SHARED_MEMORY_PER_BLOCK);
+    // global memory transactions are 128 bytes
+    info_.cache_line = 128;
+    info_.cache_size = query(CU_DEVICE_ATTRIBUTE_L2_CACHE_SIZE);
+    // float4 loads are the widest, the hardware is scalar
+    info_.preferred_vector_width = 4;
+    info_.native_vector_width = 1;
+    int major = 0, minor = 0;
+    AURA_CUDA_SAFE_CALL(cuDeviceComputeCapability(&major, &minor,
+      device_));
+    info_.fp64 = major > 1 || (1 == major && minor >= 3);
+    info_.fp16 = major > 5 || (5 == major && minor >= 3);
+    info_.unified_memory = 0 != query(CU_DEVICE_ATTRIBUTE_INTEGRATED);
+    info_.cpu = false;
+  }
+
   /// device ordinal
   std::size_t ordinal_;
   /// device handle
@@ -92,6 +187,14 @@ private:
   CUcontext context_;
   /// flag indicating pinned or unpinned context
   bool pinned_;
+  /// pinned host memory reused by host allocators
+  aura::detail::host_pool * host_pool_;
+  /// launch geometries of kernels invoked with bounds
+  aura::detail::launch_cache * launch_cache_;
+  /// device properties
+  device_info info_;
+  /// guards the query of info_
+  std::once_flag info_once_;
 };
 
 
@@ -2,7 +2,9 @@
 #define AURA_BACKEND_CUDA_DETAIL_HOST_ALLOCATOR_HPP
 
 #include <map>
+#include <cstdint>
 #include <boost/aura/backend/cuda/feed.hpp>
+#include <boost/aura/detail/host_pool.hpp>
 
 namespace boost
 {
@@ -37,21 +39,37 @@ public:
 		mt_(other.mt_), f_(other.f_)
 	{}
 
-	/// allocate memory
+	/**
+	 * allocate memory
+	 *
+	 * memory is taken from the pinned host pool of the device if
+	 * possible, blocks are created with the size of their size class
+	 */
 	T* allocate(std::size_t n)
 	{
+		aura::detail::host_pool& pool = f_->get_context()->get_host_pool();
 		void* p;
-		f_->set();  
-		AURA_CUDA_SAFE_CALL(cuMemAllocHost(&p, n*sizeof(T)));
+		std::uintptr_t handle = 0;
+		if (!pool.acquire(n*sizeof(T), p, handle)) {
+			std::size_t size;
+			aura::detail::host_pool::size_class(n*sizeof(T), size);
+			f_->set();  
+			AURA_CUDA_SAFE_CALL(cuMemAllocHost(&p, size));
+			f_->unset();
+			// the pool does not need a handle, the pointer is the block
+			pool.insert(p, (std::uintptr_t)p, size);
+		}
 		// put raw pointer and memory handle in the map
 		unmap((T*)p);
-		f_->unset();
 		return (T*)p;
 	}
 
-	/// free memory
+	/// free memory, pooled memory is returned to the pool
 	void deallocate(T* p, std::size_t n)
 	{
+		if (f_->get_context()->get_host_pool().release(p)) {
+			return;
+		}
 		f_->set();  
 		AURA_CUDA_SAFE_CALL(cuMemFreeHost(p));
 		f_->unset();
@@ -95,7 +113,7 @@ public:
 template <typename U, typename V>
 bool operator==(const host_allocator<U>& lhs, const host_allocator<V>& rhs)
 {
-	return *lhs.f_ == *rhs.f_ && 
+	return lhs.f_ == rhs.f_ && 
 		lhs.mt_ == rhs.mt_;
 }
 
@@ -13,6 +13,7 @@
 #include <boost/aura/backend/cuda/context.hpp>
 #include <boost/aura/misc/deprecate.hpp>
 #include <boost/aura/device_lock.hpp>
+#include <boost/aura/backend/shared/kernel_registry.hpp>
 
 namespace boost {
 namespace aura {
@@ -49,10 +50,13 @@ class device
 private:
 	BOOST_MOVABLE_BUT_NOT_COPYABLE(device)
 
+	/// modules and kernels, shared by the host threads
+	typedef aura::detail::kernel_registry<module, kernel> registry;
+
 public:
 
 	/// create empty device object without device and context
-	inline explicit device() : context_(nullptr) {}
+	inline explicit device() : context_(nullptr), registry_(nullptr) {}
 
 	/**
 	 * create device form ordinal, also creates a context
@@ -61,7 +65,8 @@ public:
 	 */
 	inline explicit device(std::size_t ordinal) :
 		context_(new detail::context(ordinal)),
-		ordinal_(ordinal)
+		ordinal_(ordinal),
+		registry_(new registry())
 	{}
 
 	/**
@@ -73,6 +78,7 @@ public:
 	inline explicit device(std::size_t ordinal, device_lock& dl) :
 		context_(new detail::context(ordinal)),
 		ordinal_(ordinal),
+		registry_(new registry()),
 		device_lock_(dl)
 	{}
 
@@ -90,11 +96,11 @@ public:
 	device(BOOST_RV_REF(device) d) :
 		context_(d.context_),
 		ordinal_(d.ordinal_),
-		modules_(std::move(d.modules_)),
+		registry_(d.registry_),
 		device_lock_(std::move(d.device_lock_))
 	{
 		d.context_ = nullptr;
-		d.modules_.clear();
+		d.registry_ = nullptr;
 	}
 
 	/**
@@ -107,51 +113,50 @@ public:
 		finalize();
 		context_ = d.context_;
 		ordinal_ = d.ordinal_;
-		modules_ = std::move(d.modules_);
+		registry_ = d.registry_;
 		device_lock_ = std::move(d.device_lock_);
 		d.context_ = nullptr;
-		d.modules_.clear();
+		d.registry_ = nullptr;
 		return *this;
 	}
 
-	/// load a kernel from a file
+	/**
+	 * load a kernel from a file, safe to call from multiple host threads,
+	 * the threads share the kernel (launches pass their arguments)
+	 */
 	kernel load_from_file(const char* kernel_name,
 			const char* file_name,
 			const char* build_options=NULL)
 	{
-		auto it = modules_.find(file_name);
-		if (modules_.end() == it) {
-			std::ifstream in(file_name, std::ios::in);
-			AURA_CHECK_ERROR(in);
-			in.seekg(0, std::ios::end);
-			std::string fcontent;
-			fcontent.resize(in.tellg());
-			in.seekg(0, std::ios::beg);
-			in.read(&fcontent[0], fcontent.size());
-			in.close();
-			auto it2 = modules_.insert(std::make_pair(file_name,
-				create_module_from_string(fcontent.c_str(),
-						*this, build_options)));
-			it = it2.first;
-		}
-		return create_kernel(it->second, kernel_name);
+		return registry_->get(file_name, kernel_name,
+				[&]() {
+					return create_module_from_file(
+						file_name, *this,
+						build_options);
+				},
+				[&](module& m) {
+					return create_kernel(m, kernel_name);
+				});
 	}
 
-	/// load a kernel from a string
+	/**
+	 * load a kernel from a string, safe to call from multiple host
+	 * threads, the threads share the kernel (launches pass their
+	 * arguments)
+	 */
 	kernel load_from_string(const char* kernel_name,
 			const char* kernel_string,
 			const char* build_options=NULL)
 	{
-		auto it = modules_.find(kernel_string);
-		if (modules_.end() == it) {
-			auto it2 = modules_.insert(
-					std::make_pair(kernel_string,
-						create_module_from_string(
-							kernel_string, *this,
-							build_options)));
-			it = it2.first;
-		}
-		return create_kernel(it->second, kernel_name);
+		return registry_->get(kernel_string, kernel_name,
+				[&]() {
+					return create_module_from_string(
+						kernel_string, *this,
+						build_options);
+				},
+				[&](module& m) {
+					return create_kernel(m, kernel_name);
+				});
 	}
 
 	/// make device active
@@ -197,7 +202,7 @@ public:
 	}
 
 	/// access the context handle
-	inline detail::context * get_context()
+	inline detail::context * get_context() const
 	{
 		return context_;
 	}
@@ -208,6 +213,18 @@ public:
 		return ordinal_;
 	}
 
+	/// identity of the device in the tuning database, see context
+	inline std::string get_key() const
+	{
+		return context_->get_key();
+	}
+
+	/// true if the device is a CPU (never for CUDA)
+	inline bool is_cpu() const
+	{
+		return false;
+	}
+
 	/// compare devices
 	inline bool operator==(const device& d) const
 	{
@@ -224,6 +241,10 @@ private:
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
+		// the registry refers to the context
+		if (nullptr != registry_) {
+			delete registry_;
+		}
 		if(nullptr != context_) {
 			delete context_;
 		}
@@ -236,8 +257,8 @@ private:
 	/// device ordinal
 	std::size_t ordinal_;
 
-	/// modules
-	std::unordered_map<std::string, module> modules_;
+	/// modules and kernels
+	registry * registry_;
 
 	/// device_lock
 	device_lock device_lock_;
@@ -296,52 +317,16 @@ inline std::size_t device_get_total_memory(device &d)
 	return total;
 }
 
-#include <boost/aura/backend/shared/device_info.hpp>
-
-/// return the device info
+/// return the device info, queried once per device
 inline device_info device_get_info(device & d)
 {
-	device_info di;
-	// name and vendor
-	AURA_CUDA_SAFE_CALL(cuDeviceGetName(di.name, sizeof(di.name)-1,
-	d.get_backend_device()));
-	strncpy(di.vendor, "Nvidia", sizeof(di.vendor)-1);
-
-	// mesh
-	int r=0;
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_X, d.get_backend_device()));
-	di.max_mesh.push_back(r);
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_Y, d.get_backend_device()));
-	di.max_mesh.push_back(r);
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_GRID_DIM_Z, d.get_backend_device()));
-	di.max_mesh.push_back(r);
-
-	// bundle
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_X, d.get_backend_device()));
-	di.max_bundle.push_back(r);
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Y, d.get_backend_device()));
-	di.max_bundle.push_back(r);
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_BLOCK_DIM_Z, d.get_backend_device()));
-	di.max_bundle.push_back(r);
-
-	// fibers in bundle
-	AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&r,
-	CU_DEVICE_ATTRIBUTE_MAX_THREADS_PER_BLOCK, d.get_backend_device()));
-	di.max_fibers_per_bundle = r;
-	return di;
+	return d.get_context()->get_info();
 }
 
 inline device create_device_exclusive()
 {
-	int num = device_get_count();
 	for (std::size_t n=0; n<device_get_count(); n++) {
-		auto dl = create_device_lock(num);
+		auto dl = create_device_lock(n);
 		if (dl) {
 			return device(n, dl);
 		}
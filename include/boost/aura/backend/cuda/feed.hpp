@@ -5,6 +5,7 @@
 #include <cuda.h>
 #include <boost/aura/backend/cuda/call.hpp>
 #include <boost/aura/backend/cuda/device.hpp>
+#include <boost/aura/backend/shared/feed_order.hpp>
 
 namespace boost
 {
@@ -44,16 +45,20 @@ private:
 public:
 
 	/// create empty feed object without device and stream
-	inline explicit feed() : context_(nullptr) {}
+	inline explicit feed() : context_(nullptr),
+		order_(feed_order::in_order) {}
 
 	/**
 	 * create device feed for device
 	 *
 	 * @param d device to create feed for
+	 * @param order execution order, CUDA streams are always in order,
+	 * an out_of_order feed behaves like an in_order feed
 	 *
 	 * const device & is not allowed since an actual instance is needed
 	 */
-	inline explicit feed(device& d) : context_(d.get_context())
+	inline explicit feed(device& d, feed_order order = feed_order::in_order) :
+		context_(d.get_context()), order_(order)
 	{
 		context_->set();
 		AURA_CUDA_SAFE_CALL(cuStreamCreate(&stream_, 
@@ -67,7 +72,7 @@ public:
 	 * @param f feed to move here
 	 */
 	feed(BOOST_RV_REF(feed) f) :
-		context_(f.context_), stream_(f.stream_)
+		context_(f.context_), stream_(f.stream_), order_(f.order_)
 	{
 		f.context_ = nullptr;
 	}
@@ -82,6 +87,7 @@ public:
 		finalize();
 		context_ = f.context_;
 		stream_ = f.stream_;
+		order_ = f.order_;
 		f.context_ = nullptr;
 		return *this;
 	}
@@ -144,12 +150,24 @@ public:
 		return stream_;
 	}
 
+	/// access the context of the device the feed was created for
+	inline detail::context * get_context() const
+	{
+		return context_;
+	}
+
 	/// access the context handle
 	inline detail::context * get_context()
 	{
 		return context_;
 	}
 
+	/// execution order requested when the feed was created
+	inline feed_order get_order() const
+	{
+		return order_;
+	}
+
 private:
 	/// finalize object (called from dtor and move assign)
 	void finalize()
@@ -166,6 +184,8 @@ private:
 	detail::context * context_;
 	/// stream handle
 	CUstream stream_;
+	/// execution order
+	feed_order order_;
 };
 
 /**
@@ -88,7 +88,8 @@ public:
 	                std::size_t ostride = 1, std::size_t odist = 0) :
 		context_(d.get_context()), type_(type),
 		dim_(std::get<0>(dim)),
-		batch_(std::max(1, product(std::get<1>(dim))))
+		batch_(std::max<std::int64_t>(1,
+			product(std::get<1>(dim))))
 	{
 		initialize(iembed, istride, idist,
 				oembed, ostride, odist);
@@ -193,13 +194,18 @@ private:
 	                const fft_embed& oembed = fft_embed(),
 	                std::size_t ostride = 1, std::size_t odist = 0)
 	{
+		// cufftPlanMany expects int dimensions
+		fft_embed n;
+		for (std::size_t i=0; i<dim_.size(); i++) {
+			n.push_back((fft_size)dim_[i]);
+		}
 		try {
 			context_->set();
 			AURA_CUFFT_SAFE_CALL(
 				cufftPlanMany(
 					&handle_,
 					dim_.size(),
-					const_cast<int*>(&dim_[0]),
+					&n[0],
 					0 == iembed.size() ? NULL :
 						const_cast<int*>(&iembed[0]),
 					istride,
@@ -1,15 +1,19 @@
 #ifndef AURA_BACKEND_CUDA_INVOKE_HPP
 #define AURA_BACKEND_CUDA_INVOKE_HPP
 
+#include <array>
 #include <cstddef>
+#include <algorithm>
 #include <cuda.h>
 #include <boost/aura/bounds.hpp>
 #include <boost/aura/backend/cuda/kernel.hpp>
 #include <boost/aura/backend/cuda/call.hpp>
 #include <boost/aura/backend/cuda/feed.hpp>
+#include <boost/aura/backend/cuda/mark.hpp>
 #include <boost/aura/backend/cuda/mesh.hpp>
 #include <boost/aura/backend/cuda/bundle.hpp>
 #include <boost/aura/backend/cuda/args.hpp>
+#include <boost/aura/backend/shared/bounds_fit.hpp>
 #include <boost/aura/backend/shared/calc_mesh_bundle.hpp>
 #include <boost/config.hpp>
 
@@ -19,11 +23,48 @@ namespace backend_detail {
 namespace cuda {
 namespace detail {
 
+/**
+ * launch geometry (bundle size and 3 mesh sizes) for v elements, the
+ * bundle size honors the maximum block size of the kernel, geometries
+ * are cached per device
+ */
+inline std::array<std::size_t, 4> launch_geometry(kernel& k,
+		std::size_t v, feed& f, bounds_fit fit)
+{
+	return f.get_context()->get_launch_cache().get(k, v,
+			bounds_fit::padded == fit, [&]() {
+		int size = 0;
+		AURA_CUDA_SAFE_CALL(cuFuncGetAttribute(&size,
+				CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK, k));
+		int multiple = 1;
+		AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&multiple,
+				CU_DEVICE_ATTRIBUTE_WARP_SIZE,
+				f.get_context()->get_backend_device()));
+		std::array<std::size_t, 4> max_mb = {{
+			std::min<std::size_t>(AURA_CUDA_MAX_BUNDLE, size),
+			AURA_CUDA_MAX_MESH0,
+			AURA_CUDA_MAX_MESH1,
+			AURA_CUDA_MAX_MESH2
+		}};
+		// a tuned bundle size limits the bundle size
+		std::size_t tuned = f.get_context()->get_launch_cache().
+			get_bundle(k, boost::aura::detail::get_size_class(v));
+		if (0 != tuned && tuned < max_mb[0]) {
+			max_mb[0] = tuned;
+		}
+
+		const std::array<bool, 4> mask = {{false, false, false, false}};
+
+		return boost::aura::detail::calc_launch_geometry(v, max_mb,
+				mask, multiple, fit);
+	});
+}
+
 
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke_impl(kernel & k, const mesh & m, const bundle & b,
-		const args_t<N>&& a, feed & f)
+		const args_t<Targs...>&& a, feed & f)
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 inline void invoke_impl(kernel& k, const mesh& m, const bundle& b,
 		const args_t& a, feed& f)
@@ -52,42 +93,35 @@ inline void invoke_impl(kernel& k, const mesh& m, const bundle& b,
 	meshy /= bundley;
 	meshz /= bundlez;
 
+	auto pa = get_args(a);
 	f.set();
 
 	AURA_CUDA_SAFE_CALL(cuLaunchKernel(k, meshx, meshy, meshz,
 		bundlex, bundley, bundlez, 0, f.get_backend_stream(),
-		const_cast<void**>(&a.second[0]), NULL));
+		const_cast<void**>(&pa[0]), NULL));
 	f.unset();
-	free(a.first);
+	release_args(a);
 }
 
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke_impl(kernel & k, const ::boost::aura::bounds& b,
-		const args_t<N>&& a, feed & f)
+		const args_t<Targs...>&& a, feed & f,
+		bounds_fit fit = bounds_fit::exact)
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 inline void invoke_impl(kernel & k, const ::boost::aura::bounds& b,
-		const args_t & a, feed & f)
+		const args_t & a, feed & f, bounds_fit fit = bounds_fit::exact)
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 {
-	std::array<std::size_t, 4> mb = {{1, 1, 1, 1}};
-	const std::array<std::size_t, 4> max_mb = {{
-		AURA_CUDA_MAX_BUNDLE,
-		AURA_CUDA_MAX_MESH0,
-		AURA_CUDA_MAX_MESH1,
-		AURA_CUDA_MAX_MESH2
-	}};
-
-	std::array<bool, 4> mask = {{false, false, false, false}};
-
-	boost::aura::detail::calc_mesh_bundle(product(b), 2,
-			mb.begin(), max_mb.begin(), mask.begin());
+	const std::array<std::size_t, 4> mb =
+		launch_geometry(k, product(b), f, fit);
+	auto pa = get_args(a);
 	f.set();
 	AURA_CUDA_SAFE_CALL(cuLaunchKernel(k, mb[1], mb[2], mb[3],
 		mb[0], 1, 1, 0, f.get_backend_stream(),
-		const_cast<void**>(&a.second[0]), NULL));
+		const_cast<void**>(&pa[0]), NULL));
 	f.unset();
-	free(a.first);
+	release_args(a);
 }
 
 } // namespace detail
@@ -97,29 +131,80 @@ inline void invoke_impl(kernel & k, const ::boost::aura::bounds& b,
 /// invoke kernel without args
 inline void invoke(kernel& k, const mesh& m, const bundle& b, feed& f)
 {
-	detail::invoke_impl(k, m, b, args_t<0>(), f);
+	detail::invoke_impl(k, m, b, args_t<>(), f);
 }
 
 /// invoke kernel with args
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke(kernel& k, const mesh& m, const bundle& b,
-		const args_t<N>&& a, feed& f)
+		const args_t<Targs...>&& a, feed& f)
 {
 	detail::invoke_impl(k, m, b, std::move(a), f);
 }
 
-/// invoke kernel with bounds and args
-template<unsigned long N>
-inline void invoke(kernel& k, const bounds& b, const args_t<N>&& a, feed& f)
+/**
+ * invoke kernel with bounds and args
+ *
+ * the bundle size is limited by the tuned bundle size of the kernel, the
+ * tuning database is not read here, apply_tuning or autotune_invoke must
+ * be called once after the kernel is loaded
+ *
+ * @param fit bounds_fit::padded allows a mesh larger than the bounds
+ */
+template<typename... Targs>
+inline void invoke(kernel& k, const bounds& b, const args_t<Targs...>&& a,
+		feed& f, bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, b, std::move(a), f);
+	detail::invoke_impl(k, b, std::move(a), f, fit);
 }
 
 /// invoke kernel with size and args
-template<unsigned long N>
-inline void invoke(kernel& k, const std::size_t s, const args_t<N>&& a, feed& f)
+template<typename... Targs>
+inline void invoke(kernel& k, const std::size_t s,
+		const args_t<Targs...>&& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
+{
+	detail::invoke_impl(k, bounds(s), std::move(a), f, fit);
+}
+
+/**
+ * invoke kernel with bounds and args after the marks of a wait list
+ *
+ * @return mark that is reached when the kernel has finished
+ */
+template<typename... Targs>
+inline mark invoke(kernel& k, const bounds& b, const args_t<Targs...>&& a,
+		feed& f, const wait_list& w, bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, bounds(s), std::move(a), f);
+	detail::set_feed(f);
+	w.enqueue(f);
+	detail::unset_feed(f);
+	detail::invoke_impl(k, b, std::move(a), f, fit);
+	return mark(f);
+}
+
+/// invoke kernel with size and args after the marks of a wait list
+template<typename... Targs>
+inline mark invoke(kernel& k, const std::size_t s, const args_t<Targs...>&& a,
+		feed& f, const wait_list& w, bounds_fit fit = bounds_fit::exact)
+{
+	detail::set_feed(f);
+	w.enqueue(f);
+	detail::unset_feed(f);
+	detail::invoke_impl(k, bounds(s), std::move(a), f, fit);
+	return mark(f);
+}
+
+/// invoke kernel with mesh, bundle and args after the marks of a wait list
+template<typename... Targs>
+inline mark invoke(kernel& k, const mesh& m, const bundle& b,
+		const args_t<Targs...>&& a, feed& f, const wait_list& w)
+{
+	detail::set_feed(f);
+	w.enqueue(f);
+	detail::unset_feed(f);
+	detail::invoke_impl(k, m, b, std::move(a), f);
+	return mark(f);
 }
 
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -138,15 +223,17 @@ inline void invoke(kernel& k, const mesh& m, const bundle& b,
 }
 
 /// invoke kernel with bounds and args
-inline void invoke(kernel& k, const bounds& b, const args_t& a, feed& f)
+inline void invoke(kernel& k, const bounds& b, const args_t& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, b, a, f);
+	detail::invoke_impl(k, b, a, f, fit);
 }
 
 /// invoke kernel with size and args
-inline void invoke(kernel& k, const std::size_t s, const args_t& a, feed& f)
+inline void invoke(kernel& k, const std::size_t s, const args_t& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, bounds(s), a, f);
+	detail::invoke_impl(k, bounds(s), a, f, fit);
 }
 
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -3,24 +3,33 @@
 
 #include <cuda.h>
 
-__device__ __forceinline__ unsigned int get_mesh_id() 
+// element index type, 64 bit unless AURA_INDEX_32 is 1 (see config.hpp)
+#if AURA_INDEX_32
+	#define AURA_INDEX unsigned int
+#else
+	#define AURA_INDEX unsigned long long
+#endif
+
+__device__ __forceinline__ AURA_INDEX get_mesh_id() 
 {
-	return (gridDim.y*gridDim.x*blockIdx.z + 
+	// the block id is widened before it is scaled by the block size
+	return (AURA_INDEX)(gridDim.y*gridDim.x*blockIdx.z + 
 			gridDim.x*blockIdx.y + blockIdx.x) * 
 		(blockDim.z*blockDim.y*blockDim.x) + 
 		blockDim.y*blockDim.x*threadIdx.z + blockDim.x*threadIdx.y + 
 		threadIdx.x;
 }
 
-__device__ __forceinline__ unsigned int get_id_in_mesh() 
+__device__ __forceinline__ AURA_INDEX get_id_in_mesh() 
 {
 	return get_mesh_id();
 }
 
 
-__device__ __forceinline__ unsigned int get_mesh_size() 
+__device__ __forceinline__ AURA_INDEX get_mesh_size() 
 {
-	return gridDim.z*gridDim.y*gridDim.x * blockDim.z*blockDim.y*blockDim.x;
+	return (AURA_INDEX)(gridDim.z*gridDim.y*gridDim.x) *
+		(blockDim.z*blockDim.y*blockDim.x);
 }
 
 __device__ __forceinline__ unsigned int get_bundle_id() 
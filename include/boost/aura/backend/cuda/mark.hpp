@@ -2,6 +2,7 @@
 #define AURA_BACKEND_CUDA_MARK_HPP
 
 #include <cuda.h>
+#include <vector>
 #include <boost/move/move.hpp>
 #include <boost/aura/backend/cuda/call.hpp>
 #include <boost/aura/backend/cuda/device.hpp>
@@ -60,6 +61,15 @@ public:
 		detail::unset_feed(f);
 	}
 
+	/**
+	 * create mark from an event, the mark takes ownership of the event
+	 *
+	 * @param e event
+	 */
+	inline explicit mark(CUevent e) : event_(new CUevent(e))
+	{
+	}
+
 	/**
 	 * move constructor, move mark information here, invalidate other
 	 *
@@ -98,6 +108,12 @@ public:
 	{
 		return *event_;
 	}
+
+	/// true if the mark has no event
+	bool empty() const
+	{
+		return nullptr == event_;
+	}
 	
 private:
 	/// finalize object (called from dtor and move assign)
@@ -117,6 +133,54 @@ friend void wait_for(mark & m);
 
 };
 
+/**
+ * wait_list class
+ *
+ * marks a command waits for before it starts, the list does not own
+ * the marks, they must live until the command is enqueued
+ */
+class wait_list
+{
+
+public:
+	/// create empty wait list
+	inline explicit wait_list() {}
+
+	/// create wait list with a single mark
+	inline explicit wait_list(mark & m)
+	{
+		add(m);
+	}
+
+	/// add a mark, empty marks are ignored
+	inline wait_list & add(mark & m)
+	{
+		if (!m.empty()) {
+			events_.push_back(m.get_event());
+		}
+		return *this;
+	}
+
+	/// number of marks
+	inline std::size_t size() const
+	{
+		return events_.size();
+	}
+
+	/// make a feed wait for all marks of the list
+	inline void enqueue(feed & f) const
+	{
+		for (std::size_t i=0; i<events_.size(); i++) {
+			AURA_CUDA_SAFE_CALL(cuStreamWaitEvent(
+				detail::get_backend_stream(f), events_[i], 0));
+		}
+	}
+
+private:
+	/// events
+	std::vector<CUevent> events_;
+};
+
 /// insert marker into feed
 inline void insert(feed & f, mark & m) 
 {
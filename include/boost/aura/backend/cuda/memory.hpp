@@ -2,9 +2,11 @@
 #define AURA_BACKEND_CUDA_MEMORY_HPP
 
 #include <cstddef>
+#include <cstring>
 #include <cuda.h>
 #include <boost/aura/backend/cuda/call.hpp>
 #include <boost/aura/backend/cuda/feed.hpp>
+#include <boost/aura/backend/cuda/mark.hpp>
 #include <boost/aura/backend/cuda/device.hpp>
 #include <boost/aura/backend/cuda/device_ptr.hpp>
 #include <boost/aura/backend/shared/memory_tag.hpp>
@@ -47,6 +49,24 @@ device_ptr<T> device_malloc(std::size_t size, device & d) {
   return device_ptr<T>(m, d);
 }
 
+/**
+ * allocate device memory the host can access without copying, for
+ * devices that share memory with the host (integrated devices), the
+ * memory is managed memory
+ *
+ * @param size number of T's
+ * @param d device the memory is allocated on
+ */
+template <typename T>
+device_ptr<T> device_malloc_unified(std::size_t size, device & d) {
+  d.set();
+  memory m;
+  AURA_CUDA_SAFE_CALL(cuMemAllocManaged(&m, size*sizeof(T),
+    CU_MEM_ATTACH_GLOBAL));
+  d.unset();
+  return device_ptr<T>(m, d);
+}
+
 template <typename T>
 device_ptr<T> device_malloc_dependent(device_ptr<T> ptr,
 		std::size_t size, std::size_t offset) 
@@ -243,6 +263,62 @@ void copy(T * dst, const device_ptr<T> src, std::size_t size, feed & f) {
   f.unset();
 }
 
+/**
+ * copy rows of host memory to device memory in one transfer
+ *
+ * @param dst device memory (destination), the rows are stored densely
+ * @param src host memory (source), first row
+ * @param width number of T per row
+ * @param rows number of rows
+ * @param pitch distance between the rows in host memory in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_rows(device_ptr<T> dst, const T * src, std::size_t width,
+  std::size_t rows, std::size_t pitch, feed & f) {
+  CUDA_MEMCPY2D c;
+  std::memset(&c, 0, sizeof(c));
+  c.srcMemoryType = CU_MEMORYTYPE_HOST;
+  c.srcHost = src;
+  c.srcPitch = pitch*sizeof(T);
+  c.dstMemoryType = CU_MEMORYTYPE_DEVICE;
+  c.dstDevice = dst.get_base()+dst.get_offset()*sizeof(T);
+  c.dstPitch = width*sizeof(T);
+  c.WidthInBytes = width*sizeof(T);
+  c.Height = rows;
+  f.set();
+  AURA_CUDA_SAFE_CALL(cuMemcpy2DAsync(&c, f.get_backend_stream()));
+  f.unset();
+}
+
+/**
+ * copy device memory to rows of host memory in one transfer
+ *
+ * @param dst host memory (destination), first row
+ * @param src device memory (source), the rows are stored densely
+ * @param width number of T per row
+ * @param rows number of rows
+ * @param pitch distance between the rows in host memory in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_rows(T * dst, const device_ptr<T> src, std::size_t width,
+  std::size_t rows, std::size_t pitch, feed & f) {
+  CUDA_MEMCPY2D c;
+  std::memset(&c, 0, sizeof(c));
+  c.srcMemoryType = CU_MEMORYTYPE_DEVICE;
+  c.srcDevice = src.get_base()+src.get_offset()*sizeof(T);
+  c.srcPitch = width*sizeof(T);
+  c.dstMemoryType = CU_MEMORYTYPE_HOST;
+  c.dstHost = dst;
+  c.dstPitch = pitch*sizeof(T);
+  c.WidthInBytes = width*sizeof(T);
+  c.Height = rows;
+  f.set();
+  AURA_CUDA_SAFE_CALL(cuMemcpy2DAsync(&c, f.get_backend_stream()));
+  f.unset();
+}
+
 
 /**
  * copy device to device memory
@@ -283,6 +359,141 @@ inline void copy(device_ptr<T> dst, const device_ptr<T> src,
   f.unset();
 }
 
+namespace detail
+{
+
+/**
+ * wait until the host may access managed memory used in a feed
+ *
+ * without concurrent managed access the host must not touch managed
+ * memory while any kernel of the context runs, not only the kernels of
+ * the feed, so the whole context is synchronized
+ */
+inline void sync_managed(feed & f) {
+  int concurrent = 0;
+#if CUDA_VERSION >= 8000
+  AURA_CUDA_SAFE_CALL(cuDeviceGetAttribute(&concurrent,
+    CU_DEVICE_ATTRIBUTE_CONCURRENT_MANAGED_ACCESS,
+    f.get_backend_device()));
+#endif
+  f.set();
+  if (concurrent) {
+    AURA_CUDA_SAFE_CALL(cuStreamSynchronize(f.get_backend_stream()));
+  } else {
+    AURA_CUDA_SAFE_CALL(cuCtxSynchronize());
+  }
+  f.unset();
+}
+
+} // namespace detail
+
+/**
+ * copy host to device memory allocated with device_malloc_unified
+ *
+ * the host writes the memory after the feed finished (after all feeds of
+ * the device on devices without concurrent managed access), nothing is
+ * copied if src is the device memory, the copy has finished when the
+ * function returns
+ *
+ * @param dst device memory (destination)
+ * @param src host memory (source)
+ * @param size size of copy in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_unified(device_ptr<T> dst, const T * src, std::size_t size,
+  feed & f) {
+  T* p = (T*)(dst.get_base()+dst.get_offset()*sizeof(T));
+  detail::sync_managed(f);
+  if (p != src) {
+    std::memcpy(p, src, size*sizeof(T));
+  }
+}
+
+/**
+ * copy device memory allocated with device_malloc_unified to host memory
+ *
+ * the host reads the memory after the feed finished (after all feeds of
+ * the device on devices without concurrent managed access), the copy has
+ * finished when the function returns
+ *
+ * @param dst host memory (destination)
+ * @param src device memory (source)
+ * @param size size of copy in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_unified(T * dst, const device_ptr<T> src, std::size_t size,
+  feed & f) {
+  const T* p = (const T*)(src.get_base()+src.get_offset()*sizeof(T));
+  detail::sync_managed(f);
+  if (p != dst) {
+    std::memcpy(dst, p, size*sizeof(T));
+  }
+}
+
+/**
+ * copy host to device memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+mark copy(device_ptr<T> dst, const T * src, std::size_t size,
+  feed & f, const wait_list & w) {
+  f.set();
+  w.enqueue(f);
+  f.unset();
+  copy(dst, src, size, f);
+  return mark(f);
+}
+
+/**
+ * copy device to host memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+mark copy(T * dst, const device_ptr<T> src, std::size_t size, feed & f,
+  const wait_list & w) {
+  f.set();
+  w.enqueue(f);
+  f.unset();
+  copy(dst, src, size, f);
+  return mark(f);
+}
+
+/**
+ * copy device to device memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+inline mark copy(device_ptr<T> dst, const device_ptr<T> src,
+  std::size_t size, feed & f, const wait_list & w) {
+  f.set();
+  w.enqueue(f);
+  f.unset();
+  copy(dst, src, size, f);
+  return mark(f);
+}
+
+/**
+ * zero device memory, see the OpenCL backend for the NUMA placement
+ * this is meant for
+ *
+ * @param dst device memory
+ * @param size number of Ts
+ * @param f feed the fill is executed in
+ */
+template <typename T>
+inline void first_touch(device_ptr<T> dst, std::size_t size, feed & f) {
+  f.set();
+  AURA_CUDA_SAFE_CALL(cuMemsetD8Async(
+    dst.get_base()+dst.get_offset()*sizeof(T), 0, size*sizeof(T),
+    f.get_backend_stream()));
+  f.unset();
+}
+
 
 /**
  * Allocate memory on host for optimized host to device transfer
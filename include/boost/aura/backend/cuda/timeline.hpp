@@ -0,0 +1,203 @@
+#ifndef AURA_BACKEND_CUDA_TIMELINE_HPP
+#define AURA_BACKEND_CUDA_TIMELINE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <cuda.h>
+#include <boost/move/move.hpp>
+#include <boost/aura/config.hpp>
+#include <boost/aura/backend/cuda/call.hpp>
+#include <boost/aura/backend/cuda/feed.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace backend_detail
+{
+namespace cuda
+{
+
+/**
+ * timeline class
+ *
+ * monotonic sequence numbers of a feed, signal() returns the next number
+ * and is reached when all commands issued to the feed before it have
+ * finished, waiting for a number waits for all smaller numbers too
+ *
+ * AURA_TIMELINE_CAPACITY events are created once and recorded again
+ * round robin, waiting for a number whose event was recorded again
+ * waits for a later number instead
+ */
+class timeline
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(timeline)
+
+public:
+	/// create empty timeline
+	inline explicit timeline() : feed_(nullptr), value_(0), completed_(0) {}
+
+	/**
+	 * create timeline for a feed
+	 *
+	 * @param f feed, must outlive the timeline
+	 * @param capacity number of events
+	 */
+	inline explicit timeline(feed & f,
+			std::size_t capacity = AURA_TIMELINE_CAPACITY) :
+		feed_(&f), events_(capacity), value_(0), completed_(0)
+	{
+		feed_->set();
+		for (auto& e : events_) {
+			AURA_CUDA_SAFE_CALL(cuEventCreate(&e,
+						CU_EVENT_DISABLE_TIMING));
+		}
+		feed_->unset();
+	}
+
+	/**
+	 * move constructor, move timeline here, invalidate other
+	 *
+	 * @param t timeline to move here
+	 */
+	timeline(BOOST_RV_REF(timeline) t) :
+		feed_(t.feed_), events_(std::move(t.events_)),
+		value_(t.value_), completed_(t.completed_)
+	{
+		t.feed_ = nullptr;
+	}
+
+	/**
+	 * move assignment, move timeline here, invalidate other
+	 *
+	 * @param t timeline to move here
+	 */
+	timeline& operator=(BOOST_RV_REF(timeline) t)
+	{
+		finalize();
+		feed_ = t.feed_;
+		events_ = std::move(t.events_);
+		value_ = t.value_;
+		completed_ = t.completed_;
+		t.feed_ = nullptr;
+		return *this;
+	}
+
+	/// destroy timeline
+	inline ~timeline()
+	{
+		finalize();
+	}
+
+	/**
+	 * signal the next number
+	 *
+	 * @return number that is reached when all commands issued to the
+	 * feed so far have finished
+	 */
+	std::uint64_t signal()
+	{
+		feed_->set();
+		AURA_CUDA_SAFE_CALL(cuEventRecord(slot(value_+1),
+					feed_->get_backend_stream()));
+		feed_->unset();
+		return ++value_;
+	}
+
+	/// last signalled number
+	std::uint64_t get_value() const
+	{
+		return value_;
+	}
+
+	/// true if a number was reached, does not block
+	bool reached(std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return true;
+		}
+		assert(0 < v && v <= value_);
+		feed_->set();
+		CUresult r = cuEventQuery(slot(v));
+		feed_->unset();
+		if (CUDA_SUCCESS == r) {
+			completed_ = v;
+			return true;
+		}
+		if (CUDA_ERROR_NOT_READY != r) {
+			AURA_CUDA_SAFE_CALL(r);
+		}
+		return false;
+	}
+
+	/// block until a number was reached
+	void wait(std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return;
+		}
+		assert(0 < v && v <= value_);
+		feed_->set();
+		AURA_CUDA_SAFE_CALL(cuEventSynchronize(slot(v)));
+		feed_->unset();
+		completed_ = v;
+	}
+
+	/**
+	 * make another feed wait until a number was reached
+	 *
+	 * @param f feed that waits
+	 * @param v number
+	 */
+	void enqueue_wait(feed & f, std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return;
+		}
+		assert(0 < v && v <= value_);
+		f.set();
+		AURA_CUDA_SAFE_CALL(cuStreamWaitEvent(f.get_backend_stream(),
+					slot(v), 0));
+		f.unset();
+	}
+
+private:
+	CUevent& slot(std::uint64_t v)
+	{
+		return events_[v % events_.size()];
+	}
+
+	/// finalize object (called from dtor and move assign)
+	void finalize()
+	{
+		if (nullptr == feed_) {
+			return;
+		}
+		feed_->set();
+		for (auto& e : events_) {
+			AURA_CUDA_SAFE_CALL(cuEventDestroy(e));
+		}
+		feed_->unset();
+		events_.clear();
+	}
+
+	/// feed the numbers are signalled in
+	feed * feed_;
+	/// events, recorded round robin
+	std::vector<CUevent> events_;
+	/// last signalled number
+	std::uint64_t value_;
+	/// largest number known to be reached
+	std::uint64_t completed_;
+};
+
+} // cuda
+} // backend_detail
+} // aura
+} // boost
+
+#endif // AURA_BACKEND_CUDA_TIMELINE_HPP
+
@@ -4,6 +4,13 @@
 #include <array>
 #include <utility>
 #include <cstring>
+#include <cstdint>
+#include <type_traits>
+#ifdef __APPLE__
+	#include "OpenCL/opencl.h"
+#else
+	#include "CL/cl.h"
+#endif
 
 #include <boost/aura/meta/tsizeof.hpp>
 #include <boost/aura/detail/svec.hpp>
@@ -18,39 +25,102 @@ namespace opencl {
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
 
 typedef std::pair<void *, std::size_t> arg_t;
-template<unsigned long N>
-using args_tt = std::array<arg_t, N>;
 
-//alias for returned packed arguments
-template<int N>
-using  args_t = std::pair<char*, args_tt<N>>;
+/// Compiletime mask of the memory objects in a pack of types, bit i is type i.
+template <std::size_t I, typename... Targs>
+struct tbuffers
+{
+	enum tb : std::uint64_t {mask = 0};
+};
 
-/// Copy arguments to memory block recursively
-template <typename T0>
-void fill_args_(char* p, args_tt<0>::iterator it, const T0 a0)
+template <std::size_t I, typename T0, typename... Targs>
+struct tbuffers<I, T0, Targs...>
+{
+	enum tb : std::uint64_t {
+		mask = (std::is_same<T0, cl_mem>::value ?
+				(std::uint64_t)1 << I : 0) |
+			tbuffers<I+1, Targs...>::mask
+	};
+};
+
+/**
+ * packed arguments
+ *
+ * copies of the arguments are stored inline, every argument at an offset
+ * that is a multiple of its alignment, packing does not allocate
+ */
+template <typename... Targs>
+class args_t
 {
-	std::memcpy(p, &a0, sizeof(T0));
-	*it = std::make_pair(p, sizeof(T0));
+	typedef tlayout<0, Targs...> layout;
+
+public:
+	/// pack arguments
+	explicit args_t(const Targs&... ar)
+	{
+		fill_<0>(ar...);
+	}
+
+	/// number of arguments
+	std::size_t size() const
+	{
+		return sizeof...(Targs);
+	}
+
+	/// pointer to and size of argument i
+	arg_t operator[](std::size_t i) const
+	{
+		return arg_t(const_cast<char*>(&data_[layout::offset(i)]),
+				layout::size(i));
+	}
+
+	/// bit i is set if argument i is a memory object
+	static constexpr std::uint64_t buffers()
+	{
+		return tbuffers<0, Targs...>::mask;
+	}
+
+private:
+	static_assert(sizeof...(Targs) <= 64, "too many kernel arguments");
+
+	template <std::size_t I>
+	void fill_() {}
+
+	template <std::size_t I, typename T0, typename... Tr>
+	void fill_(const T0& a0, const Tr&... ar)
+	{
+		std::memcpy(&data_[layout::offset(I)], &a0, sizeof(T0));
+		fill_<I+1>(ar...);
+	}
+
+	/// copies of the arguments
+	alignas(talignof<Targs...>::al)
+		std::array<char, layout::sz> data_;
+};
+
+/// Pack arguments
+template <typename... Targs>
+args_t<Targs...> args(const Targs... ar)
+{
+	return args_t<Targs...>(ar...);
 }
 
-template <typename T0, typename... Targs>
-void fill_args_(char* p, args_tt<0>::iterator it,
-		const T0 a0, const Targs... ar)
+/// packed arguments in the form invoke passes them on
+template <typename... Targs>
+inline const args_t<Targs...>& get_args(const args_t<Targs...>& a)
 {
-	std::memcpy(p, &a0, sizeof(T0));
-	*it = std::make_pair(p, sizeof(T0));
-	fill_args_(p+sizeof(T0), ++it, ar...);
+	return a;
 }
 
-/// Pack arguments
+/// release packed arguments after invoke, nothing to do
 template <typename... Targs>
-args_t<sizeof...(Targs)> args(const Targs... ar)
+inline void release_args(const args_t<Targs...>&) {}
+
+/// memory objects among the packed arguments, bit i is argument i
+template <typename... Targs>
+inline std::uint64_t get_buffers(const args_t<Targs...>&)
 {
-	args_tt<sizeof...(Targs)> pa;
-	char* p = (char*)malloc(tsizeof<Targs...>::sz);
-	char* ptr = p;
-	fill_args_(p, pa.begin(), ar...);
-	return std::make_pair(ptr, pa);
+	return args_t<Targs...>::buffers();
 }
 
 
@@ -602,6 +672,35 @@ args_t args(const T0 & a0, const T1 & a1, const T2 & a2, const T3 & a3,
   );
 }
 
+/// packed arguments in the form invoke passes them on
+inline const args_tt& get_args(const args_t& a)
+{
+	return a.second;
+}
+
+/// release packed arguments after invoke
+inline void release_args(const args_t& a)
+{
+	free(a.first);
+}
+
+/**
+ * memory objects among the packed arguments, bit i is argument i
+ *
+ * the types are not known here, scalars of the size of a memory object
+ * are treated as memory objects
+ */
+inline std::uint64_t get_buffers(const args_t& a)
+{
+	std::uint64_t mask = 0;
+	for (std::size_t i=0; i<a.second.size(); i++) {
+		if (sizeof(cl_mem) == a.second[i].second) {
+			mask |= (std::uint64_t)1 << i;
+		}
+	}
+	return mask;
+}
+
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 
 } // opencl
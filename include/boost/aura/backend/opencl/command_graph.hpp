@@ -0,0 +1,369 @@
+#ifndef AURA_BACKEND_OPENCL_COMMAND_GRAPH_HPP
+#define AURA_BACKEND_OPENCL_COMMAND_GRAPH_HPP
+
+#include <map>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#include <functional>
+#include <boost/move/move.hpp>
+#ifdef __APPLE__
+	#include "OpenCL/opencl.h"
+#else
+	#include "CL/cl.h"
+#endif
+#include <boost/aura/backend/opencl/call.hpp>
+#include <boost/aura/backend/opencl/device.hpp>
+#include <boost/aura/backend/opencl/feed.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace backend_detail
+{
+namespace opencl
+{
+
+/**
+ * command_graph class
+ *
+ * a sequence of kernels, copies and fourier transforms recorded from a
+ * feed (begin_capture) that can be replayed many times, replaying
+ * does not look up kernels, pack arguments or calculate meshes again
+ *
+ * kernel arguments are stored when the kernel is recorded, scalar
+ * arguments that change between replays are accessed through slots
+ *
+ * dependencies between commands are derived when recording: a command
+ * depends on the last command that used one of its memory objects, in an
+ * out-of-order feed (OpenCL 1.2) independent commands of a replay can run
+ * concurrently
+ *
+ * kernel arguments are set on the kernel of the replaying host thread, a
+ * thread other than the recording one gets its own kernels created from
+ * the program of the recorded ones
+ *
+ * kernels, memory and host memory used by the recorded commands must
+ * live as long as the graph is replayed
+ */
+class command_graph
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(command_graph)
+
+	struct command
+	{
+		/// kernel or nullptr for other commands
+		cl_kernel kernel;
+		/// host thread that recorded the kernel
+		std::thread::id owner;
+		std::array<std::size_t, 3> mesh;
+		std::array<std::size_t, 3> bundle;
+		/// copy of the kernel arguments
+		std::vector<char> args;
+		/// offset and size of each kernel argument
+		std::vector<std::pair<std::size_t, std::size_t> > layout;
+		/// copy or transform
+		std::function<void(feed&)> op;
+		/// commands this command depends on
+		std::vector<std::size_t> deps;
+	};
+
+public:
+	/// a scalar kernel argument of a recorded command
+	struct slot
+	{
+		std::size_t command;
+		std::size_t arg;
+	};
+
+	/// create empty graph
+	inline explicit command_graph() : mutex_(new std::mutex) {}
+
+	/**
+	 * move constructor, move graph here, invalidate other
+	 *
+	 * @param g graph to move here
+	 */
+	command_graph(BOOST_RV_REF(command_graph) g) :
+		commands_(std::move(g.commands_)), users_(std::move(g.users_)),
+		kernels_(std::move(g.kernels_)), mutex_(std::move(g.mutex_))
+	{
+		g.kernels_.clear();
+	}
+
+	/**
+	 * move assignment, move graph here, invalidate other
+	 *
+	 * @param g graph to move here
+	 */
+	command_graph& operator=(BOOST_RV_REF(command_graph) g)
+	{
+		release_kernels();
+		commands_ = std::move(g.commands_);
+		users_ = std::move(g.users_);
+		kernels_ = std::move(g.kernels_);
+		mutex_ = std::move(g.mutex_);
+		g.kernels_.clear();
+		return *this;
+	}
+
+	/// destroy graph, release the kernels created for replaying threads
+	~command_graph()
+	{
+		release_kernels();
+	}
+
+	/// number of recorded commands
+	std::size_t size() const
+	{
+		return commands_.size();
+	}
+
+	/// remove all commands
+	void clear()
+	{
+		release_kernels();
+		commands_.clear();
+		users_.clear();
+	}
+
+	/**
+	 * record a kernel (called by invoke while capturing)
+	 *
+	 * @param k kernel
+	 * @param mesh 3-dimensional mesh
+	 * @param bundle 3-dimensional bundle
+	 * @param args pointer and size of each argument
+	 * @param mask bit i is set if argument i is a memory object
+	 */
+	template <typename Args>
+	void record_kernel(cl_kernel k, const std::size_t* mesh,
+			const std::size_t* bundle, const Args& args,
+			std::uint64_t mask)
+	{
+		command c;
+		c.kernel = k;
+		c.owner = std::this_thread::get_id();
+		std::copy(mesh, mesh+3, c.mesh.begin());
+		std::copy(bundle, bundle+3, c.bundle.begin());
+		std::vector<cl_mem> buffers;
+		for (std::size_t i=0; i<args.size(); i++) {
+			std::size_t offset = c.args.size();
+			const char* p = (const char*)args[i].first;
+			c.args.insert(c.args.end(), p, p+args[i].second);
+			c.layout.push_back(std::make_pair(offset, args[i].second));
+			if (mask & ((std::uint64_t)1 << i)) {
+				cl_mem m;
+				std::memcpy(&m, p, sizeof(m));
+				buffers.push_back(m);
+			}
+		}
+		add(c, buffers);
+	}
+
+	/**
+	 * record an operation (called by copy and fft while capturing)
+	 *
+	 * @param op operation, enqueues its commands in the feed
+	 * @param buffers memory objects used by the operation
+	 */
+	void record(std::function<void(feed&)> op,
+			const std::vector<cl_mem>& buffers)
+	{
+		command c;
+		c.kernel = nullptr;
+		c.op = op;
+		add(c, buffers);
+	}
+
+	/**
+	 * commands a recorded command waits for in an out-of-order feed
+	 *
+	 * @param command command index
+	 */
+	const std::vector<std::size_t>& get_deps(std::size_t command) const
+	{
+		return commands_[command].deps;
+	}
+
+	/**
+	 * slot of an argument of the last recorded kernel, record a kernel
+	 * and ask for its slots before recording the next command
+	 *
+	 * @param arg argument index
+	 */
+	slot get_slot(std::size_t arg) const
+	{
+		assert(!commands_.empty());
+		assert(nullptr != commands_.back().kernel);
+		assert(arg < commands_.back().layout.size());
+		slot s = { commands_.size()-1, arg };
+		return s;
+	}
+
+	/// set the value of a slot for the following replays
+	template <typename T>
+	void set(const slot& s, const T& value)
+	{
+		command& c = commands_[s.command];
+		assert(sizeof(T) == c.layout[s.arg].second);
+		std::memcpy(&c.args[c.layout[s.arg].first], &value, sizeof(T));
+	}
+
+	/**
+	 * enqueue all commands in a feed
+	 *
+	 * @param f feed, must not be capturing
+	 */
+	void replay(feed& f)
+	{
+		assert(nullptr == f.get_capture());
+#ifdef CL_VERSION_1_2
+		if (feed_order::in_order == f.get_order()) {
+#endif // CL_VERSION_1_2
+			for (auto& c : commands_) {
+				enqueue(c, f, 0, NULL, NULL);
+			}
+			return;
+#ifdef CL_VERSION_1_2
+		}
+		std::vector<cl_event> events(commands_.size());
+		std::vector<cl_event> wait;
+		for (std::size_t i=0; i<commands_.size(); i++) {
+			wait.clear();
+			for (auto d : commands_[i].deps) {
+				wait.push_back(events[d]);
+			}
+			enqueue(commands_[i], f, wait.size(),
+					wait.empty() ? NULL : &wait[0], &events[i]);
+		}
+		for (auto e : events) {
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(e));
+		}
+#endif // CL_VERSION_1_2
+	}
+
+private:
+	void add(command& c, const std::vector<cl_mem>& buffers)
+	{
+		std::size_t index = commands_.size();
+		for (auto m : buffers) {
+			auto it = users_.find(m);
+			if (users_.end() != it) {
+				if (c.deps.end() == std::find(c.deps.begin(),
+							c.deps.end(), it->second)) {
+					c.deps.push_back(it->second);
+				}
+			}
+			users_[m] = index;
+		}
+		commands_.push_back(std::move(c));
+	}
+
+	/// kernel of the calling host thread for a recorded kernel
+	cl_kernel get_kernel(const command& c)
+	{
+		if (std::this_thread::get_id() == c.owner) {
+			return c.kernel;
+		}
+		std::lock_guard<std::mutex> guard(*mutex_);
+		cl_kernel& k = kernels_[std::make_pair(c.kernel,
+				std::this_thread::get_id())];
+		if (nullptr == k) {
+			cl_program program;
+			AURA_OPENCL_SAFE_CALL(clGetKernelInfo(c.kernel,
+					CL_KERNEL_PROGRAM, sizeof(program),
+					&program, NULL));
+			std::size_t size = 0;
+			AURA_OPENCL_SAFE_CALL(clGetKernelInfo(c.kernel,
+					CL_KERNEL_FUNCTION_NAME, 0, NULL, &size));
+			std::string name(size, '\0');
+			AURA_OPENCL_SAFE_CALL(clGetKernelInfo(c.kernel,
+					CL_KERNEL_FUNCTION_NAME, size, &name[0],
+					NULL));
+			int errorcode = 0;
+			k = clCreateKernel(program, name.c_str(), &errorcode);
+			AURA_OPENCL_CHECK_ERROR(errorcode);
+		}
+		return k;
+	}
+
+	/// release the kernels created for replaying threads
+	void release_kernels()
+	{
+		for (auto& k : kernels_) {
+			AURA_OPENCL_SAFE_CALL(clReleaseKernel(k.second));
+		}
+		kernels_.clear();
+	}
+
+	void enqueue(command& c, feed& f, cl_uint num,
+			const cl_event* wait, cl_event* event)
+	{
+		if (nullptr == c.kernel) {
+#ifdef CL_VERSION_1_2
+			// operations do not take wait lists, fence them
+			if (num > 0) {
+				AURA_OPENCL_SAFE_CALL(clEnqueueBarrierWithWaitList(
+						f.get_backend_stream(), num, wait, NULL));
+			}
+			c.op(f);
+			if (NULL != event) {
+				AURA_OPENCL_SAFE_CALL(clEnqueueMarkerWithWaitList(
+						f.get_backend_stream(), 0, NULL, event));
+			}
+#else
+			c.op(f);
+#endif // CL_VERSION_1_2
+			return;
+		}
+		cl_kernel k = get_kernel(c);
+		for (std::size_t i=0; i<c.layout.size(); i++) {
+			AURA_OPENCL_SAFE_CALL(clSetKernelArg(k, i,
+						c.layout[i].second,
+						&c.args[c.layout[i].first]));
+		}
+		AURA_OPENCL_SAFE_CALL(clEnqueueNDRangeKernel(
+			f.get_backend_stream(), k, 3, NULL,
+			&c.mesh[0], &c.bundle[0], num, wait, event));
+	}
+
+	/// recorded commands
+	std::vector<command> commands_;
+	/// last command that used a memory object
+	std::map<cl_mem, std::size_t> users_;
+	/// kernels created for replaying threads by recorded kernel and thread
+	std::map<std::pair<cl_kernel, std::thread::id>, cl_kernel> kernels_;
+	/// guards kernels_
+	std::unique_ptr<std::mutex> mutex_;
+};
+
+/// record commands issued to the feed into the graph instead of running them
+inline void begin_capture(feed& f, command_graph& g)
+{
+	f.set_capture(&g);
+}
+
+/// stop recording commands issued to the feed
+inline void end_capture(feed& f)
+{
+	f.set_capture(nullptr);
+}
+
+} // opencl
+} // backend_detail
+} // aura
+} // boost
+
+#endif // AURA_BACKEND_OPENCL_COMMAND_GRAPH_HPP
+
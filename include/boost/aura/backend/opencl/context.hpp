@@ -4,19 +4,31 @@
 
 
 #include <boost/move/move.hpp>
+#include <mutex>
+#include <string>
 #include <vector>
+#include <cstdio>
+#include <cstring>
 #ifdef __APPLE__
 	#include "OpenCL/opencl.h"
 #else
 	#include "CL/cl.h"
 #endif
 #include <boost/aura/backend/opencl/call.hpp>
+#include <boost/aura/backend/opencl/detail/scratch_arena.hpp>
+#include <boost/aura/detail/host_pool.hpp>
+#include <boost/aura/detail/launch_cache.hpp>
+#include <boost/aura/detail/svec.hpp>
+#include <boost/aura/config.hpp>
 
 namespace boost
 {
 namespace aura {
 namespace backend_detail {
 namespace opencl {
+
+#include <boost/aura/backend/shared/device_info.hpp>
+
 namespace detail {
 
 /**
@@ -34,7 +46,7 @@ public:
    *
    * @param ordinal context number
    */
-  inline context (int ordinal) : ordinal_(ordinal) {
+  inline context (int ordinal) : ordinal_(ordinal), sub_device_(false) {
     // get platforms
     unsigned int num_platforms = 0;
     AURA_OPENCL_SAFE_CALL(clGetPlatformIDs(0, 0, &num_platforms));
@@ -58,26 +70,52 @@ public:
       }
     }
 
-    int errorcode = 0;
-    context_ = clCreateContext(NULL, 1, &device_, NULL, NULL, &errorcode);
-    AURA_OPENCL_CHECK_ERROR(errorcode);
+    create();
+  }
 
-#ifndef CL_VERSION_1_2
-	dummy_mem_ = clCreateBuffer(context_,
-		CL_MEM_READ_WRITE, 2, 0, &errorcode);
-	AURA_OPENCL_CHECK_ERROR(errorcode);
-#endif // CL_VERSION_1_2
+#ifdef CL_VERSION_1_2
+  /**
+   * create context for a sub-device, the context takes ownership of
+   * the sub-device
+   *
+   * @param sub_device sub-device created with clCreateSubDevices
+   * @param ordinal ordinal of the parent device
+   * @param key identity of the sub-device, see get_key
+   */
+  inline context (cl_device_id sub_device, int ordinal,
+      const std::string& key) :
+    ordinal_(ordinal), device_(sub_device), sub_device_(true), key_(key) {
+    create();
   }
+#endif // CL_VERSION_1_2
 
   /**
    * destroy context
    */
   inline ~context() {
-#ifndef CL_VERSION_1_2
-	AURA_OPENCL_SAFE_CALL(clReleaseMemObject(dummy_mem_));
-#endif // CL_VERSION_1_2
-
+	delete scratch_;
+	// pooled host blocks are mapped, unmap before release
+	if (host_pool_->count() > 0) {
+		int errorcode = 0;
+		cl_command_queue q = clCreateCommandQueue(context_, device_,
+				0, &errorcode);
+		AURA_OPENCL_CHECK_ERROR(errorcode);
+		host_pool_->clear([&](void* ptr, std::uintptr_t handle) {
+			AURA_OPENCL_SAFE_CALL(clEnqueueUnmapMemObject(q,
+					(cl_mem)handle, ptr, 0, NULL, NULL));
+			AURA_OPENCL_SAFE_CALL(clReleaseMemObject((cl_mem)handle));
+		});
+		AURA_OPENCL_SAFE_CALL(clFinish(q));
+		AURA_OPENCL_SAFE_CALL(clReleaseCommandQueue(q));
+	}
+	delete host_pool_;
+	delete launch_cache_;
 	AURA_OPENCL_SAFE_CALL(clReleaseContext(context_));
+#ifdef CL_VERSION_1_2
+	if (sub_device_) {
+		AURA_OPENCL_SAFE_CALL(clReleaseDevice(device_));
+	}
+#endif // CL_VERSION_1_2
   }
 
 
@@ -98,6 +136,25 @@ public:
     return device_;
   }
 
+  /// true if the context was created for a sub-device
+  inline bool is_sub_device() const {
+    return sub_device_;
+  }
+
+  /**
+   * identity of the device in the tuning database and the ahead of time
+   * compiled binaries, the device name, sub-devices add their partition
+   * index and number of compute units to the identity of the parent
+   */
+  inline std::string get_key() {
+    return sub_device_ ? key_ : std::string(get_info().name);
+  }
+
+  /// true if the device is a CPU
+  inline bool is_cpu() const {
+    return cpu_;
+  }
+
   /// access the context handle
   inline const cl_context & get_backend_context() const {
     return context_;
@@ -108,23 +165,139 @@ public:
     return ordinal_;
   }
 
-#ifndef CL_VERSION_1_2
-	inline cl_mem get_dummy_mem() {
-		return dummy_mem_;
-	}
-#endif // CL_VERSION_1_2
+  /// access the scratch memory shared by library calls
+  inline scratch_arena & get_scratch() {
+    return *scratch_;
+  }
+
+  inline const scratch_arena & get_scratch() const {
+    return *scratch_;
+  }
+
+  /// access the pinned host memory pool
+  inline aura::detail::host_pool & get_host_pool() {
+    return *host_pool_;
+  }
+
+  /// access the launch geometries calculated by invoke
+  inline aura::detail::launch_cache & get_launch_cache() {
+    return *launch_cache_;
+  }
+
+  /// access the device properties, queried on first access
+  inline const device_info & get_info() {
+    std::call_once(info_once_, [this]() { query_info(); });
+    return info_;
+  }
 
 private:
+  /// create context, scratch arena and host pool for device_
+  inline void create() {
+    int errorcode = 0;
+    context_ = clCreateContext(NULL, 1, &device_, NULL, NULL, &errorcode);
+    AURA_OPENCL_CHECK_ERROR(errorcode);
+    scratch_ = new scratch_arena(context_);
+    host_pool_ = new aura::detail::host_pool();
+    launch_cache_ = new aura::detail::launch_cache();
+
+    cl_device_type type;
+    AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device_, CL_DEVICE_TYPE,
+      sizeof(type), &type, NULL));
+    cpu_ = 0 != (type & CL_DEVICE_TYPE_CPU);
+  }
+
+  /// value of a scalar device property
+  template <typename T>
+  inline T query(cl_device_info param) const {
+    T v = T();
+    AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device_, param,
+      sizeof(v), &v, NULL));
+    return v;
+  }
+
+  /// value of a string device property
+  inline std::string query_string(cl_device_info param) const {
+    std::size_t len = 0;
+    AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device_, param, 0, NULL, &len));
+    std::vector<char> buf(len+1, 0);
+    AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device_, param, len,
+      &buf[0], NULL));
+    return std::string(&buf[0]);
+  }
+
+  /// query the device properties
+  inline void query_info() {
+    std::memset(info_.name, 0, sizeof(info_.name));
+    std::memset(info_.vendor, 0, sizeof(info_.vendor));
+    std::strncpy(info_.name, query_string(CL_DEVICE_NAME).c_str(),
+      sizeof(info_.name)-1);
+    std::strncpy(info_.vendor, query_string(CL_DEVICE_VENDOR).c_str(),
+      sizeof(info_.vendor)-1);
+    std::memset(info_.driver, 0, sizeof(info_.driver));
+    std::strncpy(info_.driver, query_string(CL_DRIVER_VERSION).c_str(),
+      sizeof(info_.driver)-1);
+
+    // mesh
+    cl_uint dims = query<cl_uint>(CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS);
+    std::vector<std::size_t> sizes(dims);
+    AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device_,
+      CL_DEVICE_MAX_WORK_ITEM_SIZES, sizeof(std::size_t)*dims,
+      &sizes[0], NULL));
+    for(cl_uint i=0; i<dims && i<AURA_MAX_MESH_DIMS; i++) {
+      info_.max_mesh.push_back(sizes[i]);
+    }
+    // bundle
+    info_.max_bundle = info_.max_mesh;
+    // fibers in bundle
+    info_.max_fibers_per_bundle =
+      query<std::size_t>(CL_DEVICE_MAX_WORK_GROUP_SIZE);
+
+    info_.compute_units = query<cl_uint>(CL_DEVICE_MAX_COMPUTE_UNITS);
+    info_.clock = query<cl_uint>(CL_DEVICE_MAX_CLOCK_FREQUENCY);
+    info_.global_memory = query<cl_ulong>(CL_DEVICE_GLOBAL_MEM_SIZE);
+    info_.max_alloc = query<cl_ulong>(CL_DEVICE_MAX_MEM_ALLOC_SIZE);
+    info_.local_memory = query<cl_ulong>(CL_DEVICE_LOCAL_MEM_SIZE);
+    info_.cache_line = query<cl_uint>(CL_DEVICE_GLOBAL_MEM_CACHELINE_SIZE);
+    info_.cache_size = query<cl_ulong>(CL_DEVICE_GLOBAL_MEM_CACHE_SIZE);
+    info_.preferred_vector_width =
+      query<cl_uint>(CL_DEVICE_PREFERRED_VECTOR_WIDTH_FLOAT);
+#ifdef CL_VERSION_1_1
+    info_.native_vector_width =
+      query<cl_uint>(CL_DEVICE_NATIVE_VECTOR_WIDTH_FLOAT);
+    info_.unified_memory =
+      CL_TRUE == query<cl_bool>(CL_DEVICE_HOST_UNIFIED_MEMORY);
+#else
+    info_.native_vector_width = info_.preferred_vector_width;
+    info_.unified_memory = cpu_;
+#endif // CL_VERSION_1_1
+    std::string extensions = query_string(CL_DEVICE_EXTENSIONS);
+    info_.fp64 = std::string::npos != extensions.find("cl_khr_fp64");
+    info_.fp16 = std::string::npos != extensions.find("cl_khr_fp16");
+    info_.cpu = cpu_;
+  }
+
   /// device ordinal
   int ordinal_;
   /// device handle
   cl_device_id device_;
   /// context handle
   cl_context context_;
-
-#ifndef CL_VERSION_1_2
-  cl_mem dummy_mem_;
-#endif // CL_VERSION_1_2
+  /// device_ is a sub-device owned by the context
+  bool sub_device_;
+  /// identity of a sub-device
+  std::string key_;
+  /// device is a CPU
+  bool cpu_;
+  /// scratch memory of library calls, one buffer per feed
+  scratch_arena * scratch_;
+  /// pinned host memory reused by host allocators
+  aura::detail::host_pool * host_pool_;
+  /// launch geometries of kernels invoked with bounds
+  aura::detail::launch_cache * launch_cache_;
+  /// device properties
+  device_info info_;
+  /// guards the query of info_
+  std::once_flag info_once_;
 
 };
 
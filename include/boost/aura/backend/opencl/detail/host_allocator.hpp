@@ -1,8 +1,10 @@
 #ifndef AURA_BACKEND_OPENCL_DETAIL_HOST_ALLOCATOR_HPP
 #define AURA_BACKEND_OPENCL_DETAIL_HOST_ALLOCATOR_HPP
 
+#include <cstdint>
 #include <boost/bimap.hpp>
 #include <boost/aura/backend/opencl/feed.hpp>
+#include <boost/aura/detail/host_pool.hpp>
 
 
 namespace boost
@@ -54,21 +56,51 @@ public:
 		mt_(other.mt_), f_(other.f_), map_(other.map_)
 	{}
 
-	/// allocate memory
+	/**
+	 * allocate memory
+	 *
+	 * memory is taken from the pinned host pool of the device if
+	 * possible, blocks are created with the size of their size class
+	 * and stay mapped while they are in the pool, pooled blocks are
+	 * shared by allocators with different memory tags and therefore
+	 * always read-write
+	 */
 	T* allocate(std::size_t n)
 	{
-		cl_mem_flags flag = translate_memory_tag(mt_);
+		aura::detail::host_pool& pool = f_->get_context()->get_host_pool();
+		void* ptr = nullptr;
+		std::uintptr_t handle = 0;
+		if (pool.acquire(n*sizeof(T), ptr, handle)) {
+			return (T*)ptr;
+		}
+		std::size_t size;
+		aura::detail::host_pool::size_class(n*sizeof(T), size);
+		memory_tag mt = aura::detail::host_pool::pooled(n*sizeof(T)) ?
+			memory_tag::rw : mt_;
+		cl_mem_flags flag = translate_memory_tag(mt);
 		int errorcode = 0;
 		memory m = clCreateBuffer(f_->get_backend_context(), 
 				flag | CL_MEM_ALLOC_HOST_PTR, 
-				n*sizeof(T), 0, &errorcode);
+				size, 0, &errorcode);
 		AURA_OPENCL_CHECK_ERROR(errorcode);
-		return map_impl(m, n);
+		T* p = (T*)clEnqueueMapBuffer(f_->get_backend_stream(), 
+				m, CL_TRUE,
+				translate_map_tag_inverted(mt), 
+				0, size, 0, NULL, NULL, &errorcode);
+		AURA_OPENCL_CHECK_ERROR(errorcode);
+		if (!pool.insert(p, (std::uintptr_t)m, size)) {
+			// not pooled, track it here
+			map_.insert(mapping(m, p, n));
+		}
+		return p;
 	}
 
-	/// free memory
+	/// free memory, pooled memory is returned to the pool
 	void deallocate(T* p, std::size_t n)
 	{
+		if (f_->get_context()->get_host_pool().release(p)) {
+			return;
+		}
 		memory m = unmap(p);
 		AURA_OPENCL_SAFE_CALL(clReleaseMemObject(m));
 		map_.erase(mapping(m, p));
@@ -77,6 +109,20 @@ public:
 	/// map OpenCL memory buffer into host memory space
 	T* map(memory m)
 	{
+		aura::detail::host_pool& pool = f_->get_context()->get_host_pool();
+		void* ptr = nullptr;
+		std::size_t size = 0;
+		if (pool.find_ptr((std::uintptr_t)m, ptr, size)) {
+			int errorcode = 0;
+			T* p = (T*)clEnqueueMapBuffer(f_->get_backend_stream(), 
+					m, CL_FALSE,
+					translate_map_tag_inverted(
+						memory_tag::rw), 
+					0, size, 0, NULL, NULL, &errorcode);
+			AURA_OPENCL_CHECK_ERROR(errorcode);
+			pool.rekey((std::uintptr_t)m, p);
+			return p;
+		}
 		return map_impl(m, map_.left.find(m)->info);
 	}
 
@@ -84,6 +130,13 @@ public:
 	/// unmap OpenCL memory buffer from  host memory space
 	memory unmap(T* p)
 	{
+		std::uintptr_t handle = 0;
+		if (f_->get_context()->get_host_pool().find_handle(p, handle)) {
+			AURA_OPENCL_SAFE_CALL(clEnqueueUnmapMemObject(
+						f_->get_backend_stream(),
+						(memory)handle, p, 0, NULL, NULL));
+			return (memory)handle;
+		}
 		memory m = map_.right.at(p);
 		AURA_OPENCL_SAFE_CALL(clEnqueueUnmapMemObject(
 					f_->get_backend_stream(),
@@ -134,7 +187,7 @@ public:
 template <typename U, typename V>
 bool operator==(const host_allocator<U>& lhs, const host_allocator<V>& rhs) 
 {
-	return *lhs.f_ == *rhs.f_ && 
+	return lhs.f_ == rhs.f_ && 
 		lhs.mt_ == rhs.mt_ && 
 		lhs.map_ == rhs.map_;
 }
@@ -0,0 +1,163 @@
+#ifndef AURA_BACKEND_OPENCL_DETAIL_KERNEL_BINARIES_HPP
+#define AURA_BACKEND_OPENCL_DETAIL_KERNEL_BINARIES_HPP
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#ifdef __APPLE__
+	#include "OpenCL/opencl.h"
+#else
+	#include "CL/cl.h"
+#endif
+#include <boost/aura/backend/opencl/call.hpp>
+#include <boost/aura/config.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace backend_detail
+{
+namespace opencl
+{
+namespace detail
+{
+
+/// program binary of a module, compiled ahead of time for a device
+struct kernel_binary
+{
+	/// device identity (device::get_key, CL_DEVICE_NAME of a device)
+	const char* device;
+	/// driver version (CL_DRIVER_VERSION)
+	const char* driver;
+	/// hash of source and build options, see hash_kernel_source
+	std::uint64_t hash;
+	/// program binary
+	const unsigned char* data;
+	/// size of the program binary
+	std::size_t size;
+};
+
+/**
+ * hash of the source of a module, its build options and the version of
+ * the headers the source includes (AURA_KERNEL_VERSION), FNV-1a
+ */
+inline std::uint64_t hash_kernel_source(const char* source,
+		const char* build_options)
+{
+	std::uint64_t h = 14695981039346656037ULL;
+	auto add = [&](const char* s) {
+		for (; nullptr != s && 0 != *s; s++) {
+			h = (h ^ (unsigned char)*s) * 1099511628211ULL;
+		}
+		// separator
+		h = h * 1099511628211ULL;
+	};
+	add(source);
+	add(build_options);
+	add(std::to_string(AURA_KERNEL_VERSION).c_str());
+	return h;
+}
+
+/// string valued device property
+inline std::string get_device_string(cl_device_id device,
+		cl_device_info param)
+{
+	std::size_t size = 0;
+	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device, param, 0, NULL, &size));
+	std::vector<char> v(size + 1, 0);
+	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(device, param, size, &v[0],
+				NULL));
+	return std::string(&v[0]);
+}
+
+/**
+ * kernel_binaries class
+ *
+ * program binaries embedded in the application (see
+ * tools/compile_kernels.cpp), modules built from a source that has a
+ * binary for the device and driver are loaded from the binary
+ */
+class kernel_binaries
+{
+
+public:
+	/// register binaries, called by the generated binary tables
+	void add(const kernel_binary* binaries, std::size_t num)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (std::size_t i=0; i<num; i++) {
+			const kernel_binary& b = binaries[i];
+			binaries_[key(b.device, b.driver, b.hash)] = &b;
+		}
+	}
+
+	/**
+	 * find the binary of a module for a device
+	 *
+	 * @param device_key identity of the device (see device::get_key),
+	 * for sub-devices without a binary of their own the binary of the
+	 * device they were partitioned from is used
+	 * @param device device handle
+	 * @return binary or nullptr if there is none
+	 */
+	const kernel_binary* find(const std::string& device_key,
+			cl_device_id device, const char* source,
+			const char* build_options)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (binaries_.empty()) {
+				return nullptr;
+			}
+		}
+		std::string driver = get_device_string(device, CL_DRIVER_VERSION);
+		std::uint64_t hash = hash_kernel_source(source, build_options);
+		std::string name = get_device_string(device, CL_DEVICE_NAME);
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = binaries_.find(key(device_key, driver, hash));
+		if (binaries_.end() == it) {
+			it = binaries_.find(key(name, driver, hash));
+		}
+		return binaries_.end() == it ? nullptr : it->second;
+	}
+
+private:
+	/// device name, driver version and hash
+	typedef std::tuple<std::string, std::string, std::uint64_t> key;
+
+	/// binaries
+	std::map<key, const kernel_binary*> binaries_;
+	/// protects binaries_
+	std::mutex mutex_;
+};
+
+/// binaries embedded in the application
+inline kernel_binaries& get_kernel_binaries()
+{
+	static kernel_binaries b;
+	return b;
+}
+
+/// registers a table of binaries when it is constructed
+struct register_kernel_binaries
+{
+	register_kernel_binaries(const kernel_binary* binaries,
+			std::size_t num)
+	{
+		get_kernel_binaries().add(binaries, num);
+	}
+};
+
+} // namespace detail
+} // namespace opencl
+} // namespace backend_detail
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_BACKEND_OPENCL_DETAIL_KERNEL_BINARIES_HPP
+
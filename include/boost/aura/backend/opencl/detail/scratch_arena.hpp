@@ -0,0 +1,184 @@
+#ifndef AURA_BACKEND_OPENCL_DETAIL_SCRATCH_ARENA_HPP
+#define AURA_BACKEND_OPENCL_DETAIL_SCRATCH_ARENA_HPP
+
+#include <mutex>
+#include <cstddef>
+#include <unordered_map>
+#ifdef __APPLE__
+	#include "OpenCL/opencl.h"
+#else
+	#include "CL/cl.h"
+#endif
+#include <boost/aura/backend/opencl/call.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace backend_detail
+{
+namespace opencl
+{
+namespace detail
+{
+
+/**
+ * scratch_arena class
+ *
+ * device memory for temporary results of library calls (e.g. FFT),
+ * one buffer per command queue, sized to the largest request issued
+ * to that queue so far
+ *
+ * commands in an in-order feed execute in order, so all library calls
+ * issued to the same feed can share one buffer, calls in different feeds
+ * can not, in an out-of-order feed a call waits for the completion event
+ * of the previous user of the buffer (see used)
+ */
+class scratch_arena
+{
+
+private:
+	struct entry
+	{
+		cl_mem memory;
+		std::size_t size;
+		/// completion event of the last user or nullptr
+		cl_event last;
+	};
+
+public:
+	/// create empty arena for context
+	inline explicit scratch_arena(cl_context c) : context_(c), size_(0) {}
+
+	/// destroy arena, free all buffers
+	inline ~scratch_arena()
+	{
+		for (auto& it : buffers_) {
+			AURA_OPENCL_SAFE_CALL(clReleaseMemObject(it.second.memory));
+			release_last(it.second);
+		}
+	}
+
+	/**
+	 * get a scratch buffer of at least size bytes for queue q
+	 *
+	 * if the existing buffer is too small it is released and replaced,
+	 * OpenCL keeps it alive until commands already enqueued that use
+	 * it have finished
+	 *
+	 * @param last if not NULL set to the completion event of the
+	 * previous user of the buffer (retained, the caller releases it) or
+	 * nullptr if there is none
+	 * @return buffer or nullptr if size is 0
+	 */
+	inline cl_mem acquire(const cl_command_queue& q, std::size_t size,
+			cl_event* last = NULL)
+	{
+		if (NULL != last) {
+			*last = nullptr;
+		}
+		if (0 == size) {
+			return nullptr;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = buffers_.find(q);
+		if (buffers_.end() != it && it->second.size >= size) {
+			if (NULL != last && nullptr != it->second.last) {
+				AURA_OPENCL_SAFE_CALL(
+						clRetainEvent(it->second.last));
+				*last = it->second.last;
+			}
+			return it->second.memory;
+		}
+		int errorcode = 0;
+		cl_mem m = clCreateBuffer(context_, CL_MEM_READ_WRITE,
+				size, 0, &errorcode);
+		AURA_OPENCL_CHECK_ERROR(errorcode);
+		if (buffers_.end() != it) {
+			AURA_OPENCL_SAFE_CALL(
+					clReleaseMemObject(it->second.memory));
+			size_ -= it->second.size;
+			// nobody used the new buffer yet
+			release_last(it->second);
+			it->second.memory = m;
+			it->second.size = size;
+		} else {
+			entry e = { m, size, nullptr };
+			buffers_.insert(std::make_pair(q, e));
+		}
+		size_ += size;
+		return m;
+	}
+
+	/**
+	 * set the completion event of the last user of the scratch buffer
+	 * of queue q, the arena takes ownership of the event
+	 */
+	inline void used(const cl_command_queue& q, cl_event e)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = buffers_.find(q);
+		if (buffers_.end() == it) {
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(e));
+			return;
+		}
+		release_last(it->second);
+		it->second.last = e;
+	}
+
+	/// release the scratch buffer of queue q (called if a feed dies)
+	inline void release(const cl_command_queue& q)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = buffers_.find(q);
+		if (buffers_.end() == it) {
+			return;
+		}
+		AURA_OPENCL_SAFE_CALL(clReleaseMemObject(it->second.memory));
+		release_last(it->second);
+		size_ -= it->second.size;
+		buffers_.erase(it);
+	}
+
+	/// total number of bytes held by the arena
+	inline std::size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return size_;
+	}
+
+	/// number of buffers held by the arena
+	inline std::size_t count() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return buffers_.size();
+	}
+
+private:
+	/// release the completion event of the last user of a buffer
+	static void release_last(entry& e)
+	{
+		if (nullptr != e.last) {
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(e.last));
+			e.last = nullptr;
+		}
+	}
+
+	/// context the buffers are allocated in
+	cl_context context_;
+	/// sum of all buffer sizes
+	std::size_t size_;
+	/// one buffer per queue
+	std::unordered_map<cl_command_queue, entry> buffers_;
+	/// arena can be used from multiple threads through different feeds
+	mutable std::mutex mutex_;
+};
+
+} // detail
+} // opencl
+} // backend_detail
+} // aura
+} // boost
+
+#endif // AURA_BACKEND_OPENCL_DETAIL_SCRATCH_ARENA_HPP
+
@@ -2,6 +2,7 @@
 #ifndef AURA_BACKEND_OPENCL_DEVICE_HPP
 #define AURA_BACKEND_OPENCL_DEVICE_HPP
 
+#include <string>
 #include <fstream>
 #include <cstddef>
 #include <cstring>
@@ -18,6 +19,7 @@
 #include <boost/aura/backend/opencl/context.hpp>
 #include <boost/aura/misc/deprecate.hpp>
 #include <boost/aura/device_lock.hpp>
+#include <boost/aura/backend/shared/kernel_registry.hpp>
 #include <boost/aura/backend/opencl/module.hpp>
 namespace boost {
 namespace aura {
@@ -49,10 +51,13 @@ class device
 private:
 	BOOST_MOVABLE_BUT_NOT_COPYABLE(device)
 
+	/// modules and kernels, shared by the host threads
+	typedef aura::detail::kernel_registry<module, kernel> registry;
+
 public:
 
 	/// create empty device object without device and context
-	inline explicit device() : context_(nullptr) {}
+	inline explicit device() : context_(nullptr), registry_(nullptr) {}
 
 	/**
 	 * create device form ordinal, also creates a context
@@ -61,7 +66,8 @@ public:
 	 */
 	inline device(int ordinal) :
 		context_(new detail::context(ordinal)),
-		ordinal_(ordinal)
+		ordinal_(ordinal),
+		registry_(new registry())
 	{}
 
 	/**
@@ -73,9 +79,26 @@ public:
 	inline explicit device(std::size_t ordinal, device_lock& dl) :
 		context_(new detail::context(ordinal)),
 		ordinal_(ordinal),
+		registry_(new registry()),
 		device_lock_(dl)
 	{}
 
+#ifdef CL_VERSION_1_2
+	/**
+	 * create device from a sub-device, see create_sub_devices
+	 *
+	 * @param sub_device sub-device, the device takes ownership
+	 * @param ordinal ordinal of the parent device
+	 * @param key identity of the sub-device
+	 */
+	inline explicit device(cl_device_id sub_device, std::size_t ordinal,
+			const std::string& key) :
+		context_(new detail::context(sub_device, ordinal, key)),
+		ordinal_(ordinal),
+		registry_(new registry())
+	{}
+#endif // CL_VERSION_1_2
+
 	/// destroy device
 	inline ~device()
 	{
@@ -90,11 +113,11 @@ public:
 	device(BOOST_RV_REF(device) d) :
 		context_(d.context_),
 		ordinal_(d.ordinal_),
-		modules_(std::move(d.modules_)),
+		registry_(d.registry_),
 		device_lock_(std::move(d.device_lock_))
 	{
 		d.context_ = nullptr;
-		d.modules_.clear();
+		d.registry_ = nullptr;
 	}
 
 	/**
@@ -107,43 +130,48 @@ public:
 		finalize();
 		context_ = d.context_;
 		ordinal_ = d.ordinal_;
-		modules_ = std::move(d.modules_);
+		registry_ = d.registry_;
 		device_lock_ = std::move(d.device_lock_);
 		d.context_ = nullptr;
-		d.modules_.clear();
+		d.registry_ = nullptr;
 		return *this;
 	}
 
-	/// load a kernel from a file
+	/**
+	 * load a kernel from a file, safe to call from multiple host threads,
+	 * every thread gets its own kernel (see module::get_kernel)
+	 */
 	kernel load_from_file(const char* kernel_name,
 			const char* file_name,
 			const char* build_options=NULL)
 	{
-		auto it = modules_.find(file_name);
-		if (modules_.end() == it) {
-			auto it2 = modules_.insert(std::make_pair(file_name,
-				create_module_from_file(file_name,
-						*this, build_options)));
-			it = it2.first;
-		}
-		return it->second.get_kernel(kernel_name);
+		return registry_->get(file_name, kernel_name,
+				[&]() {
+					return create_module_from_file(
+						file_name, *this,
+						build_options);
+				},
+				[&](module& m) {
+					return m.get_kernel(kernel_name);
+				});
 	}
 
-	/// load a kernel from a string
+	/**
+	 * load a kernel from a string, safe to call from multiple host
+	 * threads, every thread gets its own kernel (see module::get_kernel)
+	 */
 	kernel load_from_string(const char* kernel_name,
 			const char* kernel_string,
 			const char* build_options=NULL, bool debug=false)
 	{
-		auto it = modules_.find(kernel_string);
-		if (modules_.end() == it) {
-			auto it2 = modules_.insert(
-					std::move(std::make_pair(kernel_string,
-						std::move(module(kernel_string, *this,
-							build_options)))));
-			it = it2.first;
-		}
-
-		return it->second.get_kernel(kernel_name);
+		return registry_->get(kernel_string, kernel_name,
+				[&]() {
+					return module(kernel_string, *this,
+						build_options);
+				},
+				[&](module& m) {
+					return m.get_kernel(kernel_name);
+				});
 	}
 
 	/// make device active
@@ -171,7 +199,7 @@ public:
 	}
 
 	/// access the context handle
-	inline detail::context * get_context()
+	inline detail::context * get_context() const
 	{
 		return context_;
 	}
@@ -182,6 +210,18 @@ public:
 		return ordinal_;
 	}
 
+	/// identity of the device in the tuning database, see context
+	inline std::string get_key() const
+	{
+		return context_->get_key();
+	}
+
+	/// true if the device is a CPU
+	inline bool is_cpu() const
+	{
+		return context_->is_cpu();
+	}
+
 	/// compare devices
 	inline bool operator==(const device& d) const
 	{
@@ -198,6 +238,10 @@ private:
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
+		// kernels and modules are released before the context
+		if (nullptr != registry_) {
+			delete registry_;
+		}
 		if(nullptr != context_) {
 			delete context_;
 		}
@@ -210,8 +254,8 @@ private:
 	/// device ordinal
 	std::size_t ordinal_;
 
-	/// modules
-	std::unordered_map<std::string, module> modules_;
+	/// modules and kernels
+	registry * registry_;
 
 	/// device_lock
 	device_lock device_lock_;
@@ -298,57 +342,16 @@ print_system_info();
 DEPRECATED(void print_device_info());
 
 
-#include <boost/aura/backend/shared/device_info.hpp>
-
-/// return the device info
+/// return the device info, queried once per device
 inline device_info device_get_info(device & d)
 {
-	device_info di;
-
-	// name and vendor
-	std::size_t len;
-	std::vector<char> buf;
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_NAME, 0, NULL, &len));
-	buf.reserve(len);
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_NAME, len, &buf[0], NULL));
-	strncpy(di.name, &buf[0], sizeof(di.name)-1);
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_VENDOR, 0, NULL, &len));
-	buf.reserve(len);
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_VENDOR, len, &buf[0], NULL));
-	strncpy(di.vendor, &buf[0], sizeof(di.name)-1);
-
-	// mesh
-	cl_uint dims;
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_MAX_WORK_ITEM_DIMENSIONS, sizeof(dims), &dims, NULL));
-	size_t sizes[dims];
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_MAX_WORK_ITEM_SIZES, sizeof(size_t)*dims, sizes, NULL));
-	assert(dims <= AURA_MAX_BUNDLE_DIMS);
-	for(cl_uint i=0; i<dims; i++) {
-		di.max_mesh.push_back(sizes[i]);
-	}
-
-	// bundle
-	di.max_bundle = di.max_mesh;
-
-	// fibers in bundle
-	size_t wgs;
-	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
-	CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(wgs), &wgs, NULL));
-	di.max_fibers_per_bundle = wgs;
-	return di;
+	return d.get_context()->get_info();
 }
 
 inline device create_device_exclusive()
 {
-	int num = device_get_count();
 	for (int n=0; n<device_get_count(); n++) {
-		auto dl = create_device_lock(num);
+		auto dl = create_device_lock(n);
 		if (dl) {
 			return device(n, dl);
 		}
@@ -357,6 +360,91 @@ inline device create_device_exclusive()
 }
 
 
+#ifdef CL_VERSION_1_2
+/**
+ * partition a device into sub-devices
+ *
+ * @param d device to partition (the parent)
+ * @param properties partition properties as passed to clCreateSubDevices
+ * @return sub-devices, empty if the device can not be partitioned
+ */
+inline std::vector<device> create_sub_devices(device& d,
+		const cl_device_partition_property* properties)
+{
+	std::vector<device> r;
+	cl_uint num = 0;
+	if (CL_SUCCESS != clCreateSubDevices(d.get_backend_device(),
+				properties, 0, NULL, &num) || 0 == num) {
+		return r;
+	}
+	std::vector<cl_device_id> ids(num);
+	AURA_OPENCL_SAFE_CALL(clCreateSubDevices(d.get_backend_device(),
+				properties, num, &ids[0], NULL));
+	r.reserve(num);
+	// sub-devices of a partition differ in their index and size
+	std::string parent = d.get_key();
+	for (cl_uint i=0; i<num; i++) {
+		cl_uint units = 0;
+		AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(ids[i],
+					CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(units),
+					&units, NULL));
+		r.push_back(device(ids[i], d.get_ordinal(), parent +
+					" [" + std::to_string(i) + ": " +
+					std::to_string(units) + " units]"));
+	}
+	return r;
+}
+
+/**
+ * partition a device into n sub-devices with an equal number of compute
+ * units (typically a CPU device)
+ *
+ * @return sub-devices, empty if the device can not be partitioned
+ */
+inline std::vector<device> create_sub_devices(device& d, std::size_t n)
+{
+	cl_uint units = 0;
+	AURA_OPENCL_SAFE_CALL(clGetDeviceInfo(d.get_backend_device(),
+				CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(units),
+				&units, NULL));
+	if (n == 0 || units < n) {
+		return std::vector<device>();
+	}
+	cl_device_partition_property properties[] = {
+		CL_DEVICE_PARTITION_EQUALLY,
+		(cl_device_partition_property)(units / n),
+		0
+	};
+	std::vector<device> r = create_sub_devices(d, properties);
+	// units not divisible by n results in an additional sub-device
+	while (r.size() > n) {
+		r.pop_back();
+	}
+	return r;
+}
+
+/**
+ * partition a CPU device into one sub-device per NUMA node, work-items
+ * of a sub-device run on the cores of its node and memory first touched
+ * by a sub-device is allocated on its node
+ *
+ * @return sub-devices, empty if the device is not a CPU or does not
+ * support partitioning by affinity domain
+ */
+inline std::vector<device> create_numa_sub_devices(device& d)
+{
+	if (!d.is_cpu()) {
+		return std::vector<device>();
+	}
+	cl_device_partition_property properties[] = {
+		CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,
+		CL_DEVICE_AFFINITY_DOMAIN_NUMA,
+		0
+	};
+	return create_sub_devices(d, properties);
+}
+#endif // CL_VERSION_1_2
+
 inline kernel create_kernel(module& m, const char * kernel_name)
 {
 	return m.get_kernel(kernel_name);
@@ -370,6 +458,10 @@ inline const cl_context & get_backend_context(const device & d)
 {
 	return d.get_backend_context();
 }
+inline std::string device_get_key(const device & d)
+{
+	return d.get_key();
+}
 
 } // opencl
 } // backend_detail
@@ -9,6 +9,7 @@
 #endif
 #include <boost/aura/backend/opencl/call.hpp>
 #include <boost/aura/backend/opencl/device.hpp>
+#include <boost/aura/backend/shared/feed_order.hpp>
 
 namespace boost
 {
@@ -23,6 +24,7 @@ namespace opencl
 // file detail/feed_marker_helper.hpp contains the code
 class mark;
 class feed;
+class command_graph;
 
 namespace detail
 {
@@ -49,20 +51,27 @@ public:
 	/**
 	 * create empty feed object without device and stream
 	 */
-	inline explicit feed() : context_(nullptr) {}
+	inline explicit feed() : context_(nullptr),
+		order_(feed_order::in_order), capture_(nullptr) {}
 
 	/**
 	 * create device feed for device
 	 *
 	 * @param d device to create feed for
+	 * @param order execution order of the commands of the feed
 	 *
 	 * const device & is not allowed since an actual instance is needed
 	 */
-	inline feed(device & d) : context_(d.get_context())
+	inline feed(device & d, feed_order order = feed_order::in_order) :
+		context_(d.get_context()), order_(order), capture_(nullptr)
 	{
 		int errorcode = 0;
+		cl_command_queue_properties properties =
+			feed_order::out_of_order == order ?
+			CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE : 0;
 		stream_ = clCreateCommandQueue(context_->get_backend_context(),
-				context_->get_backend_device(), 0, &errorcode);
+				context_->get_backend_device(), properties,
+				&errorcode);
 		AURA_OPENCL_CHECK_ERROR(errorcode);
 	}
 
@@ -72,7 +81,8 @@ public:
 	 * @param f feed to move here
 	 */
 	feed(BOOST_RV_REF(feed) f) :
-		context_(f.context_), stream_(f.stream_)
+		context_(f.context_), stream_(f.stream_), order_(f.order_),
+		capture_(f.capture_)
 	{
 		f.context_ = nullptr;
 	}
@@ -87,6 +97,8 @@ public:
 		finalize();
 		context_ = f.context_;
 		stream_ = f.stream_;
+		order_ = f.order_;
+		capture_ = f.capture_;
 		f.context_ = nullptr;
 		return *this;
 	}
@@ -119,13 +131,7 @@ public:
 		        )
 		);
 #else
-		AURA_OPENCL_SAFE_CALL(
-		        clEnqueueCopyBuffer(stream_,
-		                            context_->get_dummy_mem(),
-		                            context_->get_dummy_mem(),
-		                            0, 1, 1, 1, &e, NULL
-		                           )
-		);
+		AURA_OPENCL_SAFE_CALL(clEnqueueWaitForEvents(stream_, 1, &e));
 #endif
 	}
 
@@ -158,25 +164,37 @@ public:
 		return stream_;
 	}
 
-#ifndef CL_VERSION_1_2
-protected:
-	inline void insert_event(cl_event* event)
+	/// access the context of the device the feed was created for
+	inline detail::context * get_context() const
 	{
-		// insert a dummy memory copy
-		AURA_OPENCL_SAFE_CALL(clEnqueueCopyBuffer(
-		                              stream_, context_->get_dummy_mem(),
-		                              context_->get_dummy_mem(),
-		                              0, 1, 1, 0, NULL, event
-		                      )
-		                     );
+		return context_;
 	}
-#endif // CL_VERSION_1_2
+
+	/// execution order of the commands of the feed
+	inline feed_order get_order() const
+	{
+		return order_;
+	}
+
+	/// graph commands are recorded in, nullptr if not capturing
+	inline command_graph * get_capture() const
+	{
+		return capture_;
+	}
+
+	/// record commands in a graph (nullptr stops recording)
+	inline void set_capture(command_graph * g)
+	{
+		capture_ = g;
+	}
+
 
 private:
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
 		if (nullptr != context_) {
+			context_->get_scratch().release(stream_);
 			AURA_OPENCL_SAFE_CALL(clReleaseCommandQueue(stream_));
 		}
 	}
@@ -186,12 +204,11 @@ private:
 	detail::context * context_;
 	/// stream handle
 	cl_command_queue stream_;
+	/// execution order
+	feed_order order_;
+	/// graph commands are recorded in
+	command_graph * capture_;
 
-
-#ifndef CL_VERSION_1_2
-	friend class mark;
-	friend void insert(feed& f, mark& m);
-#endif // CL_VERSION_1_2
 };
 
 /**
@@ -8,6 +8,8 @@
 #include <boost/aura/backend/opencl/memory.hpp>
 #include <boost/aura/detail/svec.hpp>
 #include <boost/aura/backend/opencl/device.hpp>
+#include <boost/aura/backend/opencl/invoke.hpp>
+#include <boost/aura/backend/opencl/command_graph.hpp>
 #include <boost/aura/bounds.hpp>
 #include <clFFT.h>
 
@@ -22,6 +24,59 @@ namespace opencl
 
 typedef std::size_t fft_size;
 typedef svec<fft_size, 3> fft_embed;
+
+namespace detail
+{
+
+/**
+ * centered transform, fftshift(fft(ifftshift(x))), for even sizes
+ *
+ * fft((-1)^i x)[k] = X[k+N/2], with j = k+N/2 the centered spectrum is
+ * Z[k] = (-1)^j X[j], elements k and j are swapped and multiplied with
+ * the checkerboard in a single pass, each fiber handles one pair
+ */
+inline std::tuple<const char*,const char*> get_fft_shift_kernel()
+{
+	return std::make_tuple("fft_shift_cfloat",
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void fft_shift_cfloat(AURA_GLOBAL cfloat* data,
+			unsigned long n0,
+			unsigned long n1,
+			unsigned long n2,
+			unsigned long count)
+	{
+		AURA_INDEX id = get_mesh_id();
+		if (id >= count) {
+			return;
+		}
+		// pairs per volume, the first half of a volume pairs
+		// with the second half
+		unsigned long half = n0*n1*n2/2;
+		unsigned long base = (id / half) * 2*half;
+		unsigned long r = id % half;
+		unsigned long i0 = r % n0;
+		unsigned long i1 = (r / n0) % n1;
+		unsigned long i2 = r / (n0*n1);
+		unsigned long j0 = (i0 + n0/2) % n0;
+		unsigned long j1 = (i1 + n1/2) % n1;
+		unsigned long j2 = (i2 + n2/2) % n2;
+		unsigned long i = base + r;
+		unsigned long j = base + j0 + n0*(j1 + n1*j2);
+		float si = ((i0+i1+i2) & 1) ? -1. : 1.;
+		float sj = ((j0+j1+j2) & 1) ? -1. : 1.;
+		cfloat x = data[i];
+		cfloat y = data[j];
+		data[i] = make_cfloat(sj*crealf(y), sj*cimagf(y));
+		data[j] = make_cfloat(si*crealf(x), si*cimagf(x));
+	}
+
+		)aura_kernel");
+}
+
+} // detail
 using ::boost::aura::bounds;
 
 /**
@@ -68,8 +123,9 @@ public:
 	                    std::size_t istride = 1, std::size_t idist = 0,
 	                    const fft_embed & oembed = fft_embed(),
 	                    std::size_t ostride = 1, std::size_t odist = 0) :
-		context_(d.get_context()), buffer_(), type_(type),
-		dim_(dim), batch_(batch)
+		context_(d.get_context()), device_(&d), scratch_size_(0),
+		centered_(false), planar_(false), type_(type), dim_(dim),
+		batch_(batch)
 	{
 		initialize(d, f, iembed, istride, idist,
 				oembed, ostride, odist);
@@ -87,9 +143,11 @@ public:
 	                    std::size_t istride = 1, std::size_t idist = 0,
 	                    const fft_embed & oembed = fft_embed(),
 	                    std::size_t ostride = 1, std::size_t odist = 0) :
-		context_(d.get_context()), buffer_(), type_(type),
+		context_(d.get_context()), device_(&d), scratch_size_(0),
+		centered_(false), planar_(false), type_(type),
 		dim_(std::get<0>(dim)),
-		batch_(std::max(1, product(std::get<1>(dim))))
+		batch_(std::max<std::int64_t>(1,
+			product(std::get<1>(dim))))
 	{
 		initialize(d, f, iembed, istride, idist,
 				oembed, ostride, odist);
@@ -102,9 +160,12 @@ public:
 	 * @param f fft to move here
 	 */
 	fft(BOOST_RV_REF(fft) f) :
-		context_(f.context_), inplace_handle_(f.inplace_handle_),
+		context_(f.context_), device_(f.device_),
+		inplace_handle_(f.inplace_handle_),
 		outofplace_handle_(f.outofplace_handle_),
-		buffer_(f.buffer_)
+		scratch_size_(f.scratch_size_), centered_(f.centered_),
+		planar_(f.planar_), type_(f.type_), dim_(f.dim_),
+		batch_(f.batch_)
 	{
 		f.context_ = nullptr;
 	}
@@ -118,10 +179,15 @@ public:
 	{
 		finalize();
 		context_= f.context_;
+		device_ = f.device_;
 		inplace_handle_ = f.inplace_handle_;
 		outofplace_handle_ = f.outofplace_handle_;
 		type_ = f.type_;
-		buffer_ = f.buffer_;
+		dim_ = f.dim_;
+		batch_ = f.batch_;
+		scratch_size_ = f.scratch_size_;
+		centered_ = f.centered_;
+		planar_ = f.planar_;
 		f.context_= nullptr;
 		return *this;
 	}
@@ -147,6 +213,80 @@ public:
 		return type_;
 	}
 
+	/**
+	 * return number of bytes of scratch memory the fft requires,
+	 * the memory is taken from the scratch arena of the feed the
+	 * fft is calculated in
+	 */
+	std::size_t get_scratch_size() const
+	{
+		return scratch_size_;
+	}
+
+	/**
+	 * set scale factor applied to the result of the transform
+	 *
+	 * the scaling is done by clFFT as part of the transform, the
+	 * default is 1 for the forward and 1/N for the inverse transform
+	 *
+	 * @param dir direction the scale factor is used for
+	 * @param scale scale factor
+	 */
+	void set_scale(direction dir, float scale)
+	{
+		// the plans are baked again by the next transform
+		AURA_CLFFT_SAFE_CALL(clfftSetPlanScale(inplace_handle_,
+					(clfftDirection)dir, scale));
+		AURA_CLFFT_SAFE_CALL(clfftSetPlanScale(outofplace_handle_,
+					(clfftDirection)dir, scale));
+	}
+
+	/**
+	 * calculate centered transforms, the origin of both signal and
+	 * spectrum is in the center: fftshift(fft(ifftshift(x)))
+	 *
+	 * supported for c2c with even (or 1) sizes in all dimensions
+	 */
+	void set_centered(bool centered)
+	{
+		assert(!centered || c2c == type_);
+		assert(!centered || !planar_);
+		for (std::size_t i=0; i<dim_.size(); i++) {
+			assert(!centered || 1 == dim_[i] || 0 == dim_[i] % 2);
+		}
+		centered_ = centered;
+	}
+
+	/// true if transforms are centered
+	bool is_centered() const
+	{
+		return centered_;
+	}
+
+	/**
+	 * use planar (split) complex layout, real and imaginary parts
+	 * are stored in separate buffers
+	 *
+	 * supported for c2c and z2z, the plans are baked again in feed f
+	 */
+	void set_planar(bool planar, feed & f)
+	{
+		assert(c2c == type_ || z2z == type_);
+		assert(!(planar && centered_));
+		clfftLayout l = planar ? CLFFT_COMPLEX_PLANAR :
+			CLFFT_COMPLEX_INTERLEAVED;
+		AURA_CLFFT_SAFE_CALL(clfftSetLayout(inplace_handle_, l, l));
+		AURA_CLFFT_SAFE_CALL(clfftSetLayout(outofplace_handle_, l, l));
+		bake(f);
+		planar_ = planar;
+	}
+
+	/// true if the complex layout is planar
+	bool is_planar() const
+	{
+		return planar_;
+	}
+
 	/// map fft type to clfft_type
 	clfft_type map_type(fft::type type)
 	{
@@ -154,10 +294,10 @@ public:
 		case r2c:
 			return clfft_type(CLFFT_SINGLE,
 			                  CLFFT_REAL,
-			                  CLFFT_COMPLEX_INTERLEAVED);
+			                  CLFFT_HERMITIAN_INTERLEAVED);
 		case c2r:
 			return clfft_type(CLFFT_SINGLE,
-			                  CLFFT_COMPLEX_INTERLEAVED,
+			                  CLFFT_HERMITIAN_INTERLEAVED,
 			                  CLFFT_REAL);
 		case c2c:
 			return clfft_type(CLFFT_SINGLE,
@@ -166,10 +306,10 @@ public:
 		case d2z:
 			return clfft_type(CLFFT_DOUBLE,
 			                  CLFFT_REAL,
-			                  CLFFT_COMPLEX_INTERLEAVED);
+			                  CLFFT_HERMITIAN_INTERLEAVED);
 		case z2d:
 			return clfft_type(CLFFT_DOUBLE,
-			                  CLFFT_COMPLEX_INTERLEAVED,
+			                  CLFFT_HERMITIAN_INTERLEAVED,
 			                  CLFFT_REAL);
 		case z2z:
 			return clfft_type(CLFFT_DOUBLE,
@@ -195,6 +335,9 @@ protected:
 	/// context handle
 	detail::context * context_;
 
+	/// device the fft is calculated on
+	device * device_;
+
 private:
 	inline void initialize(device & d, feed & f,
 			const fft_embed& iembed = fft_embed(),
@@ -240,7 +383,22 @@ private:
 		AURA_CLFFT_SAFE_CALL(clfftSetResultLocation(outofplace_handle_,
 		                     CLFFT_OUTOFPLACE));
 
-		// bake plan
+		// real transforms store the packed half spectrum
+		if (is_real()) {
+			set_real_strides(inplace_handle_, true);
+			set_real_strides(outofplace_handle_, false);
+		}
+
+		bake(f);
+
+		} catch (...) {
+			context_ = nullptr;
+		}
+	}
+
+	/// bake plans and query size of temporary buffers
+	void bake(feed & f)
+	{
 		AURA_CLFFT_SAFE_CALL(clfftBakePlan(inplace_handle_, 1,
 					const_cast<cl_command_queue*>(
 						&f.get_backend_stream()),
@@ -250,19 +408,90 @@ private:
 						&f.get_backend_stream()),
 					nullptr, nullptr));
 		wait_for(f);
+		// no private buffer: temporary memory is drawn from the
+		// scratch arena of the feed when the transform is enqueued
 		std::size_t buffer_size1, buffer_size2;
 		AURA_CLFFT_SAFE_CALL(clfftGetTmpBufSize(inplace_handle_,
 					&buffer_size1));
 		AURA_CLFFT_SAFE_CALL(clfftGetTmpBufSize(outofplace_handle_,
 					&buffer_size2));
-		if(0 < buffer_size1 || 0 < buffer_size2) {
-			buffer_ = device_malloc<char>(
-					(buffer_size1 > buffer_size2) ?
-					buffer_size1 : buffer_size2, d);
+		scratch_size_ = (buffer_size1 > buffer_size2) ?
+			buffer_size1 : buffer_size2;
+	}
+
+	/**
+	 * shift result of a centered transform in place
+	 *
+	 * @param transformed completion event of the transform or nullptr,
+	 * in an out-of-order feed the shift waits for it, it is released
+	 */
+	void shift(cl_mem data, const feed & f, cl_event transformed)
+	{
+		if (nullptr != transformed) {
+#ifdef CL_VERSION_1_2
+			AURA_OPENCL_SAFE_CALL(clEnqueueBarrierWithWaitList(
+					f.get_backend_stream(), 1, &transformed,
+					NULL));
+#else
+			AURA_OPENCL_SAFE_CALL(clEnqueueWaitForEvents(
+					f.get_backend_stream(), 1, &transformed));
+#endif // CL_VERSION_1_2
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(transformed));
 		}
+		auto kernel_data = detail::get_fft_shift_kernel();
+		kernel k = device_->load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+		std::size_t n0 = dim_[0];
+		std::size_t n1 = dim_.size() > 1 ? dim_[1] : 1;
+		std::size_t n2 = dim_.size() > 2 ? dim_[2] : 1;
+		std::size_t count = n0*n1*n2/2*batch_;
+		// invoke does not modify the feed, it only enqueues
+		invoke(k, count, args(data, n0, n1, n2, count),
+				const_cast<feed&>(f));
+	}
 
-		} catch (...) {
-			context_ = nullptr;
+	/// true if the fft has real input or output
+	bool is_real() const
+	{
+		return r2c == type_ || c2r == type_ ||
+			d2z == type_ || z2d == type_;
+	}
+
+	/**
+	 * set strides and distances of a real transform
+	 *
+	 * the complex side is packed (fft_hermitian_bounds), the real
+	 * side is padded (fft_padded_bounds) if the transform is in-place
+	 */
+	void set_real_strides(clfftPlanHandle handle, bool inplace)
+	{
+		bounds complex_dim = fft_hermitian_bounds(dim_);
+		bounds real_dim = inplace ? fft_padded_bounds(dim_) : dim_;
+		svec<fft_size, 3> complex_strides;
+		svec<fft_size, 3> real_strides;
+		fft_size cs = 1, rs = 1;
+		for (std::size_t i=0; i<dim_.size(); i++) {
+			complex_strides.push_back(cs);
+			real_strides.push_back(rs);
+			cs *= complex_dim[i];
+			rs *= real_dim[i];
+		}
+		clfftDim d = (clfftDim)(dim_.size());
+		if (r2c == type_ || d2z == type_) {
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanInStride(handle, d,
+						&real_strides[0]));
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanOutStride(handle, d,
+						&complex_strides[0]));
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanDistance(handle,
+						rs, cs));
+		} else {
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanInStride(handle, d,
+						&complex_strides[0]));
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanOutStride(handle, d,
+						&real_strides[0]));
+			AURA_CLFFT_SAFE_CALL(clfftSetPlanDistance(handle,
+						cs, rs));
 		}
 	}
 
@@ -274,9 +503,6 @@ private:
 					clfftDestroyPlan(&inplace_handle_));
 			AURA_CLFFT_SAFE_CALL(
 					clfftDestroyPlan(&outofplace_handle_));
-			if(nullptr != buffer_) {
-				device_free(buffer_);
-			}
 		}
 	}
 
@@ -286,8 +512,14 @@ private:
 	/// out-of-place plan
 	clfftPlanHandle outofplace_handle_;
 
-	/// temporary buffer for transforms
-	device_ptr<char> buffer_;
+	/// size of temporary buffer required for transforms
+	std::size_t scratch_size_;
+
+	/// centered transforms
+	bool centered_;
+
+	/// planar (split) complex layout
+	bool planar_;
 
 	/// fft type
 	type type_;
@@ -304,6 +536,14 @@ private:
 	template <typename T1, typename T2>
 	friend void fft_inverse(device_ptr<T2> src, device_ptr<T1> dst,
 	                        fft & plan, const feed & f);
+	template <typename T>
+	friend void fft_forward(device_ptr<T> src_re, device_ptr<T> src_im,
+	                        device_ptr<T> dst_re, device_ptr<T> dst_im,
+	                        fft & plan, const feed & f);
+	template <typename T>
+	friend void fft_inverse(device_ptr<T> src_re, device_ptr<T> src_im,
+	                        device_ptr<T> dst_re, device_ptr<T> dst_im,
+	                        fft & plan, const feed & f);
 
 };
 
@@ -320,6 +560,60 @@ inline void fft_terminate()
 	clfftTeardown();
 }
 
+/**
+ * @brief number of bytes of scratch memory held for ffts on a device
+ *
+ * the scratch memory is shared by all ffts calculated in the same feed
+ * and is sized to the largest requirement of these ffts
+ *
+ * @param d device
+ */
+inline std::size_t fft_scratch_size(device & d)
+{
+	return d.get_context()->get_scratch().size();
+}
+
+namespace detail
+{
+
+/**
+ * enqueue a transform with temporary memory from the scratch arena
+ *
+ * in an out-of-order feed transforms that share the scratch buffer of
+ * the feed run one after another
+ *
+ * @param out output buffers or NULL for an in-place transform
+ * @return completion event of the transform in an out-of-order feed
+ * (the caller releases it), otherwise nullptr
+ */
+inline cl_event fft_enqueue(clfftPlanHandle plan, clfftDirection dir,
+		cl_mem* in, cl_mem* out, scratch_arena& arena,
+		std::size_t scratch_size, const feed & f)
+{
+	bool ordered = feed_order::out_of_order != f.get_order();
+	cl_event last = nullptr;
+	cl_mem tmp = arena.acquire(f.get_backend_stream(), scratch_size,
+			ordered ? NULL : &last);
+	cl_event done = nullptr;
+	AURA_CLFFT_SAFE_CALL(clfftEnqueueTransform(plan, dir, 1,
+				const_cast<cl_command_queue*>(
+					&f.get_backend_stream()),
+				nullptr == last ? 0 : 1,
+				nullptr == last ? NULL : &last,
+				ordered ? NULL : &done, in, out, tmp));
+	if (nullptr != last) {
+		AURA_OPENCL_SAFE_CALL(clReleaseEvent(last));
+	}
+	if (nullptr != done && nullptr != tmp) {
+		// the next user of the scratch buffer waits for this one
+		AURA_OPENCL_SAFE_CALL(clRetainEvent(done));
+		arena.used(f.get_backend_stream(), done);
+	}
+	return done;
+}
+
+} // detail
+
 /**
  * @brief calculate forward fourier transform
  *
@@ -332,23 +626,30 @@ template <typename T1, typename T2>
 void fft_forward(device_ptr<T2> src, device_ptr<T1> dst,
                  fft & plan, const feed & f)
 {
+	if (nullptr != f.get_capture()) {
+		cl_mem buffers[] = { src.get_base(), dst.get_base() };
+		fft* p = &plan;
+		f.get_capture()->record([=](feed & rf) {
+				fft_forward(src, dst, *p, rf);
+			}, std::vector<cl_mem>(buffers, buffers+2));
+		return;
+	}
 	typename device_ptr<T1>::backend_type dm = dst.get_base();
 	typename device_ptr<T1>::backend_type sm = src.get_base();
-	if(dst == src) {
-		AURA_CLFFT_SAFE_CALL(clfftEnqueueTransform(plan.inplace_handle_,
-					CLFFT_FORWARD, 1,
-					const_cast<cl_command_queue*>(
-						&f.get_backend_stream()),
-					0, NULL, NULL, &sm, NULL,
-					plan.buffer_.get_base()));
-	} else {
-		AURA_CLFFT_SAFE_CALL(clfftEnqueueTransform(
-					plan.outofplace_handle_,
-					CLFFT_FORWARD, 1,
-					const_cast<cl_command_queue*>(
-						&f.get_backend_stream()),
-					0, NULL, NULL, &sm, &dm,
-					plan.buffer_.get_base()));
+	// real transforms have different source and destination types
+	bool inplace = dm == sm && dst.get_offset()*sizeof(T1) ==
+			src.get_offset()*sizeof(T2);
+	// an out-of-order feed does not order the shift after the
+	// transform, the shift waits for the returned event
+	cl_event transformed = detail::fft_enqueue(
+			inplace ? plan.inplace_handle_ :
+				plan.outofplace_handle_,
+			CLFFT_FORWARD, &sm, inplace ? NULL : &dm,
+			plan.context_->get_scratch(), plan.scratch_size_, f);
+	if (plan.centered_) {
+		plan.shift(dm, f, transformed);
+	} else if (nullptr != transformed) {
+		AURA_OPENCL_SAFE_CALL(clReleaseEvent(transformed));
 	}
 }
 
@@ -365,24 +666,120 @@ template <typename T1, typename T2>
 void fft_inverse(device_ptr<T2> src, device_ptr<T1> dst,
                  fft & plan, const feed & f)
 {
+	if (nullptr != f.get_capture()) {
+		cl_mem buffers[] = { src.get_base(), dst.get_base() };
+		fft* p = &plan;
+		f.get_capture()->record([=](feed & rf) {
+				fft_inverse(src, dst, *p, rf);
+			}, std::vector<cl_mem>(buffers, buffers+2));
+		return;
+	}
 	typename device_ptr<T1>::backend_type dm = dst.get_base();
 	typename device_ptr<T1>::backend_type sm = src.get_base();
-	if(dst == src) {
-		AURA_CLFFT_SAFE_CALL(clfftEnqueueTransform(plan.inplace_handle_,
-					CLFFT_BACKWARD, 1,
-					const_cast<cl_command_queue*>(
-						&f.get_backend_stream()),
-					0, NULL, NULL, &sm, NULL,
-					plan.buffer_.get_base()));
-	} else {
-		AURA_CLFFT_SAFE_CALL(clfftEnqueueTransform(
-					plan.outofplace_handle_,
-					CLFFT_BACKWARD, 1,
-					const_cast<cl_command_queue*>(
-						&f.get_backend_stream()),
-					0, NULL, NULL, &sm, &dm,
-					plan.buffer_.get_base()));
+	// real transforms have different source and destination types
+	bool inplace = dm == sm && dst.get_offset()*sizeof(T1) ==
+			src.get_offset()*sizeof(T2);
+	// an out-of-order feed does not order the shift after the
+	// transform, the shift waits for the returned event
+	cl_event transformed = detail::fft_enqueue(
+			inplace ? plan.inplace_handle_ :
+				plan.outofplace_handle_,
+			CLFFT_BACKWARD, &sm, inplace ? NULL : &dm,
+			plan.context_->get_scratch(), plan.scratch_size_, f);
+	if (plan.centered_) {
+		plan.shift(dm, f, transformed);
+	} else if (nullptr != transformed) {
+		AURA_OPENCL_SAFE_CALL(clReleaseEvent(transformed));
+	}
+}
+
+namespace detail
+{
+
+/// enqueue transform of planar (split) complex data
+template <typename T>
+void fft_planar(device_ptr<T> src_re, device_ptr<T> src_im,
+                device_ptr<T> dst_re, device_ptr<T> dst_im,
+                clfftPlanHandle inplace, clfftPlanHandle outofplace,
+                scratch_arena& arena, std::size_t scratch_size,
+                clfftDirection dir, const feed & f)
+{
+	cl_mem sm[2] = { src_re.get_base(), src_im.get_base() };
+	cl_mem dm[2] = { dst_re.get_base(), dst_im.get_base() };
+	bool in = src_re == dst_re && src_im == dst_im;
+	cl_event done = fft_enqueue(in ? inplace : outofplace, dir,
+			sm, in ? NULL : dm, arena, scratch_size, f);
+	if (nullptr != done) {
+		AURA_OPENCL_SAFE_CALL(clReleaseEvent(done));
+	}
+}
+
+} // detail
+
+/**
+ * @brief calculate forward fourier transform of planar complex data
+ *
+ * the plan must use planar layout (fft::set_planar)
+ *
+ * @param src_re real part of input of fourier transform
+ * @param src_im imaginary part of input of fourier transform
+ * @param dst_re real part of result of fourier transform
+ * @param dst_im imaginary part of result of fourier transform
+ * @param plan that is used to calculate the fourier transform
+ * @param f feed the fourier transform should be calculated in
+ */
+template <typename T>
+void fft_forward(device_ptr<T> src_re, device_ptr<T> src_im,
+                 device_ptr<T> dst_re, device_ptr<T> dst_im,
+                 fft & plan, const feed & f)
+{
+	if (nullptr != f.get_capture()) {
+		cl_mem buffers[] = { src_re.get_base(), src_im.get_base(),
+			dst_re.get_base(), dst_im.get_base() };
+		fft* p = &plan;
+		f.get_capture()->record([=](feed & rf) {
+				fft_forward(src_re, src_im, dst_re, dst_im, *p, rf);
+			}, std::vector<cl_mem>(buffers, buffers+4));
+		return;
+	}
+	assert(plan.planar_);
+	detail::fft_planar(src_re, src_im, dst_re, dst_im,
+			plan.inplace_handle_, plan.outofplace_handle_,
+			plan.context_->get_scratch(), plan.scratch_size_,
+			CLFFT_FORWARD, f);
+}
+
+/**
+ * @brief calculate inverse fourier transform of planar complex data
+ *
+ * the plan must use planar layout (fft::set_planar)
+ *
+ * @param src_re real part of input of fourier transform
+ * @param src_im imaginary part of input of fourier transform
+ * @param dst_re real part of result of fourier transform
+ * @param dst_im imaginary part of result of fourier transform
+ * @param plan that is used to calculate the fourier transform
+ * @param f feed the fourier transform should be calculated in
+ */
+template <typename T>
+void fft_inverse(device_ptr<T> src_re, device_ptr<T> src_im,
+                 device_ptr<T> dst_re, device_ptr<T> dst_im,
+                 fft & plan, const feed & f)
+{
+	if (nullptr != f.get_capture()) {
+		cl_mem buffers[] = { src_re.get_base(), src_im.get_base(),
+			dst_re.get_base(), dst_im.get_base() };
+		fft* p = &plan;
+		f.get_capture()->record([=](feed & rf) {
+				fft_inverse(src_re, src_im, dst_re, dst_im, *p, rf);
+			}, std::vector<cl_mem>(buffers, buffers+4));
+		return;
 	}
+	assert(plan.planar_);
+	detail::fft_planar(src_re, src_im, dst_re, dst_im,
+			plan.inplace_handle_, plan.outofplace_handle_,
+			plan.context_->get_scratch(), plan.scratch_size_,
+			CLFFT_BACKWARD, f);
 }
 
 } // opencl
@@ -2,7 +2,9 @@
 #define AURA_BACKEND_OPENCL_INVOKE_HPP
 
 #include <assert.h>
+#include <array>
 #include <cstddef>
+#include <algorithm>
 #ifdef __APPLE__
 	#include "OpenCL/opencl.h"
 #else
@@ -12,9 +14,12 @@
 #include <boost/aura/detail/svec.hpp>
 #include <boost/aura/backend/opencl/call.hpp>
 #include <boost/aura/backend/opencl/feed.hpp>
+#include <boost/aura/backend/opencl/mark.hpp>
+#include <boost/aura/backend/opencl/command_graph.hpp>
 #include <boost/aura/backend/opencl/mesh.hpp>
 #include <boost/aura/backend/opencl/bundle.hpp>
 #include <boost/aura/backend/opencl/args.hpp>
+#include <boost/aura/backend/shared/bounds_fit.hpp>
 #include <boost/aura/backend/shared/calc_mesh_bundle.hpp>
 
 namespace boost
@@ -25,19 +30,63 @@ namespace opencl {
 
 namespace detail {
 
+/**
+ * launch geometry (bundle size and 3 mesh sizes) for v elements, the
+ * bundle size honors the work group size of the kernel, geometries are
+ * cached per device
+ */
+inline std::array<std::size_t, 4> launch_geometry(kernel& k,
+		std::size_t v, feed& f, bounds_fit fit)
+{
+	return f.get_context()->get_launch_cache().get(k, v,
+			bounds_fit::padded == fit, [&]() {
+		std::size_t size = 0;
+		AURA_OPENCL_SAFE_CALL(clGetKernelWorkGroupInfo(k,
+				f.get_backend_device(),
+				CL_KERNEL_WORK_GROUP_SIZE,
+				sizeof(size), &size, NULL));
+		std::size_t multiple = 1;
+		AURA_OPENCL_SAFE_CALL(clGetKernelWorkGroupInfo(k,
+				f.get_backend_device(),
+				CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE,
+				sizeof(multiple), &multiple, NULL));
+		std::array<std::size_t, 4> max_mb = {{
+			std::min<std::size_t>(AURA_OPENCL_MAX_BUNDLE, size),
+			AURA_OPENCL_MAX_MESH0,
+			AURA_OPENCL_MAX_MESH1,
+			AURA_OPENCL_MAX_MESH2
+		}};
+		// a tuned bundle size limits the bundle size
+		std::size_t tuned = f.get_context()->get_launch_cache().
+			get_bundle(k, boost::aura::detail::get_size_class(v));
+		if (0 != tuned && tuned < max_mb[0]) {
+			max_mb[0] = tuned;
+		}
+
+		// OpenCL has a different behaviour here
+		const std::array<bool, 4> mask = {{false, true, false, false}};
+
+		return boost::aura::detail::calc_launch_geometry(v, max_mb,
+				mask, multiple, fit);
+	});
+}
+
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke_impl(kernel& k, const mesh& m, const bundle& b,
-		const args_t<N>&& a, feed & f)
+		const args_t<Targs...>&& a, feed & f,
+		const wait_list& w = wait_list(), cl_event* event = NULL)
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 inline void invoke_impl(kernel& k, const mesh& m, const bundle& b,
-	const args_t& a, feed& f)
+	const args_t& a, feed& f,
+	const wait_list& w = wait_list(), cl_event* event = NULL)
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 {
 	// set parameters
-	for (std::size_t i=0; i<a.second.size(); i++) {
+	const auto& pa = get_args(a);
+	for (std::size_t i=0; i<pa.size(); i++) {
 		AURA_OPENCL_SAFE_CALL(clSetKernelArg(k, i,
-					a.second[i].second, a.second[i].first));
+					pa[i].second, pa[i].first));
 	}
 	// handling for non 3-dimensional mesh and bundle sizes
 	mesh tm;
@@ -63,39 +112,43 @@ inline void invoke_impl(kernel& k, const mesh& m, const bundle& b,
 		tb[2] = b[2];
 	}
 
+	if (nullptr != f.get_capture()) {
+		f.get_capture()->record_kernel(k, &tm[0], &tb[0], pa,
+				get_buffers(a));
+		release_args(a);
+		if (NULL != event) {
+			*event = NULL;
+		}
+		return;
+	}
+
 	// call kernel
 	AURA_OPENCL_SAFE_CALL(clEnqueueNDRangeKernel(
 		f.get_backend_stream(), k, tm.size(), NULL,
-		&tm[0], &tb[0], 0, NULL, NULL));
-	free(a.first);
+		&tm[0], &tb[0], w.size(), w.get_backend_events(), event));
+	release_args(a);
 }
 
 #ifndef BOOST_NO_CXX11_VARIADIC_TEMPLATES
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke_impl(kernel & k, const ::boost::aura::bounds& b,
-		const args_t<N>&& a, feed & f)
+		const args_t<Targs...>&& a, feed & f,
+		const wait_list& w = wait_list(), cl_event* event = NULL,
+		bounds_fit fit = bounds_fit::exact)
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
-inline void invoke_impl(kernel & k, const bounds& b, const args_t & a, feed & f)
+inline void invoke_impl(kernel & k, const bounds& b, const args_t & a, feed & f,
+	const wait_list& w = wait_list(), cl_event* event = NULL,
+	bounds_fit fit = bounds_fit::exact)
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 {
 	// set parameters
-	for (std::size_t i=0; i<a.second.size(); i++) {
+	const auto& pa = get_args(a);
+	for (std::size_t i=0; i<pa.size(); i++) {
 		AURA_OPENCL_SAFE_CALL(clSetKernelArg(k, i,
-					a.second[i].second, a.second[i].first));
+					pa[i].second, pa[i].first));
 	}
-	std::array<std::size_t, 4> mb = {{1, 1, 1, 1}};
-	const std::array<std::size_t, 4> max_mb = {{
-		AURA_OPENCL_MAX_BUNDLE,
-		AURA_OPENCL_MAX_MESH0,
-		AURA_OPENCL_MAX_MESH1,
-		AURA_OPENCL_MAX_MESH2
-	}};
-
-	// OpenCL has a different behaviour here
-	std::array<bool, 4> mask = {{false, true, false, false}};
-
-	boost::aura::detail::calc_mesh_bundle(product(b), 2,
-			mb.begin(), max_mb.begin(), mask.begin());
+	const std::array<std::size_t, 4> mb =
+		launch_geometry(k, product(b), f, fit);
 
 	mesh tm;
 	tm.push_back(mb[1]);
@@ -106,11 +159,21 @@ inline void invoke_impl(kernel & k, const bounds& b, const args_t & a, feed & f)
 	tb.push_back(1);
 	tb.push_back(1);
 
+	if (nullptr != f.get_capture()) {
+		f.get_capture()->record_kernel(k, &tm[0], &tb[0], pa,
+				get_buffers(a));
+		release_args(a);
+		if (NULL != event) {
+			*event = NULL;
+		}
+		return;
+	}
+
 	// call kernel
 	AURA_OPENCL_SAFE_CALL(clEnqueueNDRangeKernel(
 		f.get_backend_stream(), k, tm.size(), NULL,
-		&tm[0], &tb[0], 0, NULL, NULL));
-	free(a.first);
+		&tm[0], &tb[0], w.size(), w.get_backend_events(), event));
+	release_args(a);
 }
 
 } // namespace detail
@@ -121,29 +184,75 @@ inline void invoke_impl(kernel & k, const bounds& b, const args_t & a, feed & f)
 /// invoke kernel without args
 inline void invoke(kernel& k, const mesh& m, const bundle& b, feed& f)
 {
-	detail::invoke_impl(k, m, b, args_t<0>(), f);
+	detail::invoke_impl(k, m, b, args_t<>(), f);
 }
 
 /// invoke kernel with args
-template<unsigned long N>
+template<typename... Targs>
 inline void invoke(kernel& k, const mesh& m, const bundle& b,
-		const args_t<N>&& a, feed& f)
+		const args_t<Targs...>&& a, feed& f)
 {
 	detail::invoke_impl(k, m, b, std::move(a), f);
 }
 
-/// invoke kernel with bounds and args
-template<unsigned long N>
-inline void invoke(kernel& k, const bounds& b, const args_t<N>&& a, feed& f)
+/**
+ * invoke kernel with bounds and args
+ *
+ * the bundle size is limited by the tuned bundle size of the kernel, the
+ * tuning database is not read here, apply_tuning or autotune_invoke must
+ * be called once after the kernel is loaded
+ *
+ * @param fit bounds_fit::padded allows a mesh larger than the bounds
+ */
+template<typename... Targs>
+inline void invoke(kernel& k, const bounds& b, const args_t<Targs...>&& a,
+		feed& f, bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, b, std::move(a), f);
+	detail::invoke_impl(k, b, std::move(a), f, wait_list(), NULL, fit);
 }
 
 /// invoke kernel with size and args
-template<unsigned long N>
-inline void invoke(kernel& k, const std::size_t s, const args_t<N>&& a, feed& f)
+template<typename... Targs>
+inline void invoke(kernel& k, const std::size_t s,
+		const args_t<Targs...>&& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, bounds(s), std::move(a), f);
+	detail::invoke_impl(k, bounds(s), std::move(a), f,
+			wait_list(), NULL, fit);
+}
+
+/**
+ * invoke kernel with bounds and args after the marks of a wait list
+ *
+ * @return mark that is reached when the kernel has finished
+ */
+template<typename... Targs>
+inline mark invoke(kernel& k, const bounds& b, const args_t<Targs...>&& a,
+		feed& f, const wait_list& w, bounds_fit fit = bounds_fit::exact)
+{
+	cl_event e;
+	detail::invoke_impl(k, b, std::move(a), f, w, &e, fit);
+	return NULL == e ? mark() : mark(e);
+}
+
+/// invoke kernel with size and args after the marks of a wait list
+template<typename... Targs>
+inline mark invoke(kernel& k, const std::size_t s, const args_t<Targs...>&& a,
+		feed& f, const wait_list& w, bounds_fit fit = bounds_fit::exact)
+{
+	cl_event e;
+	detail::invoke_impl(k, bounds(s), std::move(a), f, w, &e, fit);
+	return NULL == e ? mark() : mark(e);
+}
+
+/// invoke kernel with mesh, bundle and args after the marks of a wait list
+template<typename... Targs>
+inline mark invoke(kernel& k, const mesh& m, const bundle& b,
+		const args_t<Targs...>&& a, feed& f, const wait_list& w)
+{
+	cl_event e;
+	detail::invoke_impl(k, m, b, std::move(a), f, w, &e);
+	return NULL == e ? mark() : mark(e);
 }
 
 #else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -162,15 +271,35 @@ inline void invoke(kernel & k, const mesh & m, const bundle & b,
 }
 
 /// invoke kernel with bounds and args
-inline void invoke(kernel& k, const bounds& b, const args_t& a, feed& f)
+inline void invoke(kernel& k, const bounds& b, const args_t& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, b, a, f);
+	detail::invoke_impl(k, b, a, f, wait_list(), NULL, fit);
 }
 
 /// invoke kernel wiht size and args
-inline void invoke(kernel& k, const std::size_t s, const args_t& a, feed& f)
+inline void invoke(kernel& k, const std::size_t s, const args_t& a, feed& f,
+		bounds_fit fit = bounds_fit::exact)
+{
+	detail::invoke_impl(k, bounds(s), a, f, wait_list(), NULL, fit);
+}
+
+/// invoke kernel with bounds and args after the marks of a wait list
+inline mark invoke(kernel& k, const bounds& b, const args_t& a, feed& f,
+		const wait_list& w, bounds_fit fit = bounds_fit::exact)
+{
+	cl_event e;
+	detail::invoke_impl(k, b, a, f, w, &e, fit);
+	return NULL == e ? mark() : mark(e);
+}
+
+/// invoke kernel with size and args after the marks of a wait list
+inline mark invoke(kernel& k, const std::size_t s, const args_t& a, feed& f,
+		const wait_list& w, bounds_fit fit = bounds_fit::exact)
 {
-	detail::invoke_impl(k, bounds(s), a, f);
+	cl_event e;
+	detail::invoke_impl(k, bounds(s), a, f, w, &e, fit);
+	return NULL == e ? mark() : mark(e);
 }
 
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
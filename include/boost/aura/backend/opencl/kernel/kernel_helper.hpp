@@ -1,18 +1,25 @@
 #ifndef AURA_BACKEND_OPENCL_KERNEL_HELPER_HPP
 #define AURA_BACKEND_OPENCL_KERNEL_HELPER_HPP
 
-inline unsigned int get_mesh_id() 
+// element index type, 64 bit unless AURA_INDEX_32 is 1 (see config.hpp)
+#if AURA_INDEX_32
+	#define AURA_INDEX unsigned int
+#else
+	#define AURA_INDEX unsigned long
+#endif
+
+inline AURA_INDEX get_mesh_id() 
 {
 	return get_global_size(1)*get_global_size(0)*get_global_id(2) +
 		get_global_size(0)*get_global_id(1) + get_global_id(0);
 }
 
-inline unsigned int get_id_in_mesh() 
+inline AURA_INDEX get_id_in_mesh() 
 {
 	return get_mesh_id();
 }
 
-inline unsigned int get_mesh_size() 
+inline AURA_INDEX get_mesh_size() 
 {
 	return get_global_size(0)*get_global_size(1)*get_global_size(2);
 }
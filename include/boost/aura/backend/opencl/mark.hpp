@@ -6,6 +6,7 @@
 #else
 	#include "CL/cl.h"
 #endif
+#include <vector>
 #include <boost/move/move.hpp>
 #include <boost/aura/backend/opencl/call.hpp>
 #include <boost/aura/backend/opencl/device.hpp>
@@ -36,14 +37,6 @@ cl_event get_event(mark& m);
 } // namespace detail
 
 
-/// callback used to free event asynchronously
-inline void CL_CALLBACK delete_event_callback__(cl_event event,
-		cl_int event_command_exec_status, void* event_ptr)
-{
-	AURA_OPENCL_SAFE_CALL(clReleaseEvent(event));
-	delete (cl_event*)event_ptr;
-}
-
 /**
  * mark class
  */
@@ -66,20 +59,19 @@ public:
 	 *
 	 * @param f feed to create mark in
 	 */
-	inline explicit mark(feed & f) : event_(new cl_event)
+	inline explicit mark(feed & f) : event_(nullptr)
+	{
+		enqueue(f);
+	}
+
+	/**
+	 * create mark from an event returned by an enqueue call, the mark
+	 * takes ownership of the event
+	 *
+	 * @param e event
+	 */
+	inline explicit mark(cl_event e) : event_(e)
 	{
-		// clEnqueueMarkerWithWaitList only exists from OpenCL 1.2
-		// we assume here that CL_VERSION_1_2 is defined for 2.0 too
-#ifdef CL_VERSION_1_2
-		AURA_OPENCL_SAFE_CALL(
-			clEnqueueMarkerWithWaitList(
-				detail::get_backend_stream(f),
-				0, NULL, event_
-			)
-		);
-#else
-		f.insert_event(event_);
-#endif // CL_VERSION_1_2
 	}
 
 	/**
@@ -117,72 +109,108 @@ public:
 	 * get raw event
 	 */
 	cl_event get_event() {
-		return *event_;
+		return event_;
+	}
+
+	/// true if the mark has no event
+	bool empty() const {
+		return nullptr == event_;
 	}
 
 private:
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
+		// the runtime keeps the event alive until the command finished
 		if(nullptr != event_) {
-			// check if completed
-			cl_int result;
-			AURA_OPENCL_SAFE_CALL(
-				clGetEventInfo(
-					*event_,
-					CL_EVENT_COMMAND_EXECUTION_STATUS,
-					sizeof(result),
-					&result,
-					NULL
-				)
-			);
-			if(CL_COMPLETE == result) {
-				clReleaseEvent(*event_);
-				delete event_;
-			} else {
-				// enqueue callback
-				AURA_OPENCL_SAFE_CALL(
-					clSetEventCallback(
-						*event_,
-						CL_COMPLETE,
-						&delete_event_callback__,
-						event_
-					)
-				);
-			}
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(event_));
+			event_ = nullptr;
 		}
 	}
 
-	/// pointer to event
-	cl_event * event_;
+	/// enqueue a marker that is reached when all commands before it are
+	void enqueue(feed & f)
+	{
+		// clEnqueueMarkerWithWaitList only exists from OpenCL 1.2
+		// we assume here that CL_VERSION_1_2 is defined for 2.0 too
+#ifdef CL_VERSION_1_2
+		AURA_OPENCL_SAFE_CALL(
+			clEnqueueMarkerWithWaitList(
+				detail::get_backend_stream(f),
+				0, NULL, &event_
+			)
+		);
+#else
+		AURA_OPENCL_SAFE_CALL(
+			clEnqueueMarker(detail::get_backend_stream(f), &event_)
+		);
+#endif // CL_VERSION_1_2
+	}
+
+	/// event, held by value, marks do not allocate
+	cl_event event_;
 
 friend void insert(feed & f, mark & m);
 friend void wait_for(mark & m);
 
 };
 
+/**
+ * wait_list class
+ *
+ * marks a command waits for before it starts, the list does not own
+ * the marks, they must live until the command is enqueued
+ */
+class wait_list
+{
+
+public:
+	/// create empty wait list
+	inline explicit wait_list() {}
+
+	/// create wait list with a single mark
+	inline explicit wait_list(mark & m)
+	{
+		add(m);
+	}
+
+	/// add a mark, empty marks are ignored
+	inline wait_list & add(mark & m)
+	{
+		if (!m.empty()) {
+			events_.push_back(m.get_event());
+		}
+		return *this;
+	}
+
+	/// number of marks
+	inline std::size_t size() const
+	{
+		return events_.size();
+	}
+
+	/// access raw events, NULL if the list is empty
+	inline const cl_event * get_backend_events() const
+	{
+		return events_.empty() ? NULL : &events_[0];
+	}
+
+private:
+	/// events
+	std::vector<cl_event> events_;
+};
+
 /// insert marker into feed
 inline void insert(feed & f, mark & m)
 {
 	m.finalize();
-	m.event_ = new cl_event;
-
-#ifdef CL_VERSION_1_2
-	AURA_OPENCL_SAFE_CALL(
-		clEnqueueMarkerWithWaitList(
-			detail::get_backend_stream(f),
-			0, NULL, m.event_
-		)
-	);
-#else
-		f.insert_event(m.event_);
-#endif // CL_VERSION_1_2
+	m.enqueue(f);
 }
 
 
 inline void wait_for(mark & m)
 {
-	AURA_OPENCL_SAFE_CALL(clWaitForEvents(1, m.event_));
+	AURA_OPENCL_SAFE_CALL(clWaitForEvents(1, &m.event_));
 }
 
 } // opencl
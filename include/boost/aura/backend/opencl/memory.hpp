@@ -6,8 +6,12 @@
 #else
 	#include "CL/cl.h"
 #endif
+#include <vector>
+#include <cstring>
 #include <boost/aura/backend/opencl/call.hpp>
 #include <boost/aura/backend/opencl/feed.hpp>
+#include <boost/aura/backend/opencl/mark.hpp>
+#include <boost/aura/backend/opencl/command_graph.hpp>
 #include <boost/aura/backend/opencl/device.hpp>
 #include <boost/aura/backend/opencl/device_ptr.hpp>
 #include <boost/aura/backend/shared/memory_tag.hpp>
@@ -74,6 +78,24 @@ device_ptr<T> device_malloc(std::size_t size, device & d) {
   return device_ptr<T>(m, d);
 }
 
+/**
+ * allocate device memory the host can map without copying, for devices
+ * that share memory with the host (CPU and integrated devices)
+ *
+ * @param size number of T's
+ * @param d device the memory is allocated on
+ */
+template <typename T>
+device_ptr<T> device_malloc_unified(std::size_t size, device & d) {
+  int errorcode = 0;
+  typename device_ptr<T>::backend_type m =
+    clCreateBuffer(d.get_backend_context(),
+    CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, size*sizeof(T), 0,
+    &errorcode);
+  AURA_OPENCL_CHECK_ERROR(errorcode);
+  return device_ptr<T>(m, d);
+}
+
 template <typename T>
 device_ptr<T> device_malloc_dependent(device_ptr<T> ptr,
 		std::size_t size, std::size_t offset) {
@@ -220,6 +242,11 @@ DEPRECATED(void copy(memory dst, const void * src, std::size_t size,
 template <typename T>
 void copy(device_ptr<T> dst, const T * src, std::size_t size,
   feed & f) {
+  if (nullptr != f.get_capture()) {
+    f.get_capture()->record([=](feed & rf) { copy(dst, src, size, rf); },
+      std::vector<cl_mem>(1, dst.get_base()));
+    return;
+  }
   AURA_OPENCL_SAFE_CALL(clEnqueueWriteBuffer(f.get_backend_stream(),
   	dst.get_base(), CL_FALSE, dst.get_offset()*sizeof(T), size*sizeof(T),
     src, 0, NULL, NULL));
@@ -253,11 +280,70 @@ DEPRECATED(inline void copy(void * dst, memory src, std::size_t size,
  */
 template <typename T>
 void copy(T * dst, const device_ptr<T> src, std::size_t size, feed & f) {
+  if (nullptr != f.get_capture()) {
+    f.get_capture()->record([=](feed & rf) { copy(dst, src, size, rf); },
+      std::vector<cl_mem>(1, src.get_base()));
+    return;
+  }
   AURA_OPENCL_SAFE_CALL(clEnqueueReadBuffer(f.get_backend_stream(),
   	src.get_base(), CL_FALSE, src.get_offset()*sizeof(T), size*sizeof(T),
     dst, 0, NULL, NULL));
 }
 
+/**
+ * copy rows of host memory to device memory in one transfer
+ *
+ * @param dst device memory (destination), the rows are stored densely
+ * @param src host memory (source), first row
+ * @param width number of T per row
+ * @param rows number of rows
+ * @param pitch distance between the rows in host memory in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_rows(device_ptr<T> dst, const T * src, std::size_t width,
+  std::size_t rows, std::size_t pitch, feed & f) {
+  if (nullptr != f.get_capture()) {
+    f.get_capture()->record([=](feed & rf) {
+        copy_rows(dst, src, width, rows, pitch, rf);
+      }, std::vector<cl_mem>(1, dst.get_base()));
+    return;
+  }
+  const std::size_t dst_origin[3] = { dst.get_offset()*sizeof(T), 0, 0 };
+  const std::size_t src_origin[3] = { 0, 0, 0 };
+  const std::size_t region[3] = { width*sizeof(T), rows, 1 };
+  AURA_OPENCL_SAFE_CALL(clEnqueueWriteBufferRect(f.get_backend_stream(),
+    dst.get_base(), CL_FALSE, dst_origin, src_origin, region,
+    width*sizeof(T), 0, pitch*sizeof(T), 0, src, 0, NULL, NULL));
+}
+
+/**
+ * copy device memory to rows of host memory in one transfer
+ *
+ * @param dst host memory (destination), first row
+ * @param src device memory (source), the rows are stored densely
+ * @param width number of T per row
+ * @param rows number of rows
+ * @param pitch distance between the rows in host memory in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_rows(T * dst, const device_ptr<T> src, std::size_t width,
+  std::size_t rows, std::size_t pitch, feed & f) {
+  if (nullptr != f.get_capture()) {
+    f.get_capture()->record([=](feed & rf) {
+        copy_rows(dst, src, width, rows, pitch, rf);
+      }, std::vector<cl_mem>(1, src.get_base()));
+    return;
+  }
+  const std::size_t src_origin[3] = { src.get_offset()*sizeof(T), 0, 0 };
+  const std::size_t dst_origin[3] = { 0, 0, 0 };
+  const std::size_t region[3] = { width*sizeof(T), rows, 1 };
+  AURA_OPENCL_SAFE_CALL(clEnqueueReadBufferRect(f.get_backend_stream(),
+    src.get_base(), CL_FALSE, src_origin, dst_origin, region,
+    width*sizeof(T), 0, pitch*sizeof(T), 0, dst, 0, NULL, NULL));
+}
+
 /**
  * copy device to device memory
  *
@@ -287,12 +373,178 @@ DEPRECATED(void copy(memory dst, memory src, std::size_t size,
 template <typename T>
 inline void copy(device_ptr<T> dst, const device_ptr<T> src,
   std::size_t size, feed & f) {
+  if (nullptr != f.get_capture()) {
+    cl_mem buffers[] = { dst.get_base(), src.get_base() };
+    f.get_capture()->record([=](feed & rf) { copy(dst, src, size, rf); },
+      std::vector<cl_mem>(buffers, buffers+2));
+    return;
+  }
   AURA_OPENCL_SAFE_CALL(clEnqueueCopyBuffer(f.get_backend_stream(),
     src.get_base(), dst.get_base(), src.get_offset()*sizeof(T),
     dst.get_offset()*sizeof(T), size*sizeof(T),
     0, 0, 0));
 }
 
+/**
+ * copy host to device memory allocated with device_malloc_unified
+ *
+ * the memory is mapped and written by the host, nothing is copied if src
+ * is the mapped memory, the copy has finished when the function returns,
+ * captured and out-of-order feeds copy as usual
+ *
+ * @param dst device memory (destination)
+ * @param src host memory (source)
+ * @param size size of copy in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_unified(device_ptr<T> dst, const T * src, std::size_t size,
+  feed & f) {
+  if (nullptr != f.get_capture() ||
+    feed_order::in_order != f.get_order()) {
+    copy(dst, src, size, f);
+    return;
+  }
+  if (0 == size) {
+    return;
+  }
+#ifdef CL_VERSION_1_2
+  cl_map_flags flags = CL_MAP_WRITE_INVALIDATE_REGION;
+#else
+  cl_map_flags flags = CL_MAP_WRITE;
+#endif // CL_VERSION_1_2
+  int errorcode = 0;
+  void* p = clEnqueueMapBuffer(f.get_backend_stream(), dst.get_base(),
+    CL_TRUE, flags, dst.get_offset()*sizeof(T), size*sizeof(T),
+    0, NULL, NULL, &errorcode);
+  AURA_OPENCL_CHECK_ERROR(errorcode);
+  if (p != (const void*)src) {
+    std::memcpy(p, src, size*sizeof(T));
+  }
+  AURA_OPENCL_SAFE_CALL(clEnqueueUnmapMemObject(f.get_backend_stream(),
+    dst.get_base(), p, 0, NULL, NULL));
+}
+
+/**
+ * copy device memory allocated with device_malloc_unified to host memory
+ *
+ * the memory is mapped and read by the host, the copy has finished when
+ * the function returns, captured and out-of-order feeds copy as usual
+ *
+ * @param dst host memory (destination)
+ * @param src device memory (source)
+ * @param size size of copy in number of T
+ * @param f feed the transfer is executed in
+ */
+template <typename T>
+void copy_unified(T * dst, const device_ptr<T> src, std::size_t size,
+  feed & f) {
+  if (nullptr != f.get_capture() ||
+    feed_order::in_order != f.get_order()) {
+    copy(dst, src, size, f);
+    return;
+  }
+  if (0 == size) {
+    return;
+  }
+  int errorcode = 0;
+  void* p = clEnqueueMapBuffer(f.get_backend_stream(), src.get_base(),
+    CL_TRUE, CL_MAP_READ, src.get_offset()*sizeof(T), size*sizeof(T),
+    0, NULL, NULL, &errorcode);
+  AURA_OPENCL_CHECK_ERROR(errorcode);
+  if (p != (void*)dst) {
+    std::memcpy(dst, p, size*sizeof(T));
+  }
+  AURA_OPENCL_SAFE_CALL(clEnqueueUnmapMemObject(f.get_backend_stream(),
+    src.get_base(), p, 0, NULL, NULL));
+}
+
+/**
+ * copy host to device memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+mark copy(device_ptr<T> dst, const T * src, std::size_t size,
+  feed & f, const wait_list & w) {
+  if (nullptr != f.get_capture()) {
+    // the graph derives dependencies itself
+    copy(dst, src, size, f);
+    return mark();
+  }
+  cl_event e;
+  AURA_OPENCL_SAFE_CALL(clEnqueueWriteBuffer(f.get_backend_stream(),
+  	dst.get_base(), CL_FALSE, dst.get_offset()*sizeof(T), size*sizeof(T),
+    src, w.size(), w.get_backend_events(), &e));
+  return mark(e);
+}
+
+/**
+ * copy device to host memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+mark copy(T * dst, const device_ptr<T> src, std::size_t size, feed & f,
+  const wait_list & w) {
+  if (nullptr != f.get_capture()) {
+    // the graph derives dependencies itself
+    copy(dst, src, size, f);
+    return mark();
+  }
+  cl_event e;
+  AURA_OPENCL_SAFE_CALL(clEnqueueReadBuffer(f.get_backend_stream(),
+  	src.get_base(), CL_FALSE, src.get_offset()*sizeof(T), size*sizeof(T),
+    dst, w.size(), w.get_backend_events(), &e));
+  return mark(e);
+}
+
+/**
+ * copy device to device memory after the marks of a wait list
+ *
+ * @return mark that is reached when the copy has finished
+ */
+template <typename T>
+inline mark copy(device_ptr<T> dst, const device_ptr<T> src,
+  std::size_t size, feed & f, const wait_list & w) {
+  if (nullptr != f.get_capture()) {
+    // the graph derives dependencies itself
+    copy(dst, src, size, f);
+    return mark();
+  }
+  cl_event e;
+  AURA_OPENCL_SAFE_CALL(clEnqueueCopyBuffer(f.get_backend_stream(),
+    src.get_base(), dst.get_base(), src.get_offset()*sizeof(T),
+    dst.get_offset()*sizeof(T), size*sizeof(T),
+    w.size(), w.get_backend_events(), &e));
+  return mark(e);
+}
+
+/**
+ * zero device memory from the device of a feed
+ *
+ * CPU runtimes allocate buffer pages when they are first written, if the
+ * feed belongs to a NUMA sub-device the pages end up on its node
+ *
+ * @param dst device memory
+ * @param size number of Ts
+ * @param f feed the fill is executed in
+ */
+template <typename T>
+inline void first_touch(device_ptr<T> dst, std::size_t size, feed & f) {
+#ifdef CL_VERSION_1_2
+  const cl_uchar zero = 0;
+  AURA_OPENCL_SAFE_CALL(clEnqueueFillBuffer(f.get_backend_stream(),
+    dst.get_base(), &zero, sizeof(zero), dst.get_offset()*sizeof(T),
+    size*sizeof(T), 0, 0, 0));
+#else
+  std::vector<T> zero(size, T());
+  AURA_OPENCL_SAFE_CALL(clEnqueueWriteBuffer(f.get_backend_stream(),
+    dst.get_base(), CL_TRUE, dst.get_offset()*sizeof(T), size*sizeof(T),
+    &zero[0], 0, NULL, NULL));
+#endif // CL_VERSION_1_2
+}
+
 
 /**
  * Allocate memory on host for optimized host to device transfer
@@ -1,10 +1,15 @@
 #ifndef AURA_BACKEND_OPENCL_MODULE_HPP
 #define AURA_BACKEND_OPENCL_MODULE_HPP
 
+#include <map>
+#include <thread>
+#include <unordered_map>
 #include <fstream>
 #include <string>
 #include <cstring>
+#include <vector>
 #include <boost/move/move.hpp>
+#include <boost/aura/backend/opencl/detail/kernel_binaries.hpp>
 
 namespace boost {
 namespace aura {
@@ -15,6 +20,7 @@ class module;
 class device;
 const cl_context & get_backend_context(const device & d);
 const cl_device_id & get_backend_device(const device & d);
+std::string device_get_key(const device & d);
 typedef cl_kernel kernel;
 
 module create_module_from_file(const char * filename, device & d,
@@ -33,10 +39,23 @@ private:
 public:
 	inline explicit module() : device_(nullptr), program_(nullptr) {}
 
+	/**
+	 * build module from source, if a binary of the source was compiled
+	 * ahead of time for the device (see detail::kernel_binaries) the
+	 * binary is loaded instead
+	 */
 	inline explicit module(const char * str, device & d,
 			 const char * build_options=NULL)
 			: device_(&d)
 	{
+		const detail::kernel_binary* b =
+			detail::get_kernel_binaries().find(
+				device_get_key(*device_),
+				get_backend_device(*device_), str,
+				build_options);
+		if (nullptr != b && load_binary(*b, build_options)) {
+			return;
+		}
 		int errorcode = 0;
 		std::size_t len = strlen(str);
 		program_ = clCreateProgramWithSource(get_backend_context(*device_), 1,
@@ -89,15 +108,33 @@ public:
 	}
 
 
+	/**
+	 * get the kernel of the calling host thread
+	 *
+	 * setting the arguments of a kernel is not thread safe, every host
+	 * thread gets its own kernel object, the first one is created from
+	 * the program, the others are cloned from it (OpenCL 2.1) or also
+	 * created, calls must be serialized
+	 */
 	inline kernel & get_kernel(const char * kernel_name)
 	{
-		auto it = kernels_.find(kernel_name);
-		if (kernels_.end() == it) {
+		auto& ks = kernels_[kernel_name];
+		auto it = ks.find(std::this_thread::get_id());
+		if (ks.end() == it) {
 			int errorcode = 0;
-			kernel k = clCreateKernel(program_, kernel_name, &errorcode);
-			AURA_OPENCL_CHECK_ERROR(errorcode);
-			auto it2 = kernels_.insert(
-				std::make_pair(kernel_name, k));
+			kernel k = nullptr;
+#ifdef CL_VERSION_2_1
+			if (!ks.empty()) {
+				k = clCloneKernel(ks.begin()->second, &errorcode);
+			}
+#endif
+			if (nullptr == k || CL_SUCCESS != errorcode) {
+				k = clCreateKernel(program_, kernel_name,
+						&errorcode);
+				AURA_OPENCL_CHECK_ERROR(errorcode);
+			}
+			auto it2 = ks.insert(std::make_pair(
+					std::this_thread::get_id(), k));
 			it = it2.first;
 		}
 		return it->second;
@@ -106,6 +143,23 @@ public:
 
 
 
+	/// program binary for the device, empty if there is none
+	std::vector<unsigned char> get_binary() const
+	{
+		std::size_t size = 0;
+		AURA_OPENCL_SAFE_CALL(clGetProgramInfo(program_,
+					CL_PROGRAM_BINARY_SIZES, sizeof(size),
+					&size, NULL));
+		std::vector<unsigned char> binary(size);
+		if (0 < size) {
+			unsigned char* ptr = &binary[0];
+			AURA_OPENCL_SAFE_CALL(clGetProgramInfo(program_,
+						CL_PROGRAM_BINARIES,
+						sizeof(ptr), &ptr, NULL));
+		}
+		return binary;
+	}
+
 	// access the device
 	const device& get_device() const
 	{
@@ -128,11 +182,37 @@ public:
 
 
 private:
+	/// create program from a binary, false if the binary does not load
+	bool load_binary(const detail::kernel_binary& b,
+			const char * build_options)
+	{
+		int errorcode = 0;
+		cl_int status = 0;
+		const unsigned char* data = b.data;
+		program_ = clCreateProgramWithBinary(
+				get_backend_context(*device_), 1,
+				&(get_backend_device(*device_)), &b.size,
+				&data, &status, &errorcode);
+		if (CL_SUCCESS == errorcode && CL_SUCCESS == status &&
+				CL_SUCCESS == clBuildProgram(program_, 1,
+					&(get_backend_device(*device_)),
+					build_options, NULL, NULL)) {
+			return true;
+		}
+		if (nullptr != program_) {
+			clReleaseProgram(program_);
+			program_ = nullptr;
+		}
+		return false;
+	}
+
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
 		for (auto& it : kernels_) {
-			clReleaseKernel(it.second);
+			for (auto& it2 : it.second) {
+				clReleaseKernel(it2.second);
+			}
 		}
 		if (nullptr != program_) {
 			clReleaseProgram(program_);
@@ -142,7 +222,9 @@ private:
 private:
 	device * device_;
 	cl_program program_;
-	std::unordered_map<std::string, kernel> kernels_;
+	/// kernels of the host threads by name
+	std::unordered_map<std::string,
+		std::map<std::thread::id, kernel> > kernels_;
 };
 
 /**
@@ -0,0 +1,214 @@
+#ifndef AURA_BACKEND_OPENCL_TIMELINE_HPP
+#define AURA_BACKEND_OPENCL_TIMELINE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <boost/move/move.hpp>
+#ifdef __APPLE__
+	#include "OpenCL/opencl.h"
+#else
+	#include "CL/cl.h"
+#endif
+#include <boost/aura/config.hpp>
+#include <boost/aura/backend/opencl/call.hpp>
+#include <boost/aura/backend/opencl/feed.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace backend_detail
+{
+namespace opencl
+{
+
+/**
+ * timeline class
+ *
+ * monotonic sequence numbers of a feed, signal() returns the next number
+ * and is reached when all commands issued to the feed before it have
+ * finished, waiting for a number waits for all smaller numbers too
+ *
+ * the events of the last AURA_TIMELINE_CAPACITY numbers are kept in a
+ * ring, older events are released when their slot is reused, waiting
+ * for a number that is no longer in the ring waits for the oldest event
+ * in the ring instead (markers complete in order)
+ */
+class timeline
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(timeline)
+
+public:
+	/// create empty timeline
+	inline explicit timeline() : feed_(nullptr), value_(0), completed_(0) {}
+
+	/**
+	 * create timeline for a feed
+	 *
+	 * @param f feed, must outlive the timeline
+	 * @param capacity number of events kept
+	 */
+	inline explicit timeline(feed & f,
+			std::size_t capacity = AURA_TIMELINE_CAPACITY) :
+		feed_(&f), events_(capacity, nullptr), value_(0), completed_(0)
+	{}
+
+	/**
+	 * move constructor, move timeline here, invalidate other
+	 *
+	 * @param t timeline to move here
+	 */
+	timeline(BOOST_RV_REF(timeline) t) :
+		feed_(t.feed_), events_(std::move(t.events_)),
+		value_(t.value_), completed_(t.completed_)
+	{
+		t.feed_ = nullptr;
+	}
+
+	/**
+	 * move assignment, move timeline here, invalidate other
+	 *
+	 * @param t timeline to move here
+	 */
+	timeline& operator=(BOOST_RV_REF(timeline) t)
+	{
+		finalize();
+		feed_ = t.feed_;
+		events_ = std::move(t.events_);
+		value_ = t.value_;
+		completed_ = t.completed_;
+		t.feed_ = nullptr;
+		return *this;
+	}
+
+	/// destroy timeline
+	inline ~timeline()
+	{
+		finalize();
+	}
+
+	/**
+	 * signal the next number
+	 *
+	 * @return number that is reached when all commands issued to the
+	 * feed so far have finished
+	 */
+	std::uint64_t signal()
+	{
+		cl_event& e = slot(value_+1);
+		if (nullptr != e) {
+			AURA_OPENCL_SAFE_CALL(clReleaseEvent(e));
+			e = nullptr;
+		}
+#ifdef CL_VERSION_1_2
+		AURA_OPENCL_SAFE_CALL(clEnqueueMarkerWithWaitList(
+				feed_->get_backend_stream(), 0, NULL, &e));
+#else
+		AURA_OPENCL_SAFE_CALL(clEnqueueMarker(
+				feed_->get_backend_stream(), &e));
+#endif // CL_VERSION_1_2
+		return ++value_;
+	}
+
+	/// last signalled number
+	std::uint64_t get_value() const
+	{
+		return value_;
+	}
+
+	/// true if a number was reached, does not block
+	bool reached(std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return true;
+		}
+		cl_int status;
+		AURA_OPENCL_SAFE_CALL(clGetEventInfo(event_of(v),
+					CL_EVENT_COMMAND_EXECUTION_STATUS,
+					sizeof(status), &status, NULL));
+		if (CL_COMPLETE == status) {
+			completed_ = v;
+			return true;
+		}
+		return false;
+	}
+
+	/// block until a number was reached
+	void wait(std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return;
+		}
+		cl_event e = event_of(v);
+		AURA_OPENCL_SAFE_CALL(clWaitForEvents(1, &e));
+		completed_ = v;
+	}
+
+	/**
+	 * make another feed wait until a number was reached
+	 *
+	 * @param f feed that waits, must belong to the same device
+	 * @param v number
+	 */
+	void enqueue_wait(feed & f, std::uint64_t v)
+	{
+		if (v <= completed_) {
+			return;
+		}
+		cl_event e = event_of(v);
+#ifdef CL_VERSION_1_2
+		AURA_OPENCL_SAFE_CALL(clEnqueueBarrierWithWaitList(
+				f.get_backend_stream(), 1, &e, NULL));
+#else
+		AURA_OPENCL_SAFE_CALL(clEnqueueWaitForEvents(
+				f.get_backend_stream(), 1, &e));
+#endif // CL_VERSION_1_2
+	}
+
+private:
+	cl_event& slot(std::uint64_t v)
+	{
+		return events_[v % events_.size()];
+	}
+
+	/// event of a number, the oldest event kept if it was recycled
+	cl_event event_of(std::uint64_t v)
+	{
+		assert(0 < v && v <= value_);
+		if (value_ - v >= events_.size()) {
+			v = value_ - events_.size() + 1;
+		}
+		return slot(v);
+	}
+
+	/// finalize object (called from dtor and move assign)
+	void finalize()
+	{
+		for (auto& e : events_) {
+			if (nullptr != e) {
+				AURA_OPENCL_SAFE_CALL(clReleaseEvent(e));
+				e = nullptr;
+			}
+		}
+	}
+
+	/// feed the numbers are signalled in
+	feed * feed_;
+	/// ring of events, slot v % size holds the event of number v
+	std::vector<cl_event> events_;
+	/// last signalled number
+	std::uint64_t value_;
+	/// largest number known to be reached
+	std::uint64_t completed_;
+};
+
+} // opencl
+} // backend_detail
+} // aura
+} // boost
+
+#endif // AURA_BACKEND_OPENCL_TIMELINE_HPP
+
@@ -0,0 +1,27 @@
+#ifndef AURA_BACKEND_SHARED_BOUNDS_FIT_HPP
+#define AURA_BACKEND_SHARED_BOUNDS_FIT_HPP
+
+namespace boost
+{
+namespace aura 
+{
+
+/**
+ * how invoke maps bounds to a mesh
+ *
+ * an exact mesh has one fiber per element, a padded mesh may have more
+ * fibers than elements so that bundles can have a size the device
+ * prefers, kernels invoked with padded bounds must check
+ * get_mesh_id() against the number of elements
+ */
+enum class bounds_fit
+{
+	exact,
+	padded
+};
+
+} // namespace aura
+} // boost
+
+#endif // AURA_BACKEND_SHARED_BOUNDS_FIT_HPP
+
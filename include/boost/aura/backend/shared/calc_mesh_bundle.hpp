@@ -1,6 +1,12 @@
 #ifndef AURA_BACKEND_SHARED_CALC_MESH_BUNDLE_HPP
 #define AURA_BACKEND_SHARED_CALC_MESH_BUNDLE_HPP
 
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <boost/aura/config.hpp>
+#include <boost/aura/backend/shared/bounds_fit.hpp>
+
 namespace boost
 {
 namespace aura {
@@ -10,40 +16,58 @@ namespace detail {
 /**
  * @brief calculate combination of bundle and mesh, based on v
  *
- * recursively calculates the integer factorization and fills 
- * up an array of mesh and bundle (iterator i), rules are 
- * defined by a maximum size for mesh and bundle (iterator b)
+ * calculates the integer factorization by trial division and fills
+ * up an array of mesh and bundle (iterator i), rules are
+ * defined by a maximum size for mesh and bundle (iterator b),
+ * factors are only tried up to the square root of the remaining value
  *
  * the mask m defines if and at what position, the algorithm
  * should restart calculating, taking the previous value
- * into account 
+ * into account
  *
- * FIXME this function and its use is not implemented in a 
+ * FIXME this function and its use is not implemented in a
  * general way regarding the mask, but it is ok for now
  *
  * @param v is the value that should be factorized
- * @param f is the current factor
+ * @param f is the first factor tried
+ * @return false if a dimension exceeds its maximum size
  */
-inline void calc_mesh_bundle(std::size_t v, std::size_t f, 
+inline bool calc_mesh_bundle(std::size_t v, std::size_t f,
 		std::array<std::size_t, 4>::iterator i,
 		std::array<std::size_t, 4>::const_iterator b,
 		std::array<bool, 4>::const_iterator m)
 {
-	if (f > v) {
-		++m;
-		// hack to handle 1-Dimensional bundles in OpenCL
-		if (*m) {
-			auto t = *i;
-			++i;
-			*i = t;
-		}	
-		return;
-	}
-	if (0 == v % f) {
+	bool fits = true;
+	// current dimension
+	std::size_t d = 0;
+	while (true) {
+		if (f > v) {
+			// hack to handle 1-Dimensional bundles in OpenCL
+			if (d < 3 && *(m+1)) {
+				*(i+1) = *i;
+			}
+			return fits;
+		}
+		if (0 != v % f) {
+			f++;
+			// no factor up to the square root, v is prime
+			if (f*f > v) {
+				f = v;
+			}
+			continue;
+		}
 		if (*i*f > *b) {
+			if (3 == d) {
+				// no dimension left, exceed the last one
+				fits = false;
+				*i *= f;
+				v /= f;
+				continue;
+			}
 			++i;
 			++b;
 			++m;
+			++d;
 			// special handling for mask
 			if (*m) {
 				if (f * *(i-1) > *b) {
@@ -52,31 +76,99 @@ inline void calc_mesh_bundle(std::size_t v, std::size_t f,
 					++i;
 					++b;
 					++m;
-					calc_mesh_bundle(v,f,i,b,m);
+					++d;
 				} else {
-					f *= *(i-1);
-					*i *= f;
-					f /= *(i-1);
-					calc_mesh_bundle(v/f, f, i, b, m);
+					*i *= f * *(i-1);
+					v /= f;
 				}
-				return;
+				continue;
 			}
-			// if next dimension can hold value
+			// if next dimension can not hold value
 			// the size is invalid
-			assert(f < *b);
+			if (*i*f > *b) {
+				fits = false;
+			}
 		}
 		// put new factor in
 		*i *= f;
-		calc_mesh_bundle(v/f, f, i, b, m);
-	} else {
-		f++;
-		calc_mesh_bundle(v, f, i, b, m);
+		v /= f;
+	}
+}
+
+/**
+ * @brief calculate padded combination of bundle and mesh, based on v
+ *
+ * the bundle is the largest multiple of multiple that does not exceed
+ * the maximum bundle size, the mesh holds enough bundles to cover v
+ * elements, the mask has the same meaning as in calc_mesh_bundle
+ *
+ * @param v is the number of elements that should be covered
+ * @param multiple preferred multiple of the bundle size
+ */
+inline void calc_padded_mesh_bundle(std::size_t v, std::size_t multiple,
+		std::array<std::size_t, 4>::iterator i,
+		std::array<std::size_t, 4>::const_iterator b,
+		std::array<bool, 4>::const_iterator m)
+{
+	std::size_t bundle = b[0] / multiple * multiple;
+	if (0 == bundle) {
+		bundle = b[0];
+	}
+	// do not use more than one bundle for small sizes
+	if (v < bundle) {
+		bundle = (v + multiple - 1) / multiple * multiple;
+		if (bundle > b[0]) {
+			bundle = b[0];
+		}
+	}
+	// number of bundles, spread evenly to keep the padding small
+	std::size_t n = (v + bundle - 1) / bundle;
+	i[0] = bundle;
+	i[3] = (n + b[1]*b[2] - 1) / (b[1]*b[2]);
+	n = (n + i[3] - 1) / i[3];
+	i[2] = (n + b[1] - 1) / b[1];
+	i[1] = (n + i[2] - 1) / i[2];
+	if (m[1]) {
+		i[1] *= bundle;
+	}
+}
+
+/**
+ * @brief calculate launch geometry for v elements
+ *
+ * the geometry covers v elements exactly if possible, if fit allows
+ * padding and the exact bundle size is not a multiple of the preferred
+ * multiple (prime and other awkward sizes) a padded geometry is used
+ *
+ * @param v number of elements
+ * @param max_mb maximum bundle and mesh sizes
+ * @param mask see calc_mesh_bundle
+ * @param multiple preferred multiple of the bundle size
+ * @param fit exact or padded
+ * @return bundle size and 3 mesh sizes
+ */
+inline std::array<std::size_t, 4> calc_launch_geometry(std::size_t v,
+		const std::array<std::size_t, 4>& max_mb,
+		const std::array<bool, 4>& mask,
+		std::size_t multiple, bounds_fit fit)
+{
+#if AURA_INDEX_32
+	// kernels can not index more elements
+	assert(v <= 0xFFFFFFFFUL);
+#endif
+	std::array<std::size_t, 4> mb = {{1, 1, 1, 1}};
+	bool fits = calc_mesh_bundle(v, 2, mb.begin(), max_mb.begin(),
+			mask.begin());
+	if (bounds_fit::padded == fit && v > multiple &&
+			(!fits || 0 != mb[0] % multiple)) {
+		calc_padded_mesh_bundle(v, multiple, mb.begin(),
+				max_mb.begin(), mask.begin());
 	}
+	return mb;
 }
 
 } // namespace detail
-} // namespace aura 
+} // namespace aura
 } // boost
 
 #endif // AURA_BACKEND_SHARED_CALC_MESH_BUNDLE_HPP
-
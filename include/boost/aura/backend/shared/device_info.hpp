@@ -4,10 +4,35 @@
 struct device_info {
   char name[300];
   char vendor[300];
+  // driver version
+  char driver[100];
   svec<std::size_t, AURA_MAX_MESH_DIMS> max_mesh; 
   svec<std::size_t, AURA_MAX_BUNDLE_DIMS> max_bundle; 
   // max fibers per bundle
   std::size_t max_fibers_per_bundle;
+  // number of compute units (multiprocessors)
+  std::size_t compute_units;
+  // max clock frequency in MHz
+  std::size_t clock;
+  // global memory size in bytes
+  std::size_t global_memory;
+  // max size of a single allocation in bytes
+  std::size_t max_alloc;
+  // local (shared) memory per bundle in bytes
+  std::size_t local_memory;
+  // global memory cache line and cache size in bytes
+  std::size_t cache_line;
+  std::size_t cache_size;
+  // preferred and native vector width for float
+  std::size_t preferred_vector_width;
+  std::size_t native_vector_width;
+  // double and half precision support
+  bool fp64;
+  bool fp16;
+  // device and host share memory (CPU and integrated devices)
+  bool unified_memory;
+  // device is a CPU
+  bool cpu;
 };
 
 /// print device info to stdout
@@ -21,6 +46,13 @@ inline void print_device_info(const device_info & di) {
     printf("%lu ", di.max_bundle[i]);
   }
   printf("max_fibers_per_bundle: %lu\n", di.max_fibers_per_bundle);
+  printf("  compute units: %lu clock: %lu MHz global memory: %lu "
+    "max alloc: %lu local memory: %lu\n", di.compute_units, di.clock,
+    di.global_memory, di.max_alloc, di.local_memory);
+  printf("  cache line: %lu cache: %lu vector width: %lu (native %lu) "
+    "fp64: %d fp16: %d unified memory: %d cpu: %d\n", di.cache_line,
+    di.cache_size, di.preferred_vector_width, di.native_vector_width,
+    di.fp64, di.fp16, di.unified_memory, di.cpu);
 }
 
 #endif // AURA_BACKEND_SHARED_DEVICE_INFO_HPP
@@ -0,0 +1,25 @@
+#ifndef AURA_BACKEND_SHARED_FEED_ORDER_HPP
+#define AURA_BACKEND_SHARED_FEED_ORDER_HPP
+
+namespace boost
+{
+namespace aura 
+{
+
+/**
+ * execution order of the commands of a feed
+ *
+ * commands of an out_of_order feed may run concurrently, dependencies
+ * must be expressed with wait lists
+ */
+enum class feed_order
+{
+	in_order,
+	out_of_order
+};
+
+} // namespace aura
+} // boost
+
+#endif // AURA_BACKEND_SHARED_FEED_ORDER_HPP
+
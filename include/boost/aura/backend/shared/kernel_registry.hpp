@@ -0,0 +1,127 @@
+#ifndef AURA_BACKEND_SHARED_KERNEL_REGISTRY_HPP
+#define AURA_BACKEND_SHARED_KERNEL_REGISTRY_HPP
+
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <boost/aura/config.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace detail
+{
+
+/**
+ * kernel_registry class
+ *
+ * modules and kernels loaded on a device, safe to use from multiple host
+ * threads
+ *
+ * every host thread remembers the kernels it got, a kernel that was
+ * loaded before by the same thread is found without locking, otherwise
+ * the module is looked up under a lock that is held only for the lookup,
+ * a module is built exactly once even if multiple threads ask for it at
+ * the same time, other modules are built in parallel
+ *
+ * @tparam Module module of the backend
+ * @tparam Kernel kernel handle of the backend
+ */
+template <typename Module, typename Kernel>
+class kernel_registry
+{
+	/// module, built once, and the lock used to create its kernels
+	struct entry
+	{
+		std::once_flag built;
+		Module module;
+		std::mutex mutex;
+	};
+
+	/// registry, module identity and kernel name
+	typedef std::tuple<std::uint64_t, std::string, std::string> thread_key;
+	typedef std::map<thread_key, Kernel> thread_cache;
+
+public:
+	/// create empty registry
+	inline explicit kernel_registry() : id_(next_id()) {}
+
+	/**
+	 * get a kernel of the calling thread
+	 *
+	 * @param source identity of the module (source code or file name)
+	 * @param name name of the kernel
+	 * @param build returns the module, called once per module
+	 * @param create returns the kernel of the calling thread, called
+	 * with a reference to the module, calls for the same module are
+	 * serialized
+	 */
+	template <typename Build, typename Create>
+	Kernel get(const char* source, const char* name,
+			Build build, Create create)
+	{
+		thread_cache& cache = get_thread_cache();
+		thread_key tk(id_, source, name);
+		auto it = cache.find(tk);
+		if (cache.end() != it) {
+			return it->second;
+		}
+		std::shared_ptr<entry> e;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			std::shared_ptr<entry>& p = modules_[std::get<1>(tk)];
+			if (!p) {
+				p = std::make_shared<entry>();
+			}
+			e = p;
+		}
+		// if build throws, the next caller builds again
+		std::call_once(e->built, [&]() { e->module = build(); });
+		Kernel k;
+		{
+			std::lock_guard<std::mutex> lock(e->mutex);
+			k = create(e->module);
+		}
+		if (cache.size() >= AURA_THREAD_KERNEL_CACHE_SIZE) {
+			cache.clear();
+		}
+		cache.insert(std::make_pair(std::move(tk), k));
+		return k;
+	}
+
+private:
+	/// registries are never identified by the same number, kernels of
+	/// a destroyed registry can stay in the caches of the threads
+	static std::uint64_t next_id()
+	{
+		static std::atomic<std::uint64_t> id(0);
+		return ++id;
+	}
+
+	/// kernels the calling thread got from all registries
+	static thread_cache& get_thread_cache()
+	{
+		static thread_local thread_cache cache;
+		return cache;
+	}
+
+	/// identity in the thread caches
+	const std::uint64_t id_;
+	/// modules
+	std::unordered_map<std::string, std::shared_ptr<entry> > modules_;
+	/// protects modules_
+	std::mutex mutex_;
+};
+
+} // namespace detail
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_BACKEND_SHARED_KERNEL_REGISTRY_HPP
+
@@ -1,13 +1,44 @@
 #ifndef AURA_BOUNDS_HPP
 #define AURA_BOUNDS_HPP
 
+#include <cstdint>
 #include <boost/aura/detail/svec.hpp>
 
 namespace boost
 {
 namespace aura {
 
-typedef svec<int> bounds;
+typedef svec<std::int64_t> bounds;
+
+/**
+ * bounds of the packed spectrum of a real fourier transform
+ *
+ * the spectrum of real data is hermitian, only the non-redundant
+ * half of the fastest dimension (b[0]/2+1 elements) is stored
+ *
+ * @param b bounds of the real data
+ */
+inline bounds fft_hermitian_bounds(const bounds & b)
+{
+	bounds r(b);
+	r[0] = r[0]/2+1;
+	return r;
+}
+
+/**
+ * bounds of real data padded for an in-place real fourier transform
+ *
+ * the fastest dimension is padded to 2*(b[0]/2+1) elements, so the
+ * packed spectrum fits into the same memory
+ *
+ * @param b bounds of the real data
+ */
+inline bounds fft_padded_bounds(const bounds & b)
+{
+	bounds r(b);
+	r[0] = 2*(r[0]/2+1);
+	return r;
+}
 
 } // namespace aura
 } // boost
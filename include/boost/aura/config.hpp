@@ -28,5 +28,97 @@
 #define AURA_OPENCL_MAX_MESH1 1024 
 #define AURA_OPENCL_MAX_MESH2 1024 
 
+/**
+ * version of the headers kernels include (backend.hpp and the backend
+ * kernel headers), part of the hash of ahead of time compiled kernels,
+ * increment it when these headers change so that binaries compiled
+ * against older headers are not loaded
+ */
+#ifndef AURA_KERNEL_VERSION
+#define AURA_KERNEL_VERSION 1
+#endif
+
+/// size in bytes of the pinned staging buffers used by chunked coo I/O
+#ifndef AURA_COO_CHUNK_SIZE
+#define AURA_COO_CHUNK_SIZE (16*1024*1024)
+#endif
+
+/// maximum number of pinned host blocks cached per device
+#ifndef AURA_HOST_POOL_MAX_BLOCKS
+#define AURA_HOST_POOL_MAX_BLOCKS 1024
+#endif
+
+/// pinned host allocations of 2^AURA_HOST_POOL_MAX_CLASS_LOG bytes or
+/// more are not cached
+#ifndef AURA_HOST_POOL_MAX_CLASS_LOG
+#define AURA_HOST_POOL_MAX_CLASS_LOG 30
+#endif
+
+/// maximum number of pinned host bytes cached per device, blocks beyond
+/// that are freed when they are deallocated
+#ifndef AURA_HOST_POOL_MAX_BYTES
+#define AURA_HOST_POOL_MAX_BYTES ((std::size_t)256*1024*1024)
+#endif
+
+/// size in bytes of the transfers used to rank devices
+#ifndef AURA_DEVICE_PROBE_SIZE
+#define AURA_DEVICE_PROBE_SIZE (16*1024*1024)
+#endif
+
+/// number of events a timeline keeps before recycling them
+#ifndef AURA_TIMELINE_CAPACITY
+#define AURA_TIMELINE_CAPACITY 64
+#endif
+
+/// number of launch geometries cached per device before the cache is
+/// cleared
+#ifndef AURA_LAUNCH_CACHE_SIZE
+#define AURA_LAUNCH_CACHE_SIZE 4096
+#endif
+
+/// number of kernels a host thread remembers before it forgets all of
+/// them and looks them up in the device again
+#ifndef AURA_THREAD_KERNEL_CACHE_SIZE
+#define AURA_THREAD_KERNEL_CACHE_SIZE 1024
+#endif
+
+/// number of threads building kernels in the background, 0 for one
+/// thread per hardware thread
+#ifndef AURA_PRECOMPILE_THREADS
+#define AURA_PRECOMPILE_THREADS 0
+#endif
+
+/// if 1, math operations with shape dependent kernels (ndmul,
+/// reduced_sum) build one module per shape with the sizes as constants
+#ifndef AURA_MATH_SPECIALIZE
+#define AURA_MATH_SPECIALIZE 0
+#endif
+
+/// if 1, operations that are not tuned for a device and size are tuned
+/// on first use, otherwise they use their default launch configuration
+#ifndef AURA_AUTOTUNE
+#define AURA_AUTOTUNE 0
+#endif
+
+/// number of timed runs per candidate launch configuration
+#ifndef AURA_AUTOTUNE_RUNS
+#define AURA_AUTOTUNE_RUNS 8
+#endif
+
+/// if 1, device buffers on devices that share memory with the host (CPU
+/// and integrated devices) are host accessible and copied by the host,
+/// such copies block until the work queued in the feed has finished,
+/// off by default since copies are asynchronous otherwise
+#ifndef AURA_ZERO_COPY
+#define AURA_ZERO_COPY 0
+#endif
+
+/// if 1, kernels index elements with 32 bit integers (AURA_INDEX), faster
+/// on some devices but only for arrays with less than 2^32 elements,
+/// kernels must be built with the same value
+#ifndef AURA_INDEX_32
+#define AURA_INDEX_32 0
+#endif
+
 #endif // AURA_CONFIG_HPP 
 
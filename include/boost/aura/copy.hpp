@@ -25,63 +25,63 @@ void copy(Iterator src, device_array<T>& dst, backend::feed& f)
     typedef typename std::iterator_traits<Iterator>::value_type T2;
     static_assert(std::is_same<T, T2>::value,
             "iterator value type and device_array type must match");
-	backend::copy<T>(dst.begin(), &(*src), dst.size(), f);
+	detail::copy_to_buffer<T>(dst.begin(), &(*src), dst.size(), f);
 }
 
 /// copy to device array
 template <typename T>
 void copy(const T* src, device_array<T>& dst, backend::feed& f) 
 {
-	backend::copy<T>(dst.begin(), src, dst.size(), f);
+	detail::copy_to_buffer<T>(dst.begin(), src, dst.size(), f);
 }
 
 /// copy from device array
 template <typename T>
 void copy(const device_array<T>& src, T* dst, feed& f) 
 {
-	backend::copy<T>(dst, src.begin(), src.size(), f);
+	detail::copy_from_buffer<T>(dst, src.begin(), src.size(), f);
 }
 
 /// copy from std::vector to device array
 template <typename T>
 void copy(const std::vector<T>& src, device_array<T>& dst, feed& f)
 {
-	backend::copy<T>(dst.begin(), &src[0], dst.size(), f);
+	detail::copy_to_buffer<T>(dst.begin(), &src[0], dst.size(), f);
 }
 
 /// copy from device array to std::vector
 template <typename T>
 void copy(const device_array<T>& src, std::vector<T>& dst, feed& f)
 {
-	backend::copy<T>(&dst[0], src.begin(), src.size(), f);
+	detail::copy_from_buffer<T>(&dst[0], src.begin(), src.size(), f);
 }
 
 /// copy to device array
 template <typename T>
 void copy(const T* src, device_range<T>& dst, backend::feed& f) 
 {
-	backend::copy<T>(dst.begin(), src, dst.size(), f);
+	detail::copy_to_buffer<T>(dst.begin(), src, dst.size(), f);
 }
 
 /// copy from device array
 template <typename T>
 void copy(const device_range<T>& src, T* dst, feed& f) 
 {
-	backend::copy<T>(dst, src.begin(), src.size(), f);
+	detail::copy_from_buffer<T>(dst, src.begin(), src.size(), f);
 }
 
 /// copy from std::vector to device array
 template <typename T>
 void copy(const std::vector<T>& src, device_range<T>& dst, feed& f)
 {
-	backend::copy<T>(dst.begin(), &src[0], dst.size(), f);
+	detail::copy_to_buffer<T>(dst.begin(), &src[0], dst.size(), f);
 }
 
 /// copy from device array to std::vector
 template <typename T>
 void copy(const device_range<T>& src, std::vector<T>& dst, feed& f)
 {
-	backend::copy<T>(&dst[0], src.begin(), src.size(), f);
+	detail::copy_from_buffer<T>(&dst[0], src.begin(), src.size(), f);
 }
 
 /// copy from device array to device array
@@ -23,6 +23,7 @@ struct allocator_traits<::boost::aura::backend::detail::host_allocator<U>>
 	typedef false_type propagate_on_container_copy_assignment;
 	typedef true_type propagate_on_container_move_assignment;
 	typedef true_type propagate_on_container_swap;
+	typedef false_type is_always_equal;
 
 	template <typename T> using rebind_alloc = allocator_type;
 	template <typename T> using rebind_traits = 
@@ -0,0 +1,380 @@
+#ifndef AURA_DETAIL_HOST_POOL_HPP
+#define AURA_DETAIL_HOST_POOL_HPP
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <boost/aura/config.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace detail
+{
+
+/**
+ * host_pool class
+ *
+ * caches pinned host memory blocks so that allocations of similar size
+ * do not have to pin memory again, blocks are reused across allocators
+ * (and thus vectors) of the same device
+ *
+ * the pool does not create or free blocks, the backend allocator does
+ * that on a miss and registers the new block, the block stays in the
+ * pool (and pinned) until clear() is called, the pool holds at most
+ * AURA_HOST_POOL_MAX_BYTES, larger blocks are not registered and freed
+ * by the allocator again
+ *
+ * size classes are powers of two divided into 4 steps (25% granularity),
+ * requests larger than AURA_HOST_POOL_MAX_CLASS are not pooled
+ *
+ * acquire, release and lookups are lock-free, the free list of a size
+ * class is a tagged stack, the lookup tables (host pointer to block and
+ * backend handle to block) are open addressing hash tables, only
+ * inserting a new block takes a lock
+ */
+class host_pool
+{
+
+private:
+	static const std::uint32_t max_blocks = AURA_HOST_POOL_MAX_BLOCKS;
+	static const std::uint32_t segment_size = 256;
+	static const std::uint32_t segments =
+		(max_blocks + segment_size - 1) / segment_size;
+	static const std::uint32_t table_size = 2*max_blocks;
+	static const std::size_t min_class_log = 12;
+	static const std::size_t classes =
+		(AURA_HOST_POOL_MAX_CLASS_LOG - min_class_log)*4 + 1;
+	/// marks removed table entries
+	static const std::uintptr_t tombstone = 1;
+
+	struct block
+	{
+		void* ptr;
+		std::uintptr_t handle;
+		std::size_t size;
+		/// next free block in free list (index + 1)
+		std::atomic<std::uint32_t> next;
+	};
+
+	struct entry
+	{
+		std::atomic<std::uintptr_t> key;
+		std::atomic<std::uint32_t> index;
+	};
+
+public:
+	/// create empty pool
+	inline explicit host_pool() : count_(0), size_(0)
+	{
+		for (auto& s : segments_) {
+			s.store(nullptr);
+		}
+		for (auto& h : free_) {
+			h.store(0);
+		}
+		for (std::uint32_t i=0; i<table_size; i++) {
+			ptrs_[i].key.store(0);
+			handles_[i].key.store(0);
+		}
+	}
+
+	/// destroy pool, clear() must have been called
+	inline ~host_pool()
+	{
+		for (auto& s : segments_) {
+			delete [] s.load();
+		}
+	}
+
+	/**
+	 * size class of a request
+	 *
+	 * @param bytes requested size
+	 * @param class_size size of the blocks of the class (bytes if the
+	 * request is not pooled)
+	 * @return size class or classes if not pooled
+	 */
+	static std::size_t size_class(std::size_t bytes, std::size_t& class_size)
+	{
+		if (bytes <= ((std::size_t)1 << min_class_log)) {
+			class_size = (std::size_t)1 << min_class_log;
+			return 0;
+		}
+		std::size_t b = 0;
+		for (std::size_t v = bytes-1; v > 1; v >>= 1) {
+			b++;
+		}
+		// 2^b < bytes <= 2^(b+1), split in 4 steps
+		std::size_t step = (bytes-1) >> (b-2);
+		std::size_t c = (b - min_class_log)*4 + (step-4) + 1;
+		if (c >= classes) {
+			class_size = bytes;
+			return classes;
+		}
+		class_size = (step+1) << (b-2);
+		return c;
+	}
+
+	/// true if requests of bytes are pooled
+	static bool pooled(std::size_t bytes)
+	{
+		std::size_t class_size;
+		return size_class(bytes, class_size) < classes;
+	}
+
+	/**
+	 * take a free block from the pool
+	 *
+	 * @return true if a block was found
+	 */
+	bool acquire(std::size_t bytes, void*& ptr, std::uintptr_t& handle)
+	{
+		std::size_t class_size;
+		std::size_t c = size_class(bytes, class_size);
+		if (c >= classes) {
+			return false;
+		}
+		std::atomic<std::uint64_t>& head = free_[c];
+		std::uint64_t h = head.load(std::memory_order_acquire);
+		while (true) {
+			std::uint32_t i = (std::uint32_t)h;
+			if (0 == i) {
+				return false;
+			}
+			block& b = get(i-1);
+			std::uint64_t n = ((h >> 32) + 1) << 32 |
+				b.next.load(std::memory_order_relaxed);
+			if (head.compare_exchange_weak(h, n,
+						std::memory_order_acq_rel)) {
+				ptr = b.ptr;
+				handle = b.handle;
+				return true;
+			}
+		}
+	}
+
+	/**
+	 * register a new block that is in use
+	 *
+	 * @param ptr host pointer
+	 * @param handle backend handle of the block
+	 * @param size size of the block (as returned by size_class)
+	 * @return false if the request is not pooled or the pool is full
+	 * (blocks or bytes), the block is not registered then
+	 */
+	bool insert(void* ptr, std::uintptr_t handle, std::size_t size)
+	{
+		std::size_t class_size;
+		if (size_class(size, class_size) >= classes) {
+			return false;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (count_ >= max_blocks ||
+				size_ + class_size > AURA_HOST_POOL_MAX_BYTES) {
+			return false;
+		}
+		std::uint32_t i = count_;
+		if (0 == i % segment_size) {
+			segments_[i / segment_size].store(new block[segment_size],
+					std::memory_order_release);
+		}
+		block& b = get(i);
+		b.ptr = ptr;
+		b.handle = handle;
+		b.size = class_size;
+		b.next.store(0);
+		put(ptrs_, (std::uintptr_t)ptr, i);
+		put(handles_, handle, i);
+		count_ = i + 1;
+		size_ += class_size;
+		return true;
+	}
+
+	/**
+	 * give a block back to the pool
+	 *
+	 * @return false if ptr is not a pooled block
+	 */
+	bool release(void* ptr)
+	{
+		std::uint32_t i;
+		if (!lookup(ptrs_, (std::uintptr_t)ptr, i)) {
+			return false;
+		}
+		block& b = get(i);
+		std::size_t class_size;
+		std::atomic<std::uint64_t>& head =
+			free_[size_class(b.size, class_size)];
+		std::uint64_t h = head.load(std::memory_order_acquire);
+		while (true) {
+			b.next.store((std::uint32_t)h, std::memory_order_relaxed);
+			std::uint64_t n = ((h >> 32) + 1) << 32 | (i + 1);
+			if (head.compare_exchange_weak(h, n,
+						std::memory_order_acq_rel)) {
+				return true;
+			}
+		}
+	}
+
+	/// find the handle of the pooled block starting at ptr
+	bool find_handle(void* ptr, std::uintptr_t& handle) const
+	{
+		std::uint32_t i;
+		if (!lookup(ptrs_, (std::uintptr_t)ptr, i)) {
+			return false;
+		}
+		handle = get(i).handle;
+		return true;
+	}
+
+	/// find the host pointer and size of the pooled block with handle
+	bool find_ptr(std::uintptr_t handle, void*& ptr,
+			std::size_t& size) const
+	{
+		std::uint32_t i;
+		if (!lookup(handles_, handle, i)) {
+			return false;
+		}
+		ptr = get(i).ptr;
+		size = get(i).size;
+		return true;
+	}
+
+	/// the host pointer of a block changed (remapped to another address)
+	void rekey(std::uintptr_t handle, void* ptr)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::uint32_t i;
+		if (!lookup(handles_, handle, i) || get(i).ptr == ptr) {
+			return;
+		}
+		remove(ptrs_, (std::uintptr_t)get(i).ptr);
+		get(i).ptr = ptr;
+		put(ptrs_, (std::uintptr_t)ptr, i);
+	}
+
+	/**
+	 * call f(ptr, handle) for every block and forget all blocks, no
+	 * block may be in use and the pool must not be used concurrently
+	 */
+	template <typename F>
+	void clear(F f)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (std::uint32_t i=0; i<count_; i++) {
+			f(get(i).ptr, get(i).handle);
+		}
+		for (auto& h : free_) {
+			h.store(0);
+		}
+		for (std::uint32_t i=0; i<table_size; i++) {
+			ptrs_[i].key.store(0);
+			handles_[i].key.store(0);
+		}
+		count_ = 0;
+		size_ = 0;
+	}
+
+	/// total number of bytes held by the pool (free and in use)
+	std::size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return size_;
+	}
+
+	/// number of blocks held by the pool (free and in use)
+	std::size_t count() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return count_;
+	}
+
+private:
+	block& get(std::uint32_t i) const
+	{
+		return segments_[i / segment_size].load(
+				std::memory_order_acquire)[i % segment_size];
+	}
+
+	static std::uint32_t hash(std::uintptr_t key)
+	{
+		std::uint64_t h = (std::uint64_t)key * 0x9E3779B97F4A7C15ull;
+		return (std::uint32_t)(h >> 32) % table_size;
+	}
+
+	/// insert key, requires the lock
+	static void put(std::array<entry, table_size>& t, std::uintptr_t key,
+			std::uint32_t index)
+	{
+		for (std::uint32_t p = hash(key); ; p = (p+1) % table_size) {
+			std::uintptr_t k = t[p].key.load(std::memory_order_relaxed);
+			if (0 == k || tombstone == k) {
+				// publish the index before the key
+				t[p].index.store(index, std::memory_order_relaxed);
+				t[p].key.store(key, std::memory_order_release);
+				return;
+			}
+		}
+	}
+
+	/// remove key, requires the lock
+	static void remove(std::array<entry, table_size>& t,
+			std::uintptr_t key)
+	{
+		for (std::uint32_t p = hash(key); ; p = (p+1) % table_size) {
+			std::uintptr_t k = t[p].key.load(std::memory_order_relaxed);
+			if (0 == k) {
+				return;
+			}
+			if (key == k) {
+				t[p].key.store(tombstone, std::memory_order_release);
+				return;
+			}
+		}
+	}
+
+	/// lock-free lookup
+	static bool lookup(const std::array<entry, table_size>& t,
+			std::uintptr_t key, std::uint32_t& index)
+	{
+		for (std::uint32_t p = hash(key), n = 0; n < table_size;
+				p = (p+1) % table_size, n++) {
+			std::uintptr_t k = t[p].key.load(std::memory_order_acquire);
+			if (0 == k) {
+				return false;
+			}
+			if (key == k) {
+				index = t[p].index.load(std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// blocks, allocated in segments so that they never move
+	std::array<std::atomic<block*>, segments> segments_;
+	/// free list per size class (tag << 32 | index + 1)
+	std::array<std::atomic<std::uint64_t>, classes> free_;
+	/// host pointer to block
+	std::array<entry, table_size> ptrs_;
+	/// backend handle to block
+	std::array<entry, table_size> handles_;
+	/// number of blocks
+	std::uint32_t count_;
+	/// bytes held by the pool
+	std::size_t size_;
+	/// serializes inserting blocks
+	mutable std::mutex mutex_;
+};
+
+} // namespace detail
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_DETAIL_HOST_POOL_HPP
+
@@ -0,0 +1,223 @@
+#ifndef AURA_DETAIL_LAUNCH_CACHE_HPP
+#define AURA_DETAIL_LAUNCH_CACHE_HPP
+
+#include <map>
+#include <array>
+#include <tuple>
+#include <mutex>
+#include <string>
+#include <cstddef>
+#include <boost/aura/config.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// launch configuration of a kernel
+struct launch_config
+{
+	inline launch_config(std::size_t bundle = 0,
+			std::size_t vector_width = 1,
+			std::size_t elements_per_fiber = 1) :
+		bundle(bundle), vector_width(vector_width),
+		elements_per_fiber(elements_per_fiber) {}
+
+	/// bundle size
+	std::size_t bundle;
+	/// number of elements loaded at once by a fiber
+	std::size_t vector_width;
+	/// number of elements processed by a fiber
+	std::size_t elements_per_fiber;
+};
+
+inline bool operator==(const launch_config& lhs, const launch_config& rhs)
+{
+	return lhs.bundle == rhs.bundle &&
+		lhs.vector_width == rhs.vector_width &&
+		lhs.elements_per_fiber == rhs.elements_per_fiber;
+}
+
+inline bool operator!=(const launch_config& lhs, const launch_config& rhs)
+{
+	return !(lhs == rhs);
+}
+
+namespace detail
+{
+
+/// launch configuration of an operation and its kernel source
+struct tuned_launch
+{
+	/// configuration
+	launch_config config;
+	/// kernel source specialized for the configuration
+	std::string source;
+};
+
+/**
+ * launch_cache class
+ *
+ * remembers the launch geometry (bundle size and 3 mesh sizes) invoke
+ * calculated for a kernel and a number of elements, so that launching
+ * the same kernel with the same bounds again does not factorize again
+ *
+ * a cache belongs to a device context, if it holds more than
+ * AURA_LAUNCH_CACHE_SIZE geometries it is cleared
+ *
+ * the cache also holds tuned bundle sizes of kernels per size class
+ * (see get_size_class), a tuned bundle size limits the bundle size of
+ * the geometries calculated for the kernel, and the launch
+ * configurations chosen for operations (see math::sum) per size class,
+ * so that an operation asks the tuning database only once
+ */
+class launch_cache
+{
+
+public:
+	/// bundle size and 3 mesh sizes
+	typedef std::array<std::size_t, 4> geometry;
+
+	/// create empty cache
+	inline explicit launch_cache() {}
+
+	/**
+	 * get the geometry of a launch, calculate it if it is not cached
+	 *
+	 * @param kernel backend kernel handle
+	 * @param v number of elements
+	 * @param padded if the geometry may cover more than v elements
+	 * @param calc function returning the geometry
+	 */
+	template <typename Calc>
+	geometry get(const void* kernel, std::size_t v, bool padded, Calc calc)
+	{
+		key k(kernel, v, padded);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = entries_.find(k);
+			if (entries_.end() != it) {
+				return it->second;
+			}
+		}
+		geometry g = calc();
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (entries_.size() >= AURA_LAUNCH_CACHE_SIZE) {
+			entries_.clear();
+		}
+		entries_.insert(std::make_pair(k, g));
+		return g;
+	}
+
+	/**
+	 * set the tuned bundle size of a kernel for a size class
+	 *
+	 * @param kernel backend kernel handle
+	 * @param size_class size class of the number of elements
+	 * @param bundle bundle size, 0 removes the tuned bundle size
+	 */
+	void set_bundle(const void* kernel, std::size_t size_class,
+			std::size_t bundle)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (0 == bundle) {
+			bundles_.erase(std::make_pair(kernel, size_class));
+		} else {
+			bundles_[std::make_pair(kernel, size_class)] = bundle;
+		}
+		// geometries calculated before are outdated
+		entries_.clear();
+	}
+
+	/// tuned bundle size of a kernel for a size class, 0 if not tuned
+	std::size_t get_bundle(const void* kernel, std::size_t size_class)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = bundles_.find(std::make_pair(kernel, size_class));
+		if (bundles_.end() == it) {
+			return 0;
+		}
+		return it->second;
+	}
+
+	/**
+	 * launch configuration chosen for an operation
+	 *
+	 * @param name operation identity
+	 * @param size_class size class of the number of elements
+	 * @return configuration or nullptr if none was chosen, valid as
+	 * long as the cache
+	 */
+	const tuned_launch* find_launch(const std::string& name,
+			std::size_t size_class)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = launches_.find(std::make_pair(name, size_class));
+		if (launches_.end() == it) {
+			return nullptr;
+		}
+		return &it->second;
+	}
+
+	/**
+	 * remember the launch configuration chosen for an operation, a
+	 * configuration chosen before is kept
+	 *
+	 * @return configuration of the operation, valid as long as the
+	 * cache
+	 */
+	const tuned_launch* set_launch(const std::string& name,
+			std::size_t size_class, const tuned_launch& l)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return &launches_.insert(std::make_pair(
+				std::make_pair(name, size_class), l)).first->second;
+	}
+
+	/// number of cached geometries
+	std::size_t size()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.size();
+	}
+
+	/// remove all geometries
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.clear();
+	}
+
+private:
+	typedef std::tuple<const void*, std::size_t, bool> key;
+
+	/// cached geometries
+	std::map<key, geometry> entries_;
+	/// tuned bundle sizes by kernel and size class
+	std::map<std::pair<const void*, std::size_t>, std::size_t> bundles_;
+	/// chosen configurations by operation and size class
+	std::map<std::pair<std::string, std::size_t>, tuned_launch> launches_;
+	/// protects entries_, bundles_ and launches_
+	std::mutex mutex_;
+};
+
+/**
+ * size class of a number of elements, sizes of the same power of two
+ * share a class
+ */
+inline std::size_t get_size_class(std::size_t v)
+{
+	std::size_t c = 0;
+	while (v > 1) {
+		v >>= 1;
+		c++;
+	}
+	return c;
+}
+
+} // namespace detail
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_DETAIL_LAUNCH_CACHE_HPP
+
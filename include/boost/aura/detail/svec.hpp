@@ -242,7 +242,7 @@ public:
 	/**
 	 * equal to
 	 */
-	bool operator==(const svec<T, AURA_SVEC_MAX_SIZE>& b)
+	bool operator==(const svec<T, AURA_SVEC_MAX_SIZE>& b) const
 	{
 		return size_ == b.size_ &&
 			std::equal(data_.begin(), data_.begin()+size_,
@@ -252,7 +252,7 @@ public:
 	/**
 	 * not equal to
 	 */
-	bool operator!=(const svec<T, AURA_SVEC_MAX_SIZE>& b)
+	bool operator!=(const svec<T, AURA_SVEC_MAX_SIZE>& b) const
 	{
 		return !(*this == b);
 	}
@@ -175,7 +175,7 @@ public:
 	T get_value (std::size_t index, backend::feed& f) const
 	{
 		T value;
-		boost::aura::backend::copy<T>(&value,data_.begin()+index,1, f);
+		detail::copy_from_buffer<T>(&value, data_.begin()+index, 1, f);
 		wait_for(f);
 		return value;
 	}
@@ -185,7 +185,7 @@ public:
     {
         assert(1 == data_.size());
         T value;
-        boost::aura::backend::copy<T>(&value,data_.begin(),1, f);
+        detail::copy_from_buffer<T>(&value, data_.begin(), 1, f);
         wait_for(f);
         return value;
     }
@@ -193,7 +193,7 @@ public:
 	// set a single value in the vector (synchronous!)
 	void set_value(std::size_t index, T value, backend::feed& f)
 	{
-		boost::aura::backend::copy<T>(data_.begin()+index,&value,1, f);
+		detail::copy_to_buffer<T>(data_.begin()+index, &value, 1, f);
 		wait_for(f);
 	}
 
@@ -201,7 +201,7 @@ public:
     void set_value(T value, backend::feed& f)
     {
         assert(1 == data_.size());
-        boost::aura::backend::copy<T>(data_.begin(),&value,1, f);
+        detail::copy_to_buffer<T>(data_.begin(), &value, 1, f);
         wait_for(f);
     }
 
@@ -248,6 +248,12 @@ public:
 		return data_.data();
 	}
 
+	/// true if the array is host accessible (see AURA_ZERO_COPY)
+	bool is_zero_copy() const
+	{
+		return data_.is_zero_copy();
+	}
+
 	/// return number of elements in array
 	std::size_t size() const
 	{
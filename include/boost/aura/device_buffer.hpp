@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <boost/move/move.hpp>
+#include <boost/aura/config.hpp>
 #include <boost/aura/backend.hpp>
 
 namespace boost
@@ -10,6 +11,55 @@ namespace boost
 namespace aura
 {
 
+namespace detail
+{
+
+/**
+ * true if buffers on the device are host accessible and copied by the
+ * host (AURA_ZERO_COPY and a device that shares memory with the host),
+ * copies of such buffers to and from the host are synchronous
+ */
+inline bool is_zero_copy(const device & d)
+{
+	return AURA_ZERO_COPY && d.get_context()->get_info().unified_memory;
+}
+
+/// allocate the memory of a buffer
+template <typename T>
+device_ptr<T> buffer_malloc(std::size_t size, device & d)
+{
+	if (is_zero_copy(d)) {
+		return backend::device_malloc_unified<T>(size, d);
+	}
+	return backend::device_malloc<T>(size, d);
+}
+
+/// copy host memory to the memory of a buffer
+template <typename T>
+void copy_to_buffer(device_ptr<T> dst, const T* src, std::size_t size,
+		feed & f)
+{
+	if (is_zero_copy(dst.get_device())) {
+		backend::copy_unified<T>(dst, src, size, f);
+	} else {
+		backend::copy<T>(dst, src, size, f);
+	}
+}
+
+/// copy the memory of a buffer to host memory
+template <typename T>
+void copy_from_buffer(T* dst, const device_ptr<T> src, std::size_t size,
+		feed & f)
+{
+	if (is_zero_copy(src.get_device())) {
+		backend::copy_unified<T>(dst, src, size, f);
+	} else {
+		backend::copy<T>(dst, src, size, f);
+	}
+}
+
+} // namespace detail
+
 /// continuous block of memory holding multiple instances of a type T
 template <typename T>
 class device_buffer
@@ -29,7 +79,7 @@ public:
 
 	/// create buffer of size on device
 	device_buffer(std::size_t size, backend::device & d) :
-		ptr_(backend::device_malloc<T>(size, d)), size_(size)
+		ptr_(detail::buffer_malloc<T>(size, d)), size_(size)
 	{}
 
 	/// destroy object
@@ -69,7 +119,7 @@ public:
 	void resize(const std::size_t size, device& d)
 	{
 		finalize();
-		ptr_ = backend::device_malloc<T>(size, d);
+		ptr_ = detail::buffer_malloc<T>(size, d);
 		size_ = size;
 	}
 
@@ -134,6 +184,12 @@ public:
 		return (T*)ptr_.get_base() + size_;
 	}
 
+	/// true if the buffer is host accessible (see AURA_ZERO_COPY)
+	bool is_zero_copy() const
+	{
+		return nullptr != ptr_ && detail::is_zero_copy(ptr_.get_device());
+	}
+
 	/// return size of buffer
 	std::size_t size() const
 	{
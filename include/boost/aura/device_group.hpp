@@ -0,0 +1,201 @@
+#ifndef AURA_DEVICE_GROUP_HPP
+#define AURA_DEVICE_GROUP_HPP
+
+#include <vector>
+#include <numeric>
+#include <cassert>
+#include <boost/move/move.hpp>
+#include <boost/aura/backend.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/**
+ * device_group class
+ *
+ * a set of devices that work on partitions of the same data, every
+ * device has its own feed, the devices can be separate accelerators or
+ * sub-devices of one device (OpenCL)
+ *
+ * every device has a weight, data is partitioned proportionally to the
+ * weights (all weights are 1 by default)
+ */
+class device_group
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(device_group)
+
+public:
+	/// create empty group
+	inline explicit device_group() {}
+
+	/**
+	 * create group from devices, the group takes ownership
+	 *
+	 * @param devices devices of the group
+	 */
+	inline explicit device_group(std::vector<device> devices) :
+		devices_(boost::move(devices)), weights_(devices_.size(), 1.)
+	{
+		create_feeds();
+	}
+
+	/**
+	 * create group from device ordinals
+	 *
+	 * @param ordinals device ordinals
+	 */
+	inline explicit device_group(const std::vector<std::size_t>& ordinals) :
+		weights_(ordinals.size(), 1.)
+	{
+		devices_.reserve(ordinals.size());
+		for (std::size_t o : ordinals) {
+			devices_.push_back(device((int)o));
+		}
+		create_feeds();
+	}
+
+	/**
+	 * move constructor, move group here, invalidate other
+	 *
+	 * @param g group to move here
+	 */
+	device_group(BOOST_RV_REF(device_group) g) :
+		devices_(std::move(g.devices_)), feeds_(std::move(g.feeds_)),
+		weights_(std::move(g.weights_))
+	{}
+
+	/**
+	 * move assignment, move group here, invalidate other
+	 *
+	 * @param g group to move here
+	 */
+	device_group& operator=(BOOST_RV_REF(device_group) g)
+	{
+		// feeds must die before their devices
+		feeds_.clear();
+		devices_ = std::move(g.devices_);
+		feeds_ = std::move(g.feeds_);
+		weights_ = std::move(g.weights_);
+		return *this;
+	}
+
+	/// destroy group, feeds die before their devices
+	inline ~device_group()
+	{
+		feeds_.clear();
+	}
+
+	/// number of devices
+	std::size_t size() const
+	{
+		return devices_.size();
+	}
+
+	/// access device i
+	device& get_device(std::size_t i)
+	{
+		return devices_[i];
+	}
+
+	/// access the feed of device i
+	feed& get_feed(std::size_t i)
+	{
+		return feeds_[i];
+	}
+
+	/// weights used to partition data
+	const std::vector<double>& get_weights() const
+	{
+		return weights_;
+	}
+
+	/// set weights used to partition data (e.g. measured throughput)
+	void set_weights(const std::vector<double>& weights)
+	{
+		assert(weights.size() == devices_.size());
+		weights_ = weights;
+	}
+
+	/**
+	 * split n items according to the weights
+	 *
+	 * @return number of items per device, the sum is n
+	 */
+	std::vector<std::size_t> partition(std::size_t n) const
+	{
+		std::vector<std::size_t> r(devices_.size(), 0);
+		double total = std::accumulate(weights_.begin(),
+				weights_.end(), 0.);
+		std::size_t assigned = 0;
+		double acc = 0.;
+		for (std::size_t i=0; i<r.size(); i++) {
+			// cumulative rounding, the sum is exact
+			acc += weights_[i];
+			std::size_t end = i+1 == r.size() ? n :
+				(std::size_t)(n * acc / total + .5);
+			r[i] = end - assigned;
+			assigned = end;
+		}
+		return r;
+	}
+
+	/// wait until all feeds have finished
+	void synchronize()
+	{
+		for (auto& f : feeds_) {
+			wait_for(f);
+		}
+	}
+
+private:
+	void create_feeds()
+	{
+		feeds_.reserve(devices_.size());
+		for (auto& d : devices_) {
+			feeds_.push_back(feed(d));
+		}
+	}
+
+	/// devices
+	std::vector<device> devices_;
+	/// one feed per device
+	std::vector<feed> feeds_;
+	/// partition weights
+	std::vector<double> weights_;
+};
+
+#if defined AURA_BACKEND_OPENCL && defined CL_VERSION_1_2
+/**
+ * create group of n sub-devices of a device with equal numbers of
+ * compute units, typically used with CPU devices
+ *
+ * @return group, empty if the device can not be partitioned
+ */
+inline device_group create_sub_device_group(device& d, std::size_t n)
+{
+	return device_group(backend::create_sub_devices(d, n));
+}
+
+/**
+ * create group of one sub-device per NUMA node of a CPU device, every
+ * sub-device has its own feed, arrays distributed across the group are
+ * first touched (and thus allocated) on the node that works on them
+ *
+ * @return group, empty if the device is not a CPU or can not be
+ * partitioned by affinity domain
+ */
+inline device_group create_numa_device_group(device& d)
+{
+	return device_group(backend::create_numa_sub_devices(d));
+}
+#endif
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_DEVICE_GROUP_HPP
+
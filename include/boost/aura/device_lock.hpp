@@ -1,6 +1,8 @@
 #ifndef AURA_DEVICE_LOCK_HPP
 #define AURA_DEVICE_LOCK_HPP
 
+#include <set>
+#include <mutex>
 #include <fstream>
 #include <memory>
 #include <boost/filesystem.hpp>
@@ -43,9 +45,57 @@ inline boost::filesystem::path get_lockfile_name(std::size_t ordinal)
 	return p;
 }
 
+namespace detail
+{
+
+/**
+ * ordinals of the devices locked by this process
+ *
+ * file locks belong to the process, locking a file twice succeeds and
+ * closing any descriptor of the file releases all locks of the process,
+ * so the lock file of a device this process holds must not be touched
+ */
+class held_device_locks
+{
+
+public:
+	/// mark a device as held, false if it is held already
+	bool acquire(std::size_t ordinal)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return held_.insert(ordinal).second;
+	}
+
+	/// mark a device as no longer held
+	void release(std::size_t ordinal)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		held_.erase(ordinal);
+	}
+
+private:
+	/// held devices
+	std::set<std::size_t> held_;
+	/// protects held_
+	std::mutex mutex_;
+};
+
+inline held_device_locks& get_held_device_locks()
+{
+	static held_device_locks h;
+	return h;
+}
+
+} // namespace detail
+
 /// create a device_lock
 inline device_lock create_device_lock(std::size_t ordinal)
 {
+	// devices held by this process are not free
+	if (!detail::get_held_device_locks().acquire(ordinal)) {
+		return boost::none;
+	}
+
 	// get the file-name
 	auto fname = get_lockfile_name(ordinal);
 
@@ -53,6 +103,7 @@ inline device_lock create_device_lock(std::size_t ordinal)
 	try {
 		std::ofstream fhandle(fname.c_str());	
 	} catch (...) {
+		detail::get_held_device_locks().release(ordinal);
 		return boost::none;
 	}
 
@@ -61,24 +112,40 @@ inline device_lock create_device_lock(std::size_t ordinal)
 		boost::filesystem::permissions(fname, 
 				boost::filesystem::all_all);
 	} catch (...) {
+		detail::get_held_device_locks().release(ordinal);
 		return boost::none;
 	}
 
-	// lock the file
-	auto flock = std::make_shared<boost::interprocess::file_lock>(
-			fname.c_str());
+	// lock the file, the device is released when the file is closed
+	std::shared_ptr<boost::interprocess::file_lock> flock;
 	try {
+		flock = std::shared_ptr<boost::interprocess::file_lock>(
+			new boost::interprocess::file_lock(fname.c_str()),
+			[ordinal](boost::interprocess::file_lock* l) {
+				delete l;
+				detail::get_held_device_locks().release(
+					ordinal);
+			});
 		if (!flock->try_lock()) {
 			return boost::none;
 		}
 	} catch (...) {
+		if (!flock) {
+			detail::get_held_device_locks().release(ordinal);
+		}
 		return boost::none;
 	}
 	
-	// create the scoped_lock 
-	auto sflock = std::make_shared<boost::interprocess::scoped_lock<
+	// create the scoped_lock, it keeps the file_lock alive until it
+	// has unlocked it
+	auto sflock = std::shared_ptr<boost::interprocess::scoped_lock<
 					boost::interprocess::file_lock>
-				>(*flock);
+				>(new boost::interprocess::scoped_lock<
+					boost::interprocess::file_lock>(*flock),
+			[flock](boost::interprocess::scoped_lock<
+					boost::interprocess::file_lock>* l) {
+				delete l;
+			});
 	// and ship	
 	return std::make_pair(sflock, flock);
 }
@@ -0,0 +1,321 @@
+#ifndef AURA_DEVICE_SCHEDULER_HPP
+#define AURA_DEVICE_SCHEDULER_HPP
+
+#include <map>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/device_lock.hpp>
+#include <boost/aura/misc/now.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// measured throughput of a device
+struct device_rank
+{
+	inline device_rank() : ordinal(0), device_throughput(0.),
+		bus_throughput(0.) {}
+
+	/// device ordinal
+	std::size_t ordinal;
+	/// device name
+	std::string name;
+	/// driver version
+	std::string driver;
+	/// on-device copy throughput (MB/s, read + write)
+	double device_throughput;
+	/// host to device throughput (MB/s)
+	double bus_throughput;
+};
+
+/// devices with higher on-device throughput come first, then bus
+inline bool operator<(const device_rank& lhs, const device_rank& rhs)
+{
+	return std::make_tuple(-lhs.device_throughput, -lhs.bus_throughput,
+			lhs.ordinal) < std::make_tuple(-rhs.device_throughput,
+				-rhs.bus_throughput, rhs.ordinal);
+}
+
+/**
+ * file the probe results are cached in, AURA_DEVICE_PROBE_CACHE
+ * overrides the default file in the temporary directory
+ */
+inline boost::filesystem::path get_probe_cache_name()
+{
+	const char* e = std::getenv("AURA_DEVICE_PROBE_CACHE");
+	if (nullptr != e && 0 != *e) {
+		return boost::filesystem::path(e);
+	}
+	boost::filesystem::path p = boost::filesystem::temp_directory_path();
+	p /= std::string("AURA_device_probe_") + std::to_string(getuid());
+	return p;
+}
+
+namespace detail
+{
+
+inline std::tuple<const char*,const char*> get_probe_kernel()
+{
+	return std::make_tuple("device_probe_copy",
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void device_probe_copy(AURA_GLOBAL float* dst,
+			AURA_GLOBAL float* src,
+			unsigned long N)
+	{
+		AURA_INDEX i = get_mesh_id();
+		if (i < N) {
+			dst[i] = src[i];
+		}
+	}
+
+		)aura_kernel");
+}
+
+/**
+ * measure host to device and on-device copy throughput, this is a
+ * short version of bench/peak (tphtd and devcopy)
+ *
+ * @param ordinal device to probe
+ * @param bytes size of the transfers
+ */
+inline device_rank probe_device(std::size_t ordinal,
+		std::size_t bytes = AURA_DEVICE_PROBE_SIZE)
+{
+	const int runs = 8;
+	std::size_t n = bytes / sizeof(float);
+	device d((int)ordinal);
+	feed f(d);
+	device_array<float> a(n, d);
+	device_array<float> b(n, d);
+	std::vector<float> h(n, 1.0);
+
+	device_rank r;
+	r.ordinal = ordinal;
+	device_info di = device_get_info(d);
+	r.name = di.name;
+	r.driver = di.driver;
+
+	// warm up, first transfer may allocate
+	backend::copy(a.begin(), &h[0], n, f);
+	wait_for(f);
+	double t = now();
+	for (int i=0; i<runs; i++) {
+		backend::copy(a.begin(), &h[0], n, f);
+	}
+	wait_for(f);
+	r.bus_throughput = runs*bytes / (now() - t);
+
+	auto kernel_data = get_probe_kernel();
+	backend::kernel k = d.load_from_string(std::get<0>(kernel_data),
+			std::get<1>(kernel_data), AURA_BACKEND_COMPILE_FLAGS);
+	invoke(k, n, args(b.begin().get_base(), a.begin().get_base(), n), f);
+	wait_for(f);
+	t = now();
+	for (int i=0; i<runs; i++) {
+		invoke(k, n, args(b.begin().get_base(),
+					a.begin().get_base(), n), f);
+	}
+	wait_for(f);
+	r.device_throughput = 2.*runs*bytes / (now() - t);
+	return r;
+}
+
+/// the device with the ordinal of a probe result has the same name and driver
+inline bool probe_is_current(const device_rank& dr)
+{
+	try {
+		device d((int)dr.ordinal);
+		device_info di = device_get_info(d);
+		return dr.name == di.name && dr.driver == di.driver;
+	} catch (...) {
+		return false;
+	}
+}
+
+/**
+ * load cached probe results, the cache is discarded if the number of
+ * devices changed or if the name or driver version of a cached device
+ * differs from the device with that ordinal now
+ */
+inline std::map<std::size_t, device_rank> load_probe_cache(
+		const boost::filesystem::path& p, std::size_t count)
+{
+	std::map<std::size_t, device_rank> r;
+	std::ifstream in(p.c_str());
+	std::size_t c = 0;
+	if (!(in >> c) || c != count) {
+		return r;
+	}
+	std::string line;
+	std::getline(in, line);
+	while (std::getline(in, line)) {
+		std::istringstream is(line);
+		device_rank dr;
+		if (!(is >> dr.ordinal >> dr.device_throughput >>
+					dr.bus_throughput) || '\t' != is.get() ||
+				!std::getline(is, dr.driver, '\t')) {
+			continue;
+		}
+		std::getline(is, dr.name);
+		r[dr.ordinal] = dr;
+	}
+	for (auto& it : r) {
+		if (it.first >= count || !probe_is_current(it.second)) {
+			r.clear();
+			break;
+		}
+	}
+	return r;
+}
+
+/// store probe results, written to a temporary and renamed
+inline void store_probe_cache(const boost::filesystem::path& p,
+		std::size_t count, const std::map<std::size_t, device_rank>& ranks)
+{
+	boost::filesystem::path tmp = p;
+	tmp += std::string(".") + std::to_string(getpid());
+	try {
+		{
+			std::ofstream out(tmp.c_str());
+			out << count << "\n";
+			for (auto& it : ranks) {
+				out << it.second.ordinal << " " <<
+					it.second.device_throughput << " " <<
+					it.second.bus_throughput << "\t" <<
+					it.second.driver << "\t" <<
+					it.second.name << "\n";
+			}
+		}
+		boost::filesystem::rename(tmp, p);
+	} catch (...) {
+		// the cache is an optimization only
+		boost::system::error_code ec;
+		boost::filesystem::remove(tmp, ec);
+	}
+}
+
+} // namespace detail
+
+/**
+ * rank devices by measured throughput, best first
+ *
+ * devices that are not in the probe cache are probed if they can be
+ * locked (they are not used by another process), devices locked by
+ * others and not in the cache are ranked last
+ *
+ * @param cache file the probe results are cached in
+ */
+inline std::vector<device_rank> rank_devices(
+		const boost::filesystem::path& cache = get_probe_cache_name())
+{
+	std::size_t count = device_get_count();
+	auto ranks = detail::load_probe_cache(cache, count);
+	bool changed = false;
+	for (std::size_t i=0; i<count; i++) {
+		if (ranks.end() != ranks.find(i)) {
+			continue;
+		}
+		auto dl = create_device_lock(i);
+		if (!dl) {
+			continue;
+		}
+		ranks[i] = detail::probe_device(i);
+		changed = true;
+	}
+	if (changed) {
+		detail::store_probe_cache(cache, count, ranks);
+	}
+	std::vector<device_rank> r;
+	for (std::size_t i=0; i<count; i++) {
+		if (ranks.end() != ranks.find(i)) {
+			r.push_back(ranks[i]);
+		} else {
+			device_rank dr;
+			dr.ordinal = i;
+			r.push_back(dr);
+		}
+	}
+	std::sort(r.begin(), r.end());
+	return r;
+}
+
+/**
+ * acquire the n fastest devices that are not locked by another process
+ *
+ * devices are locked with the same file locks as
+ * create_device_exclusive, the locks are held until the devices are
+ * destroyed, devices are returned best first
+ *
+ * @param n number of devices
+ * @param cache file the probe results are cached in
+ * @throw std::runtime_error if less than n devices are free
+ */
+inline std::vector<device> acquire_devices(std::size_t n,
+		const boost::filesystem::path& cache = get_probe_cache_name())
+{
+	std::size_t count = device_get_count();
+	auto ranks = detail::load_probe_cache(cache, count);
+	bool changed = false;
+
+	// lock all free devices, probe while holding the lock
+	std::vector<std::pair<device_rank, device_lock> > free;
+	for (std::size_t i=0; i<count; i++) {
+		auto dl = create_device_lock(i);
+		if (!dl) {
+			continue;
+		}
+		if (ranks.end() == ranks.find(i)) {
+			ranks[i] = detail::probe_device(i);
+			changed = true;
+		}
+		free.push_back(std::make_pair(ranks[i], dl));
+	}
+	if (changed) {
+		detail::store_probe_cache(cache, count, ranks);
+	}
+	if (free.size() < n) {
+		throw std::runtime_error("not enough devices available");
+	}
+	std::sort(free.begin(), free.end(),
+		[](const std::pair<device_rank, device_lock>& lhs,
+			const std::pair<device_rank, device_lock>& rhs) {
+			return lhs.first < rhs.first;
+		});
+
+	// locks of devices not taken are released with free
+	std::vector<device> r;
+	r.reserve(n);
+	for (std::size_t i=0; i<n; i++) {
+		r.push_back(device(free[i].first.ordinal, free[i].second));
+	}
+	return r;
+}
+
+/// acquire the fastest device that is not locked by another process
+inline device acquire_device(
+		const boost::filesystem::path& cache = get_probe_cache_name())
+{
+	std::vector<device> r = acquire_devices(1, cache);
+	return boost::move(r[0]);
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_DEVICE_SCHEDULER_HPP
+
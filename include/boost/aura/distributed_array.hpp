@@ -0,0 +1,218 @@
+#ifndef AURA_DISTRIBUTED_ARRAY_HPP
+#define AURA_DISTRIBUTED_ARRAY_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <boost/move/move.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/bounds.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/device_group.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/**
+ * distributed_array class
+ *
+ * multi-dimensional array partitioned along the slowest dimension across
+ * the devices of a device_group, partition i lives on device i of the
+ * group, partitions of two arrays with the same bounds on the same
+ * group match
+ */
+template <typename T>
+class distributed_array
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(distributed_array)
+
+public:
+	typedef T value_type;
+
+	/// create empty array
+	inline explicit distributed_array() : group_(nullptr) {}
+
+	/**
+	 * create array
+	 *
+	 * @param b bounds of the whole array
+	 * @param g group the array is distributed across
+	 */
+	inline explicit distributed_array(const bounds& b, device_group& g) :
+		group_(&g), bounds_(b)
+	{
+		assert(b.size() > 0);
+		std::size_t slowest = b[b.size()-1];
+		std::size_t plane = product(b) / std::max<std::size_t>(1, slowest);
+		std::vector<std::size_t> planes = g.partition(slowest);
+		std::size_t offset = 0;
+		for (std::size_t i=0; i<g.size(); i++) {
+			bounds pb = b;
+			pb[pb.size()-1] = (std::int64_t)planes[i];
+			offsets_.push_back(offset);
+			partitions_.push_back(0 == planes[i] ?
+					device_array<T>() :
+					device_array<T>(pb, g.get_device(i)));
+			partition_bounds_.push_back(pb);
+			offset += planes[i] * plane;
+			// place pages on the node of a CPU sub-device
+			if (0 != planes[i] && g.get_device(i).is_cpu()) {
+				backend::first_touch(partitions_[i].begin(),
+						partitions_[i].size(), g.get_feed(i));
+			}
+		}
+	}
+
+	/**
+	 * move constructor, move array here, invalidate other
+	 *
+	 * @param a array to move here
+	 */
+	distributed_array(BOOST_RV_REF(distributed_array) a) :
+		group_(a.group_), bounds_(a.bounds_),
+		partitions_(std::move(a.partitions_)),
+		partition_bounds_(std::move(a.partition_bounds_)),
+		offsets_(std::move(a.offsets_))
+	{
+		a.group_ = nullptr;
+	}
+
+	/**
+	 * move assignment, move array here, invalidate other
+	 *
+	 * @param a array to move here
+	 */
+	distributed_array& operator=(BOOST_RV_REF(distributed_array) a)
+	{
+		group_ = a.group_;
+		bounds_ = a.bounds_;
+		partitions_ = std::move(a.partitions_);
+		partition_bounds_ = std::move(a.partition_bounds_);
+		offsets_ = std::move(a.offsets_);
+		a.group_ = nullptr;
+		return *this;
+	}
+
+	/// bounds of the whole array
+	const bounds& get_bounds() const
+	{
+		return bounds_;
+	}
+
+	/// number of elements of the whole array
+	std::size_t size() const
+	{
+		return product(bounds_);
+	}
+
+	/// group the array is distributed across
+	device_group& get_group() const
+	{
+		return *group_;
+	}
+
+	/// number of partitions (size of the group)
+	std::size_t num_partitions() const
+	{
+		return partitions_.size();
+	}
+
+	/// partition i, empty if it holds no planes
+	device_array<T>& get_partition(std::size_t i)
+	{
+		return partitions_[i];
+	}
+
+	const device_array<T>& get_partition(std::size_t i) const
+	{
+		return partitions_[i];
+	}
+
+	/// bounds of partition i
+	const bounds& get_partition_bounds(std::size_t i) const
+	{
+		return partition_bounds_[i];
+	}
+
+	/// offset of the first element of partition i in the whole array
+	std::size_t get_partition_offset(std::size_t i) const
+	{
+		return offsets_[i];
+	}
+
+	/// true if partition i holds no elements
+	bool is_empty(std::size_t i) const
+	{
+		return 0 == product(partition_bounds_[i]);
+	}
+
+	/**
+	 * copy host data to the partitions, copies are enqueued in the
+	 * feeds of the group
+	 */
+	void scatter(const T* src)
+	{
+		for (std::size_t i=0; i<partitions_.size(); i++) {
+			if (is_empty(i)) {
+				continue;
+			}
+			backend::copy(partitions_[i].begin(), src + offsets_[i],
+					partitions_[i].size(), group_->get_feed(i));
+		}
+	}
+
+	/**
+	 * copy the partitions to host memory, copies are enqueued in the
+	 * feeds of the group
+	 */
+	void gather(T* dst)
+	{
+		for (std::size_t i=0; i<partitions_.size(); i++) {
+			if (is_empty(i)) {
+				continue;
+			}
+			backend::copy(dst + offsets_[i], partitions_[i].begin(),
+					partitions_[i].size(), group_->get_feed(i));
+		}
+	}
+
+private:
+	/// group the array is distributed across
+	device_group* group_;
+	/// bounds of the whole array
+	bounds bounds_;
+	/// one array per device
+	std::vector<device_array<T> > partitions_;
+	/// bounds of the partitions
+	std::vector<bounds> partition_bounds_;
+	/// element offsets of the partitions
+	std::vector<std::size_t> offsets_;
+};
+
+/**
+ * create an array on device i of a group and first touch it in the feed
+ * of the device, on a NUMA device group the memory of the array is
+ * allocated on the node of sub-device i
+ *
+ * @param b bounds of the array
+ * @param g group
+ * @param i device of the group the array is placed on
+ */
+template <typename T>
+device_array<T> place_array(const bounds& b, device_group& g,
+		std::size_t i)
+{
+	device_array<T> a(b, g.get_device(i));
+	backend::first_touch(a.begin(), a.size(), g.get_feed(i));
+	return a;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_DISTRIBUTED_ARRAY_HPP
+
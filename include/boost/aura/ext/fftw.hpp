@@ -1,6 +1,10 @@
 #ifndef AURA_BENCH_FFT_FFTW_HPP
 #define AURA_BENCH_FFT_FFTW_HPP
 
+#include <array>
+#include <cassert>
+#include <complex>
+#include <cstddef>
 #include <fftw3.h>
 #include <boost/move/move.hpp>
 #include <boost/aura/detail/svec.hpp>
@@ -19,12 +23,17 @@ using ::boost::aura::bounds;
 
 /**
  * fft class
+ *
+ * dimension 0 of the bounds and of the embeds is the fastest changing
+ * one, as in the cuFFT and clFFT wrappers, the wrapper reverses them
+ * for FFTW (row-major, slowest first)
  */
 class fft
 {
 
 private:
 	BOOST_MOVABLE_BUT_NOT_COPYABLE(fft)
+	typedef std::array<std::ptrdiff_t, 3> split_key;
 
 public:
 
@@ -49,7 +58,10 @@ public:
 		handle_single_fwd_(nullptr),
 		handle_single_inv_(nullptr),
 		handle_double_fwd_(nullptr),
-		handle_double_inv_(nullptr)
+		handle_double_inv_(nullptr),
+		handle_split_fwd_(nullptr),
+		handle_split_inv_(nullptr),
+		scale_fwd_(1.), scale_inv_(1.), centered_(false)
 	{}
 
 	/**
@@ -65,6 +77,9 @@ public:
 		handle_single_inv_(nullptr),
 		handle_double_fwd_(nullptr),
 		handle_double_inv_(nullptr),
+		handle_split_fwd_(nullptr),
+		handle_split_inv_(nullptr),
+		scale_fwd_(1.), scale_inv_(1.), centered_(false),
 		type_(type),
 		dim_(dim), batch_(batch)
 	{
@@ -86,6 +101,9 @@ public:
 		handle_single_inv_(nullptr),
 		handle_double_fwd_(nullptr),
 		handle_double_inv_(nullptr),
+		handle_split_fwd_(nullptr),
+		handle_split_inv_(nullptr),
+		scale_fwd_(1.), scale_inv_(1.), centered_(false),
 		type_(type),
 		dim_(dim), 
 		batch_(batch)
@@ -107,9 +125,13 @@ public:
 		handle_single_inv_(nullptr),
 		handle_double_fwd_(nullptr),
 		handle_double_inv_(nullptr),
+		handle_split_fwd_(nullptr),
+		handle_split_inv_(nullptr),
+		scale_fwd_(1.), scale_inv_(1.), centered_(false),
 		type_(type),
 		dim_(std::get<0>(dim)), 
-		batch_(std::max(1, product(std::get<1>(dim))))
+		batch_(std::max<std::int64_t>(1,
+			product(std::get<1>(dim))))
 	{
 		initialize(iembed, istride, idist, oembed, ostride, odist);
 	}
@@ -124,6 +146,12 @@ public:
 		handle_single_inv_(f.handle_single_inv_),
 		handle_double_fwd_(f.handle_double_fwd_),
 		handle_double_inv_(f.handle_double_inv_),
+		handle_split_fwd_(f.handle_split_fwd_),
+		handle_split_inv_(f.handle_split_inv_),
+		split_fwd_key_(f.split_fwd_key_),
+		split_inv_key_(f.split_inv_key_),
+		scale_fwd_(f.scale_fwd_), scale_inv_(f.scale_inv_),
+		centered_(f.centered_),
 		type_(f.type_),
 		dim_(f.dim_),
 		batch_(f.batch_)
@@ -132,6 +160,8 @@ public:
 		f.handle_single_inv_ = nullptr;
 		f.handle_double_fwd_ = nullptr;
 		f.handle_double_inv_ = nullptr;
+		f.handle_split_fwd_ = nullptr;
+		f.handle_split_inv_ = nullptr;
 	}
 
 	/**
@@ -147,6 +177,13 @@ public:
 		handle_single_inv_ = f.handle_single_inv_;
 		handle_double_fwd_ = f.handle_double_fwd_;
 		handle_double_inv_ = f.handle_double_inv_;
+		handle_split_fwd_ = f.handle_split_fwd_;
+		handle_split_inv_ = f.handle_split_inv_;
+		split_fwd_key_ = f.split_fwd_key_;
+		split_inv_key_ = f.split_inv_key_;
+		scale_fwd_ = f.scale_fwd_;
+		scale_inv_ = f.scale_inv_;
+		centered_ = f.centered_;
 		type_ = f.type_;
 		dim_ = f.dim_;
 		batch_ = f.batch_;
@@ -155,6 +192,8 @@ public:
 		f.handle_single_inv_ = nullptr;
 		f.handle_double_fwd_ = nullptr;
 		f.handle_double_inv_ = nullptr;
+		f.handle_split_fwd_ = nullptr;
+		f.handle_split_inv_ = nullptr;
 
 		return *this;
 	}
@@ -260,30 +299,70 @@ public:
 		return is_c2r(type_);
 	}
 
+	/**
+	 * set scale factor applied to the result of the transform
+	 *
+	 * the default is 1 for both directions (FFTW does not normalize),
+	 * scaling requires the default output layout (ostride and odist)
+	 *
+	 * @param dir direction the scale factor is used for
+	 * @param scale scale factor
+	 */
+	void set_scale(direction dir, float scale)
+	{
+		if (fwd == dir) {
+			scale_fwd_ = scale;
+		} else {
+			scale_inv_ = scale;
+		}
+	}
+
+	/**
+	 * calculate centered transforms, the origin of both signal and
+	 * spectrum is in the center: fftshift(fft(ifftshift(x)))
+	 *
+	 * supported for c2c with even (or 1) sizes in all dimensions and
+	 * the default output layout (ostride and odist)
+	 */
+	void set_centered(bool centered)
+	{
+		assert(!centered || c2c == type_);
+		for (std::size_t i=0; i<dim_.size(); i++) {
+			assert(!centered || 1 == dim_[i] || 0 == dim_[i] % 2);
+		}
+		centered_ = centered;
+	}
+
+	/// true if transforms are centered
+	bool is_centered() const
+	{
+		return centered_;
+	}
+
 private:
 	inline void initialize(const fft_embed& iembed = fft_embed(),
 	                std::size_t istride = 1, std::size_t idist = 0,
 	                const fft_embed& oembed = fft_embed(),
 	                std::size_t ostride = 1, std::size_t odist = 0)
 	{
+		// FFTW expects row-major dimensions (slowest first)
+		fft_embed n = reverse(dim_);
+		fft_embed rie = reverse(iembed);
+		fft_embed roe = reverse(oembed);
 		if (is_single(type_)) {
 			if (is_c2c(type_)) {
 				handle_single_fwd_ = 
 					fftwf_plan_many_dft(
 						dim_.size(), 
-						const_cast<int*>(&dim_[0]), 
+						&n[0],
 						batch_,
 						NULL, 
-						0 == iembed.size() ? NULL : 
-							const_cast<int*>(
-								&iembed[0]),
+						0 == rie.size() ? NULL : &rie[0],
 						istride,
 						0 == idist ? product(dim_) : 
 							idist,
 						NULL,
-						0 == oembed.size() ? NULL : 
-							const_cast<int*>(
-								&oembed[0]),
+						0 == roe.size() ? NULL : &roe[0],
 						ostride,
 						0 == odist ? product(dim_) : 
 							odist,
@@ -293,24 +372,25 @@ private:
 				handle_single_inv_ = 
 					fftwf_plan_many_dft(
 						dim_.size(), 
-						const_cast<int*>(&dim_[0]), 
+						&n[0],
 						batch_,
 						NULL, 
-						0 == iembed.size() ? NULL : 
-							const_cast<int*>(
-								&iembed[0]),
+						0 == rie.size() ? NULL : &rie[0],
 						istride,
 						0 == idist ? product(dim_) : 
 							idist,
 						NULL,
-						0 == oembed.size() ? NULL : 
-							const_cast<int*>(
-								&oembed[0]),
+						0 == roe.size() ? NULL : &roe[0],
 						ostride,
 						0 == odist ? product(dim_) : 
 							odist,
 						inv,
 						FFTW_ESTIMATE|FFTW_UNALIGNED);
+			} else {
+				initialize_real(NULL, NULL,
+						FFTW_ESTIMATE|FFTW_UNALIGNED,
+						iembed, istride, idist,
+						oembed, ostride, odist);
 			}
 		}
 	}
@@ -323,24 +403,24 @@ private:
 	                std::size_t ostride = 1, std::size_t odist = 0)
 	{
 		typedef fftwf_complex* sptr;
+		// FFTW expects row-major dimensions (slowest first)
+		fft_embed n = reverse(dim_);
+		fft_embed rie = reverse(iembed);
+		fft_embed roe = reverse(oembed);
 		if (is_single(type_)) {
 			if (is_c2c(type_)) {
 				handle_single_fwd_ = 
 					fftwf_plan_many_dft(
 						dim_.size(), 
-						const_cast<int*>(&dim_[0]), 
+						&n[0],
 						batch_,
 						reinterpret_cast<sptr>(&(*in)),
-						0 == iembed.size() ? NULL : 
-							const_cast<int*>(
-								&iembed[0]),
+						0 == rie.size() ? NULL : &rie[0],
 						istride,
 						0 == idist ? product(dim_) : 
 							idist,
 						reinterpret_cast<sptr>(&(*out)), 
-						0 == oembed.size() ? NULL : 
-							const_cast<int*>(
-								&oembed[0]),
+						0 == roe.size() ? NULL : &roe[0],
 						ostride,
 						0 == odist ? product(dim_) : 
 							odist,
@@ -350,28 +430,239 @@ private:
 				handle_single_inv_ = 
 					fftwf_plan_many_dft(
 						dim_.size(), 
-						const_cast<int*>(&dim_[0]), 
+						&n[0],
 						batch_,
 						reinterpret_cast<sptr>(&(*in)),
-						0 == iembed.size() ? NULL : 
-							const_cast<int*>(
-								&iembed[0]),
+						0 == rie.size() ? NULL : &rie[0],
 						istride,
 						0 == idist ? product(dim_) : 
 							idist,
 						reinterpret_cast<sptr>(&(*out)),
-						0 == oembed.size() ? NULL : 
-							const_cast<int*>(
-								&oembed[0]),
+						0 == roe.size() ? NULL : &roe[0],
 						ostride,
 						0 == odist ? product(dim_) : 
 							odist,
 						inv,
 						FFTW_PATIENT);
+			} else if (is_r2c(type_)) {
+				initialize_real(
+						reinterpret_cast<float*>(&(*in)),
+						reinterpret_cast<sptr>(&(*out)),
+						FFTW_MEASURE,
+						iembed, istride, idist,
+						oembed, ostride, odist);
+			} else {
+				initialize_real(
+						reinterpret_cast<float*>(&(*out)),
+						reinterpret_cast<sptr>(&(*in)),
+						FFTW_MEASURE,
+						iembed, istride, idist,
+						oembed, ostride, odist);
 			}
 		}
 	}
 
+	/**
+	 * create single precision real plan (r2c or c2r)
+	 *
+	 * FFTW expects row-major dimensions, the packed dimension is the
+	 * last one, dimension 0 of our bounds is the fastest and packed
+	 * (see fft_hermitian_bounds), so dimensions and embeds are reversed
+	 *
+	 * @param real real data (can be NULL for estimated plans)
+	 * @param cplx packed complex data (can be NULL for estimated plans)
+	 *
+	 * FFTW plans an in-place transform (padded rows) if both arrays are
+	 * the same, estimated plans are therefore created with distinct
+	 * scratch arrays, they are executed out-of-place on new arrays
+	 */
+	inline void initialize_real(float* real, fftwf_complex* cplx,
+			unsigned flags,
+			const fft_embed& iembed, std::size_t istride,
+			std::size_t idist,
+			const fft_embed& oembed, std::size_t ostride,
+			std::size_t odist)
+	{
+		fft_embed n = reverse(dim_);
+		fft_embed rie = reverse(iembed);
+		fft_embed roe = reverse(oembed);
+		int* ie = 0 == rie.size() ? NULL : &rie[0];
+		int* oe = 0 == roe.size() ? NULL : &roe[0];
+		int real_dist = (int)product(dim_);
+		int complex_dist = (int)product(fft_hermitian_bounds(dim_));
+
+		float* real_scratch = NULL;
+		fftwf_complex* cplx_scratch = NULL;
+		if (NULL == real || NULL == cplx) {
+			std::size_t rdist = is_r2c() ? idist : odist;
+			std::size_t rstride = is_r2c() ? istride : ostride;
+			std::size_t cdist = is_r2c() ? odist : idist;
+			std::size_t cstride = is_r2c() ? ostride : istride;
+			real_scratch = (float*)fftwf_malloc(sizeof(float) *
+					(0 == rdist ? real_dist : rdist) *
+					rstride * batch_);
+			cplx_scratch = (fftwf_complex*)fftwf_malloc(
+					sizeof(fftwf_complex) *
+					(0 == cdist ? complex_dist : cdist) *
+					cstride * batch_);
+			real = real_scratch;
+			cplx = cplx_scratch;
+		}
+
+		if (is_r2c(type_)) {
+			handle_single_fwd_ =
+				fftwf_plan_many_dft_r2c(
+					n.size(), &n[0], batch_,
+					real, ie, istride,
+					0 == idist ? real_dist : idist,
+					cplx, oe, ostride,
+					0 == odist ? complex_dist : odist,
+					flags);
+		} else if (is_c2r(type_)) {
+			handle_single_inv_ =
+				fftwf_plan_many_dft_c2r(
+					n.size(), &n[0], batch_,
+					cplx, ie, istride,
+					0 == idist ? complex_dist : idist,
+					real, oe, ostride,
+					0 == odist ? real_dist : odist,
+					flags);
+		}
+
+		if (NULL != real_scratch) {
+			fftwf_free(real_scratch);
+			fftwf_free(cplx_scratch);
+		}
+	}
+
+	/// reverse order of dimensions
+	template <typename T>
+	static fft_embed reverse(const T& b)
+	{
+		fft_embed r;
+		for (std::size_t i=b.size(); i>0; i--) {
+			r.push_back(b[i-1]);
+		}
+		return r;
+	}
+
+	/**
+	 * get plan for planar (split) complex data
+	 *
+	 * plans are created on first use with the arrays of that call
+	 * (FFTW_ESTIMATE does not touch them), FFTW requires in-place
+	 * property and the distance between real and imaginary part
+	 * to be the same when a plan is executed on new arrays, the plan
+	 * is recreated if they change
+	 *
+	 * FFTW has no direction for split transforms, the inverse
+	 * transform swaps real and imaginary parts of input and output
+	 */
+	fftwf_plan get_split_plan(float* ri, float* ii, float* ro, float* io,
+			direction dir)
+	{
+		assert(c2c == type_);
+		fftwf_plan& p = fwd == dir ?
+			handle_split_fwd_ : handle_split_inv_;
+		split_key& key = fwd == dir ?
+			split_fwd_key_ : split_inv_key_;
+		split_key k = {{ ri == ro, ii - ri, io - ro }};
+		if (nullptr != p && key == k) {
+			return p;
+		}
+		if (nullptr != p) {
+			fftwf_destroy_plan(p);
+		}
+		// guru dimensions are ordered slowest first
+		fftwf_iodim dims[3];
+		int stride = 1;
+		int rank = dim_.size();
+		for (int i=0; i<rank; i++) {
+			dims[rank-1-i].n = dim_[i];
+			dims[rank-1-i].is = stride;
+			dims[rank-1-i].os = stride;
+			stride *= dim_[i];
+		}
+		fftwf_iodim howmany;
+		howmany.n = batch_;
+		howmany.is = stride;
+		howmany.os = stride;
+		p = fftwf_plan_guru_split_dft(rank, dims, 1, &howmany,
+				ri, ii, ro, io,
+				FFTW_ESTIMATE|FFTW_UNALIGNED);
+		key = k;
+		return p;
+	}
+
+	/// apply scale factor to the planar result of a transform
+	void finish(float* re, float* im, direction dir)
+	{
+		assert(!centered_);
+		float scale = fwd == dir ? scale_fwd_ : scale_inv_;
+		if (1. == scale) {
+			return;
+		}
+		std::size_t n = product(dim_) * batch_;
+		for (std::size_t i=0; i<n; i++) {
+			re[i] *= scale;
+			im[i] *= scale;
+		}
+	}
+
+	/**
+	 * shift and scale the result of a transform in place
+	 *
+	 * fft((-1)^i x)[k] = X[k+N/2], with j = k+N/2 the centered spectrum
+	 * is Z[k] = (-1)^j X[j], elements k and j are swapped and multiplied
+	 * with the checkerboard and the scale factor in a single pass
+	 */
+	void shift(std::complex<float>* data, float scale)
+	{
+		std::size_t n0 = dim_[0];
+		std::size_t n1 = dim_.size() > 1 ? dim_[1] : 1;
+		std::size_t n2 = dim_.size() > 2 ? dim_[2] : 1;
+		std::size_t half = n0*n1*n2/2;
+		for (std::size_t b=0; b<batch_; b++) {
+			std::complex<float>* v = data + b*2*half;
+			for (std::size_t r=0; r<half; r++) {
+				std::size_t i0 = r % n0;
+				std::size_t i1 = (r / n0) % n1;
+				std::size_t i2 = r / (n0*n1);
+				std::size_t j0 = (i0 + n0/2) % n0;
+				std::size_t j1 = (i1 + n1/2) % n1;
+				std::size_t j2 = (i2 + n2/2) % n2;
+				std::size_t j = j0 + n0*(j1 + n1*j2);
+				float si = ((i0+i1+i2) & 1) ? -scale : scale;
+				float sj = ((j0+j1+j2) & 1) ? -scale : scale;
+				std::complex<float> x = v[r];
+				v[r] = sj*v[j];
+				v[j] = si*x;
+			}
+		}
+	}
+
+	/// apply shift and scale factor to the result of a transform
+	template <typename T>
+	void finish(T* data, direction dir)
+	{
+		float scale = fwd == dir ? scale_fwd_ : scale_inv_;
+		if (centered_) {
+			shift(reinterpret_cast<std::complex<float>*>(data),
+					scale);
+			return;
+		}
+		if (1. == scale) {
+			return;
+		}
+		// number of outputs, complex side of real transforms is packed
+		std::size_t n = (is_r2c() ?
+				product(fft_hermitian_bounds(dim_)) :
+				product(dim_)) * batch_;
+		for (std::size_t i=0; i<n; i++) {
+			data[i] *= scale;
+		}
+	}
+
 	/// finalize object (called from dtor and move assign)
 	void finalize()
 	{
@@ -388,6 +679,12 @@ private:
 		if (handle_double_inv_ != nullptr) {
 			fftw_destroy_plan(handle_double_inv_);
 		}
+		if (handle_split_fwd_ != nullptr) {
+			fftwf_destroy_plan(handle_split_fwd_);
+		}
+		if (handle_split_inv_ != nullptr) {
+			fftwf_destroy_plan(handle_split_inv_);
+		}
 	}
 
 private:
@@ -396,6 +693,18 @@ private:
 	fftwf_plan handle_single_inv_;
 	fftw_plan handle_double_fwd_;
 	fftw_plan handle_double_inv_;
+	/// planar (split) complex plans, created on first use
+	fftwf_plan handle_split_fwd_;
+	fftwf_plan handle_split_inv_;
+	/// in-place property and array offsets the split plans were made for
+	split_key split_fwd_key_;
+	split_key split_inv_key_;
+
+	/// scale factor of forward and inverse transforms
+	float scale_fwd_;
+	float scale_inv_;
+	/// centered transforms
+	bool centered_;
 
 	/// fft type
 	type type_;
@@ -408,6 +717,12 @@ private:
 	friend void fft_forward(IT1 in, IT2 out, fft& plan);
 	template <typename IT1, typename IT2>
 	friend void fft_inverse(IT1 in, IT2 out, fft& plan);
+	template <typename IT1, typename IT2>
+	friend void fft_forward(IT1 in_re, IT1 in_im,
+			IT2 out_re, IT2 out_im, fft& plan);
+	template <typename IT1, typename IT2>
+	friend void fft_inverse(IT1 in_re, IT1 in_im,
+			IT2 out_re, IT2 out_im, fft& plan);
 };
 
 /// initialize fft library
@@ -439,7 +754,13 @@ void fft_forward(IT1 in, IT2 out, fft& plan)
 			fftwf_execute_dft(plan.handle_single_fwd_,
 				(fftwf_complex*)(&(*in)),
 				reinterpret_cast<fftwf_complex*>(&(*out)));
+		} else if (plan.is_r2c()) {
+			fftwf_execute_dft_r2c(plan.handle_single_fwd_,
+				(float*)(&(*in)),
+				reinterpret_cast<fftwf_complex*>(&(*out)));
 		}
+		plan.finish(reinterpret_cast<std::complex<float>*>(&(*out)),
+				fft::fwd);
 	}
 }
 
@@ -460,10 +781,67 @@ void fft_inverse(IT1 in, IT2 out, fft& plan)
 			fftwf_execute_dft(plan.handle_single_inv_,
 				(fftwf_complex*)(&(*in)), 
 				reinterpret_cast<fftwf_complex*>(&(*out)));
+		} else if (plan.is_c2r()) {
+			// FFTW overwrites the input of out-of-place c2r
+			fftwf_execute_dft_c2r(plan.handle_single_inv_,
+				(fftwf_complex*)(&(*in)),
+				reinterpret_cast<float*>(&(*out)));
+		}
+		if (plan.is_c2r()) {
+			plan.finish(reinterpret_cast<float*>(&(*out)),
+					fft::inv);
+		} else {
+			plan.finish(reinterpret_cast<std::complex<float>*>(
+						&(*out)), fft::inv);
 		}
 	}
 }
 
+/**
+ * @brief calculate forward fourier transform of planar complex data
+ *
+ * @param in_re real part of input of fourier transform
+ * @param in_im imaginary part of input of fourier transform
+ * @param out_re real part of result of fourier transform
+ * @param out_im imaginary part of result of fourier transform
+ * @param plan (c2c) that is used to calculate the fourier transform
+ */
+template <typename IT1, typename IT2>
+void fft_forward(IT1 in_re, IT1 in_im, IT2 out_re, IT2 out_im, fft& plan)
+{
+	float* ri = (float*)(&(*in_re));
+	float* ii = (float*)(&(*in_im));
+	float* ro = reinterpret_cast<float*>(&(*out_re));
+	float* io = reinterpret_cast<float*>(&(*out_im));
+	fftwf_execute_split_dft(
+			plan.get_split_plan(ri, ii, ro, io, fft::fwd),
+			ri, ii, ro, io);
+	plan.finish(ro, io, fft::fwd);
+}
+
+/**
+ * @brief calculate inverse fourier transform of planar complex data
+ *
+ * @param in_re real part of input of fourier transform
+ * @param in_im imaginary part of input of fourier transform
+ * @param out_re real part of result of fourier transform
+ * @param out_im imaginary part of result of fourier transform
+ * @param plan (c2c) that is used to calculate the fourier transform
+ */
+template <typename IT1, typename IT2>
+void fft_inverse(IT1 in_re, IT1 in_im, IT2 out_re, IT2 out_im, fft& plan)
+{
+	float* ri = (float*)(&(*in_re));
+	float* ii = (float*)(&(*in_im));
+	float* ro = reinterpret_cast<float*>(&(*out_re));
+	float* io = reinterpret_cast<float*>(&(*out_im));
+	// swapping real and imaginary part reverses the direction
+	fftwf_execute_split_dft(
+			plan.get_split_plan(ii, ri, io, ro, fft::inv),
+			ii, ri, io, ro);
+	plan.finish(ro, io, fft::inv);
+}
+
 } // fftw 
 } // aura
 } // boost
@@ -5,6 +5,7 @@
 #include <boost/aura/device_array.hpp>
 #include <boost/aura/bounds.hpp>
 #include <boost/aura/math/basic/mul.hpp>
+#include <boost/aura/math/planar.hpp>
 
 namespace boost {
 namespace aura {
@@ -22,58 +23,78 @@ template <typename T1, typename T2>
 void fft_forward(const device_array<T1> & src, device_array<T2> & dst,
 		fft& plan, const feed& f)
 {
-	fft_forward<T1, T2>(src.begin(), dst.begin(), plan, f);
+	fft_forward<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_inverse(const device_array<T1> & src, device_array<T2> & dst,
 		fft& plan, const feed& f)
 {
-	fft_inverse<T1, T2>(src.begin(), dst.begin(), plan, f);
+	fft_inverse<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_forward(const device_range<T1> & src, device_range<T2> & dst,
 		fft& plan, const feed& f)
 {
-	fft_forward<T1, T2>(src.begin(), dst.begin(), plan, f);
+	fft_forward<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_inverse(const device_range<T1> & src, device_range<T2> & dst,
 		fft& plan, const feed& f)
 {
-	fft_inverse<T1, T2>(src.begin(), dst.begin(), plan, f);
+	fft_inverse<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_forward(const device_range<T1> & src, device_array<T2> & dst,
         fft& plan, const feed& f)
 {
-    fft_forward<T1, T2>(src.begin(), dst.begin(), plan, f);
+    fft_forward<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_inverse(const device_range<T1> & src, device_array<T2> & dst,
         fft& plan, const feed& f)
 {
-    fft_inverse<T1, T2>(src.begin(), dst.begin(), plan, f);
+    fft_inverse<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_forward(const device_array<T1> & src, device_range<T2> & dst,
         fft& plan, const feed& f)
 {
-    fft_forward<T1, T2>(src.begin(), dst.begin(), plan, f);
+    fft_forward<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
 template <typename T1, typename T2>
 void fft_inverse(const device_array<T1> & src, device_range<T2> & dst,
         fft& plan, const feed& f)
 {
-    fft_inverse<T1, T2>(src.begin(), dst.begin(), plan, f);
+    fft_inverse<T2, T1>(src.begin(), dst.begin(), plan, f);
 }
 
+#ifdef AURA_BACKEND_OPENCL
+/// forward transform of planar complex data (plan must be planar)
+template <typename DeviceRangeType1, typename DeviceRangeType2>
+void fft_forward(math::planar<DeviceRangeType1> src,
+		math::planar<DeviceRangeType2> dst, fft& plan, const feed& f)
+{
+	fft_forward(src.real->begin(), src.imag->begin(),
+			dst.real->begin(), dst.imag->begin(), plan, f);
+}
+
+/// inverse transform of planar complex data (plan must be planar)
+template <typename DeviceRangeType1, typename DeviceRangeType2>
+void fft_inverse(math::planar<DeviceRangeType1> src,
+		math::planar<DeviceRangeType2> dst, fft& plan, const feed& f)
+{
+	fft_inverse(src.real->begin(), src.imag->begin(),
+			dst.real->begin(), dst.imag->begin(), plan, f);
+}
+#endif // AURA_BACKEND_OPENCL
+
 template <typename deviceRangeType1, typename deviceRangeType2>
 void fft_forward_scaled(const deviceRangeType1 & src, deviceRangeType2 & dst,
         fft& plan, feed& f)
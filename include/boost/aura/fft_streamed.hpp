@@ -0,0 +1,322 @@
+#ifndef AURA_FFT_STREAMED_HPP
+#define AURA_FFT_STREAMED_HPP
+
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <algorithm>
+#include <boost/move/move.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/bounds.hpp>
+#include <boost/aura/math/complex.hpp>
+
+namespace boost {
+namespace aura {
+
+using backend::fft;
+
+namespace detail
+{
+
+inline std::tuple<const char*,const char*> get_fft_streamed_transpose_kernel()
+{
+	return std::make_tuple("fft_streamed_transpose_cfloat",
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void fft_streamed_transpose_cfloat(
+			AURA_GLOBAL cfloat* dst,
+			AURA_GLOBAL cfloat* src,
+			unsigned long rows,
+			unsigned long cols)
+	{
+		AURA_INDEX id = get_mesh_id();
+		if (id < rows*cols) {
+			dst[(id % cols) * rows + id / cols] = src[id];
+		}
+	}
+
+		)aura_kernel");
+}
+
+} // namespace detail
+
+/**
+ * fft_streamed class
+ *
+ * complex to complex fourier transform of a multi-dimensional volume
+ * in host memory that does not fit into device memory
+ *
+ * the transform is decomposed into two passes:
+ * 1) slabs of planes along the slowest dimension are copied to the
+ *    device, all but the slowest dimension is transformed in a batch
+ *    and the slab is copied back
+ * 2) pencils along the slowest dimension are gathered from host memory
+ *    in one strided copy, transposed, transformed in a batch, transposed
+ *    back and scattered in one strided copy
+ *
+ * consecutive slabs/pencils alternate between two feeds, the transfer of
+ * slab k+1 overlaps with the transform of slab k
+ */
+class fft_streamed
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(fft_streamed)
+
+public:
+	typedef math::cfloat value_type;
+
+	/// create empty object
+	inline explicit fft_streamed() : device_(nullptr) {}
+
+	/**
+	 * create streamed fft
+	 *
+	 * @param d device the fft is calculated on
+	 * @param dim size of the volume (2 or 3 dimensions, 0 is fastest)
+	 * @param device_memory number of bytes of device memory the
+	 * transform may use for slabs and pencils (fft temporary buffers
+	 * are not included)
+	 *
+	 * @throw std::invalid_argument if a single plane or a single pencil
+	 * does not fit into device_memory
+	 */
+	inline explicit fft_streamed(device & d, const bounds & dim,
+			std::size_t device_memory) :
+		device_(&d), dim_(dim)
+	{
+		assert(dim_.size() == 2 || dim_.size() == 3);
+		slowest_ = dim_[dim_.size()-1];
+		bounds inner;
+		for (std::size_t i=0; i<dim_.size()-1; i++) {
+			inner.push_back(dim_[i]);
+		}
+		inner_ = product(inner);
+
+		// 4 buffers: 2 feeds, pass 2 transposes out-of-place
+		std::size_t elements = device_memory / (4*sizeof(value_type));
+		slab_ = std::min(slowest_, elements / inner_);
+		pencil_ = std::min(inner_, elements / slowest_);
+		// a single plane and a single pencil must fit
+		if (0 == slab_ || 0 == pencil_) {
+			throw std::invalid_argument("fft_streamed: a plane or "
+					"a pencil does not fit into device memory");
+		}
+
+		std::size_t size = std::max(slab_*inner_, pencil_*slowest_);
+		for (std::size_t i=0; i<2; i++) {
+			feeds_[i] = feed(d);
+			buffers_[i][0] = device_array<value_type>(size, d);
+			buffers_[i][1] = device_array<value_type>(size, d);
+
+			// plans are not shared between feeds, a plan may own
+			// a work area that concurrent transforms would clobber
+			slab_plan_[i] = fft(d, feeds_[i], inner,
+					fft::type::c2c, slab_);
+			if (0 != slowest_ % slab_) {
+				slab_rest_plan_[i] = fft(d, feeds_[i], inner,
+						fft::type::c2c, slowest_ % slab_);
+			}
+			pencil_plan_[i] = fft(d, feeds_[i],
+					bounds((std::int64_t)slowest_),
+					fft::type::c2c, pencil_);
+			if (0 != inner_ % pencil_) {
+				pencil_rest_plan_[i] = fft(d, feeds_[i],
+						bounds((std::int64_t)slowest_),
+						fft::type::c2c, inner_ % pencil_);
+			}
+		}
+		wait_for(feeds_[0]);
+		wait_for(feeds_[1]);
+	}
+
+	/**
+	 * move constructor, move streamed fft here, invalidate other
+	 *
+	 * @param f streamed fft to move here
+	 */
+	fft_streamed(BOOST_RV_REF(fft_streamed) f) :
+		device_(f.device_), dim_(f.dim_), inner_(f.inner_),
+		slowest_(f.slowest_), slab_(f.slab_), pencil_(f.pencil_)
+	{
+		for (std::size_t i=0; i<2; i++) {
+			slab_plan_[i] = boost::move(f.slab_plan_[i]);
+			slab_rest_plan_[i] = boost::move(f.slab_rest_plan_[i]);
+			pencil_plan_[i] = boost::move(f.pencil_plan_[i]);
+			pencil_rest_plan_[i] = boost::move(f.pencil_rest_plan_[i]);
+			feeds_[i] = boost::move(f.feeds_[i]);
+			buffers_[i][0] = boost::move(f.buffers_[i][0]);
+			buffers_[i][1] = boost::move(f.buffers_[i][1]);
+		}
+		f.device_ = nullptr;
+	}
+
+	/**
+	 * move assignment, move streamed fft here, invalidate other
+	 *
+	 * @param f streamed fft to move here
+	 */
+	fft_streamed& operator=(BOOST_RV_REF(fft_streamed) f)
+	{
+		device_ = f.device_;
+		dim_ = f.dim_;
+		inner_ = f.inner_;
+		slowest_ = f.slowest_;
+		slab_ = f.slab_;
+		pencil_ = f.pencil_;
+		for (std::size_t i=0; i<2; i++) {
+			slab_plan_[i] = boost::move(f.slab_plan_[i]);
+			slab_rest_plan_[i] = boost::move(f.slab_rest_plan_[i]);
+			pencil_plan_[i] = boost::move(f.pencil_plan_[i]);
+			pencil_rest_plan_[i] = boost::move(f.pencil_rest_plan_[i]);
+			feeds_[i] = boost::move(f.feeds_[i]);
+			buffers_[i][0] = boost::move(f.buffers_[i][0]);
+			buffers_[i][1] = boost::move(f.buffers_[i][1]);
+		}
+		f.device_ = nullptr;
+		return *this;
+	}
+
+	/// size of the volume
+	const bounds & get_bounds() const
+	{
+		return dim_;
+	}
+
+	/// number of planes transformed per slab in the first pass
+	std::size_t get_slab_size() const
+	{
+		return slab_;
+	}
+
+	/// number of pencils transformed per batch in the second pass
+	std::size_t get_pencil_size() const
+	{
+		return pencil_;
+	}
+
+	/**
+	 * transform volume in place
+	 *
+	 * @param data host memory holding product(get_bounds()) elements
+	 * @param forward direction of the transform
+	 */
+	void transform(value_type * data, bool forward)
+	{
+		assert(nullptr != device_);
+		auto kernel_data = detail::get_fft_streamed_transpose_kernel();
+		kernel k = device_->load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+
+		// first pass, all but the slowest dimension
+		for (std::size_t j=0, i=0; j<slowest_; j+=slab_, i++) {
+			std::size_t n = std::min(slab_, slowest_-j);
+			feed & f = feeds_[i%2];
+			device_ptr<value_type> b = buffers_[i%2][0].begin();
+			backend::copy(b, data + j*inner_, n*inner_, f);
+			run(n == slab_ ? slab_plan_[i%2] : slab_rest_plan_[i%2],
+					b, forward, f);
+			backend::copy(data + j*inner_, b, n*inner_, f);
+		}
+		// every pencil crosses every slab
+		wait_for(feeds_[0]);
+		wait_for(feeds_[1]);
+
+		// second pass, slowest dimension
+		for (std::size_t j=0, i=0; j<inner_; j+=pencil_, i++) {
+			std::size_t n = std::min(pencil_, inner_-j);
+			feed & f = feeds_[i%2];
+			device_ptr<value_type> a = buffers_[i%2][0].begin();
+			device_ptr<value_type> b = buffers_[i%2][1].begin();
+			backend::copy_rows(a, data + j, n, slowest_, inner_, f);
+			invoke(k, n*slowest_, args(b.get_base(), a.get_base(),
+					slowest_, n), f);
+			run(n == pencil_ ?
+					pencil_plan_[i%2] : pencil_rest_plan_[i%2],
+					b, forward, f);
+			invoke(k, n*slowest_, args(a.get_base(), b.get_base(),
+					n, slowest_), f);
+			backend::copy_rows(data + j, a, n, slowest_, inner_, f);
+		}
+		wait_for(feeds_[0]);
+		wait_for(feeds_[1]);
+	}
+
+private:
+	/// in-place transform of a slab or a batch of pencils
+	void run(fft & plan, device_ptr<value_type> p, bool forward, feed & f)
+	{
+		if (forward) {
+			backend::fft_forward(p, p, plan, f);
+		} else {
+			backend::fft_inverse(p, p, plan, f);
+		}
+	}
+
+	/// device the transform is calculated on
+	device * device_;
+	/// size of the volume
+	bounds dim_;
+	/// number of elements in a plane (all but the slowest dimension)
+	std::size_t inner_;
+	/// size of the slowest dimension
+	std::size_t slowest_;
+	/// planes per slab
+	std::size_t slab_;
+	/// pencils per batch
+	std::size_t pencil_;
+
+	/// batched transform of slab_ planes (per feed)
+	std::array<fft, 2> slab_plan_;
+	/// batched transform of the last slab if slab_ does not divide
+	std::array<fft, 2> slab_rest_plan_;
+	/// batched transform of pencil_ pencils (per feed)
+	std::array<fft, 2> pencil_plan_;
+	/// batched transform of the last pencils if pencil_ does not divide
+	std::array<fft, 2> pencil_rest_plan_;
+
+	/// two feeds to overlap transfer and compute
+	std::array<feed, 2> feeds_;
+	/// two buffers per feed
+	std::array<std::array<device_array<value_type>, 2>, 2> buffers_;
+};
+
+/// forward transform of a volume in host memory (in place)
+inline void fft_forward(math::cfloat * data, fft_streamed & plan)
+{
+	plan.transform(data, true);
+}
+
+/// inverse transform of a volume in host memory (in place)
+inline void fft_inverse(math::cfloat * data, fft_streamed & plan)
+{
+	plan.transform(data, false);
+}
+
+/// forward transform of a volume in a std::vector (in place)
+inline void fft_forward(std::vector<math::cfloat> & data,
+		fft_streamed & plan)
+{
+	assert(data.size() == (std::size_t)product(plan.get_bounds()));
+	plan.transform(&data[0], true);
+}
+
+/// inverse transform of a volume in a std::vector (in place)
+inline void fft_inverse(std::vector<math::cfloat> & data,
+		fft_streamed & plan)
+{
+	assert(data.size() == (std::size_t)product(plan.get_bounds()));
+	plan.transform(&data[0], false);
+}
+
+} // aura
+} // boost
+
+#endif // AURA_FFT_STREAMED_HPP
+
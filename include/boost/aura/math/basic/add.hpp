@@ -30,7 +30,7 @@ inline std::tuple<const char*,const char*> get_add_kernel(float, float, float)
 			AURA_GLOBAL float* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = src1[i] + src2[i];
 		}		
@@ -51,7 +51,7 @@ inline std::tuple<const char*,const char*> get_add_kernel(cfloat, cfloat, cfloat
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = caddf(src1[i], src2[i]);
 		}		
@@ -72,7 +72,7 @@ inline std::tuple<const char*,const char*> get_add_kernel(float, cfloat, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = make_cfloat(src1[i]+src2[i].x, src2[i].y);
 			//dst[i] = caddf(src1[i], src2[i]);
@@ -94,7 +94,7 @@ inline std::tuple<const char*,const char*> get_add_kernel(cfloat, float, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = make_cfloat(src1[i].x+src2[i], src1[i].y);
 		}		
@@ -139,7 +139,8 @@ void add(const DeviceRangeType1& input_range1,
 			args(aura::traits::begin_raw(input_range1), 
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(output_range),
-				aura::traits::size(input_range1)), f);
+				aura::traits::size(input_range1)),
+			f, bounds_fit::padded);
 	return;
 }
 
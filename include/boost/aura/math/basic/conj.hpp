@@ -29,7 +29,7 @@ inline std::tuple<const char*,const char*> get_conj_kernel(cfloat, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
                        dst[i] = conjf(src[i]); 
 		}		
@@ -66,7 +66,8 @@ void conj(const DeviceRangeType1& input_range,
 	invoke(k, aura::traits::bounds(input_range),
 			args(aura::traits::begin_raw(input_range),
 				aura::traits::begin_raw(output_range),
-				aura::traits::size(input_range)), f);
+				aura::traits::size(input_range)),
+			f, bounds_fit::padded);
 	return;
 }
 
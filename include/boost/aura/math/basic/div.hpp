@@ -30,7 +30,7 @@ inline std::tuple<const char*,const char*> get_div_kernel(float, float, float)
 			AURA_GLOBAL float* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = src1[i] / src2[i];
 		}		
@@ -51,7 +51,7 @@ inline std::tuple<const char*,const char*> get_div_kernel(cfloat, cfloat, cfloat
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = cdivf(src1[i], src2[i]);
 		}				
@@ -71,7 +71,7 @@ inline std::tuple<const char*,const char*> get_div_kernel(float, cfloat, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {								
 			// The following implementation is taken from the LLVM Compiler Infrastructure, licensed under 
 			// the MIT and the University of Illinois Open Source Licenses.
@@ -109,7 +109,7 @@ inline std::tuple<const char*,const char*> get_div_kernel(cfloat, float, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = make_cfloat(src1[i].x/src2[i], src1[i].y/src2[i]);
 			
@@ -133,7 +133,7 @@ inline std::tuple<const char*,const char*> get_scal_div_kernel(float, float, flo
             AURA_GLOBAL float* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = src1[i]/src2[0];
         }
@@ -154,7 +154,7 @@ inline std::tuple<const char*,const char*> get_scal_div_kernel(cfloat, cfloat, c
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = cdivf(src1[i], src2[0]);
         }
@@ -176,7 +176,7 @@ inline std::tuple<const char*,const char*> get_scal_div_kernel(float, cfloat, cf
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             // The following implementation is taken from the LLVM Compiler Infrastructure, licensed under 
 			// the MIT and the University of Illinois Open Source Licenses.
@@ -214,7 +214,7 @@ inline std::tuple<const char*,const char*> get_scal_div_kernel(cfloat, float, cf
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = make_cfloat(src1[i].x/src2[0], src1[i].y/src2[0]);
         }
@@ -274,7 +274,8 @@ void div(const DeviceRangeType1& input_range1,
 			args(aura::traits::begin_raw(input_range1), 
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(output_range),
-				aura::traits::size(input_range1)), f);
+				aura::traits::size(input_range1)),
+			f, bounds_fit::padded);
 	return;
 }
 
@@ -26,7 +26,7 @@ inline std::tuple<const char*,const char*> exp_kernel_name(float src_ptr, float
         AURA_KERNEL void exp_float(AURA_GLOBAL float* src_ptr,
 				AURA_GLOBAL float* dst_ptr)
 	{
-            unsigned int id  = get_mesh_id();
+            AURA_INDEX id  = get_mesh_id();
             dst_ptr[id] = exp(src_ptr[id]);
 	}
 		
@@ -44,7 +44,7 @@ inline std::tuple<const char*,const char*> exp_kernel_name(cfloat src_ptr, cfloa
 				AURA_GLOBAL cfloat* dst_ptr)
         {
 
-            unsigned int id  = get_mesh_id();
+            AURA_INDEX id  = get_mesh_id();
 
             // get complex shortcuts
             float re  = crealf(src_ptr[id]);
@@ -30,7 +30,7 @@ inline std::tuple<const char*,const char*> get_fma_kernel(float, float, float)
 			AURA_GLOBAL float* src3,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
                        src3[i] = fmaf(src1[i],src2[i],src3[i]);
 		}
@@ -51,7 +51,7 @@ inline std::tuple<const char*,const char*> get_fma_kernel(cfloat, cfloat, cfloat
 			AURA_GLOBAL cfloat* src3,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
                        src3[i] = caddf(cmulf(src1[i],src2[i]),src3[i]);
 		}
@@ -94,7 +94,8 @@ void fma(const DeviceRangeType& input_range1,
 			args(aura::traits::begin_raw(input_range1), 
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(input_output_range),
-				aura::traits::size(input_range2)), f);
+				aura::traits::size(input_range2)),
+			f, bounds_fit::padded);
 	return;
 }
 
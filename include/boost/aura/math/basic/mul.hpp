@@ -30,7 +30,7 @@ inline std::tuple<const char*,const char*> get_mul_kernel(float, float, float)
 			AURA_GLOBAL float* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = src1[i] * src2[i];
 		}		
@@ -51,7 +51,7 @@ inline std::tuple<const char*,const char*> get_mul_kernel(cfloat, cfloat, cfloat
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = cmulf(src1[i], src2[i]);
 		}		
@@ -72,7 +72,7 @@ inline std::tuple<const char*,const char*> get_mul_kernel(float, cfloat, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = make_cfloat(src1[i]*src2[i].x, src1[i]*src2[i].y);					
 		}		
@@ -93,7 +93,7 @@ inline std::tuple<const char*,const char*> get_mul_kernel(cfloat, float, cfloat)
 			AURA_GLOBAL cfloat* dst,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
 			dst[i] = make_cfloat(src1[i].x*src2[i], src1[i].y*src2[i]);
 		}		
@@ -116,7 +116,7 @@ inline std::tuple<const char*,const char*> get_scal_mul_kernel(float, float, flo
             AURA_GLOBAL float* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = src1[i] * src2[0];
         }
@@ -137,7 +137,7 @@ inline std::tuple<const char*,const char*> get_scal_mul_kernel(cfloat, cfloat, c
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = cmulf(src1[i], src2[0]);
         }
@@ -159,7 +159,7 @@ inline std::tuple<const char*,const char*> get_scal_mul_kernel(float, cfloat, cf
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = make_cfloat(src1[i]*src2[0].x, src1[i]*src2[0].y);
         }
@@ -180,7 +180,7 @@ inline std::tuple<const char*,const char*> get_scal_mul_kernel(cfloat, float, cf
             AURA_GLOBAL cfloat* dst,
             unsigned long N)
     {
-        unsigned int i = get_mesh_id();
+        AURA_INDEX i = get_mesh_id();
         if (i < N) {
             dst[i] = make_cfloat(src1[i].x*src2[0], src1[i].y*src2[0]);
         }
@@ -240,7 +240,8 @@ void mul(const DeviceRangeType1& input_range1,
 			args(aura::traits::begin_raw(input_range1), 
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(output_range),
-				aura::traits::size(input_range1)), f);
+				aura::traits::size(input_range1)),
+			f, bounds_fit::padded);
 	return;
 }
 
@@ -26,7 +26,7 @@ inline std::tuple<const char*,const char*> sqrt_kernel_name(float src_ptr, float
         AURA_KERNEL void sqrt_float(AURA_GLOBAL float* src_ptr,
 				AURA_GLOBAL float* dst_ptr)
 	{
-            unsigned int id  = get_mesh_id();
+            AURA_INDEX id  = get_mesh_id();
             dst_ptr[id] = sqrt(src_ptr[id]);
 	}
 		
@@ -46,7 +46,7 @@ inline std::tuple<const char*,const char*> sqrt_kernel_name(cfloat src_ptr, cflo
 				AURA_GLOBAL cfloat* dst_ptr)
         {
 
-            unsigned int id  = get_mesh_id();
+            AURA_INDEX id  = get_mesh_id();
 
             // get complex shortcuts
             float re  = crealf(src_ptr[id]);
@@ -30,7 +30,7 @@ inline std::tuple<const char*,const char*> get_axpy_kernel(float, float, float)
 			AURA_GLOBAL float* src3,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
                        src3[i] = src1[0]*src2[i] + src3[i];
 		}
@@ -52,7 +52,7 @@ inline std::tuple<const char*,const char*> get_axpy_kernel(cfloat, cfloat, cfloa
 			AURA_GLOBAL cfloat* src3,
 			unsigned long N)
 	{
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 		if (i < N) {
                        src3[i] = caddf(cmulf(src1[0],src2[i]) , src3[i]);
 		}
@@ -95,7 +95,8 @@ void axpy(const DeviceRangeType& input_range1,
 			args(aura::traits::begin_raw(input_range1), 
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(input_output_range),
-				aura::traits::size(input_range2)), f);
+				aura::traits::size(input_range2)),
+			f, bounds_fit::padded);
 	return;
 }
 
@@ -2,6 +2,7 @@
 #define AURA_MATH_BLAS_DOT_HPP
 
 #include <tuple>
+#include <string>
 #include <cassert>
 
 #include <stdio.h>
@@ -9,7 +10,7 @@
 #include <boost/aura/backend.hpp>
 #include <boost/aura/math/complex.hpp>
 #include <boost/aura/math/memset_zero.hpp>
-#include <boost/aura/math/partition_mesh.hpp>
+#include <boost/aura/math/reduction_config.hpp>
 
 namespace boost
 {
@@ -28,59 +29,47 @@ inline std::tuple<const char*,const char*> get_dot_kernel(float, float, float)
 
 	#include <boost/aura/backend.hpp>
 
+	// launch configuration, set by the host
+	#ifndef AURA_BUNDLE_SIZE
+	#define AURA_BUNDLE_SIZE 256
+	#endif
+	#ifndef AURA_ELEMENTS_PER_FIBER
+	#define AURA_ELEMENTS_PER_FIBER 1
+	#endif
+
 	AURA_KERNEL void dot_float(AURA_GLOBAL float* src1,
 			AURA_GLOBAL float* src2,
 			AURA_GLOBAL float* dst,
 			const unsigned long N)
 	{
-		unsigned int mid = get_mesh_id();
 		unsigned int bid = get_bundle_id();
-
-		AURA_SHARED float sm[256];
-
-		if ( mid < N ) {
-			sm[bid] 	= src1[mid]*src2[mid];
-
-		} else {
-			sm[bid] = 0;
-			//return;
+		// every bundle reduces AURA_BUNDLE_SIZE*AURA_ELEMENTS_PER_FIBER
+		// consecutive elements
+		unsigned long mid = (unsigned long)(get_mesh_id() - bid) *
+			AURA_ELEMENTS_PER_FIBER + bid;
+
+		AURA_SHARED float sm[AURA_BUNDLE_SIZE];
+
+		float s = 0;
+		for (int e=0; e<AURA_ELEMENTS_PER_FIBER; e++) {
+			if (mid < N) {
+				s += src1[mid]*src2[mid];
+			}
+			mid += AURA_BUNDLE_SIZE;
 		}
-
-		AURA_SYNC;
-
-		if (bid < 128)
-			sm[bid] += sm[bid+128];
-		AURA_SYNC;
-
-		if (bid < 64)
-			sm[bid] += sm[bid+64];
-		AURA_SYNC;
-
-		if (bid < 32)
-			sm[bid] += sm[bid+32];
+		sm[bid] = s;
 		AURA_SYNC;
 
-		if (bid < 16)
-			sm[bid] += sm[bid+16];
-		AURA_SYNC;
-
-		if (bid < 8)
-			sm[bid] += sm[bid+8];
-		AURA_SYNC;
-
-		if (bid < 4)
-			sm[bid] += sm[bid+4];
-		AURA_SYNC;
-
-		if (bid < 2)
-			sm[bid] += sm[bid+2];
-		AURA_SYNC;
+		for (unsigned int i=AURA_BUNDLE_SIZE/2; i>0; i/=2) {
+			if (bid < i) {
+				sm[bid] += sm[bid+i];
+			}
+			AURA_SYNC;
+		}
 
 		if (bid < 1) {
-			sm[bid] += sm[bid+1];
 			atomic_addf(dst, sm[0]);
 		}
-		AURA_SYNC;
 	}
 
 		)aura_kernel");
@@ -93,62 +82,55 @@ inline std::tuple<const char*,const char*> get_dot_kernel(cfloat, cfloat, cfloat
 
 	#include <boost/aura/backend.hpp>
 
+	// launch configuration, set by the host
+	#ifndef AURA_BUNDLE_SIZE
+	#define AURA_BUNDLE_SIZE 256
+	#endif
+	#ifndef AURA_ELEMENTS_PER_FIBER
+	#define AURA_ELEMENTS_PER_FIBER 1
+	#endif
+
 	AURA_KERNEL void dot_cfloat(AURA_GLOBAL cfloat* src1,
 			AURA_GLOBAL cfloat* src2,
 			AURA_GLOBAL cfloat* dst,
 			const unsigned long N)
 	{
-		unsigned int mid = get_mesh_id();
 		unsigned int bid = get_bundle_id();
-		AURA_SHARED cfloat sm[256];
+		unsigned long mid = (unsigned long)(get_mesh_id() - bid) *
+			AURA_ELEMENTS_PER_FIBER + bid;
 
-		if ( mid < N ) {
-            sm[bid] 	= cmulf(conjf(src1[mid]),src2[mid]);
-		} else {
-            sm[bid] = make_cfloat(0.0,0.0);
-		}
-		AURA_SYNC;
-
-		if (bid < 128)
-			sm[bid] += sm[bid+128];
-		AURA_SYNC;
-
-		if (bid < 64)
-			sm[bid] += sm[bid+64];
-		AURA_SYNC;
-
-		if (bid < 32)
-			sm[bid] += sm[bid+32];
-		AURA_SYNC;
-
-		if (bid < 16)
-			sm[bid] += sm[bid+16];
-		AURA_SYNC;
-
-		if (bid < 8)
-			sm[bid] += sm[bid+8];
-		AURA_SYNC;
+		AURA_SHARED cfloat sm[AURA_BUNDLE_SIZE];
 
-		if (bid < 4)
-			sm[bid] += sm[bid+4];
+		cfloat s = make_cfloat(0.0, 0.0);
+		for (int e=0; e<AURA_ELEMENTS_PER_FIBER; e++) {
+			if (mid < N) {
+				s = caddf(s, cmulf(conjf(src1[mid]), src2[mid]));
+			}
+			mid += AURA_BUNDLE_SIZE;
+		}
+		sm[bid] = s;
 		AURA_SYNC;
 
-		if (bid < 2)
-			sm[bid] += sm[bid+2];
-		AURA_SYNC;
+		for (unsigned int i=AURA_BUNDLE_SIZE/2; i>0; i/=2) {
+			if (bid < i) {
+				sm[bid] = caddf(sm[bid], sm[bid+i]);
+			}
+			AURA_SYNC;
+		}
 
 		if (bid < 1) {
-			sm[bid] += sm[bid+1];
- 			atomic_addf(crealfp(dst), crealf(sm[0]));
-            if (src1 != src2)
-                atomic_addf(cimagfp(dst), cimagf(sm[0]));
+			atomic_addf(crealfp(dst), crealf(sm[0]));
+			if (src1 != src2)
+				atomic_addf(cimagfp(dst), cimagf(sm[0]));
 		}
-		AURA_SYNC;
 	}
 
 		)aura_kernel");
 }
 
+/// default bundle size of dot
+const std::size_t dot_bundle_size = 256;
+
 } // namespace detail
 
 
@@ -176,27 +158,33 @@ void dot(const DeviceRangeType& input_range1,
 			aura::traits::get_value_type(input_range2),
 			aura::traits::get_value_type(output_range));
 
-	backend::kernel k = aura::traits::get_device(output_range).
-		load_from_string(std::get<0>(kernel_data),
-				std::get<1>(kernel_data),
-				AURA_BACKEND_COMPILE_FLAGS, true);
-
-	long vs = aura::traits::size(input_range1);
-	int bs = 256;
-	std::vector<std::size_t> mesh_size(3,1);
-
-	// partition the mesh size
-	partition_mesh(mesh_size,vs,bs);
-
-
-	// set output_range to zero
-    aura::math::memset_zero(output_range, f);
-
-	invoke(k, mesh(mesh_size[0], mesh_size[1], mesh_size[2]), bundle(bs),
-			args(aura::traits::begin_raw(input_range1),
-				aura::traits::begin_raw(input_range2),
-				aura::traits::begin_raw(output_range),
-				aura::traits::size(input_range1)), f);
+	device& d = aura::traits::get_device(output_range);
+	std::size_t n = aura::traits::size(input_range1);
+	// size of an element of the local memory buffer
+	std::size_t element_size =
+		sizeof(aura::traits::get_value_type(input_range1));
+
+	// set output_range to zero and run the kernel with a launch
+	// configuration and its source, every configuration has its own
+	// module
+	auto launch = [&](const launch_config& c, const std::string& source) {
+		aura::math::memset_zero(output_range, f);
+		backend::kernel k = d.load_from_string(
+				std::get<0>(kernel_data), source.c_str(),
+				AURA_BACKEND_COMPILE_FLAGS);
+		invoke(k, detail::get_reduction_mesh(n, c), bundle(c.bundle),
+				args(aura::traits::begin_raw(input_range1),
+					aura::traits::begin_raw(input_range2),
+					aura::traits::begin_raw(output_range), n), f);
+	};
+	auto run = [&](const launch_config& c) {
+		launch(c, detail::get_reduction_source(
+					std::get<1>(kernel_data), c));
+	};
+	const aura::detail::tuned_launch& l = detail::get_reduction_launch(
+			d, f, std::get<0>(kernel_data), std::get<1>(kernel_data),
+			n, detail::dot_bundle_size, element_size, run);
+	launch(l.config, l.source);
 	return;
 }
 
@@ -0,0 +1,197 @@
+#ifndef AURA_MATH_DISTRIBUTED_HPP
+#define AURA_MATH_DISTRIBUTED_HPP
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+
+#include <boost/aura/backend.hpp>
+#include <boost/aura/copy.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/distributed_array.hpp>
+#include <boost/aura/math/basic/add.hpp>
+#include <boost/aura/math/basic/sub.hpp>
+#include <boost/aura/math/basic/mul.hpp>
+#include <boost/aura/math/basic/div.hpp>
+#include <boost/aura/math/blas/dot.hpp>
+#include <boost/aura/math/blas/norm2.hpp>
+#include <boost/aura/math/blas/sum.hpp>
+
+/**
+ * math operations on distributed arrays, every device of the group works
+ * on its own partition in its own feed, the operations return when all
+ * devices have finished
+ */
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+
+namespace detail
+{
+
+/// apply an elementwise operation to all partitions
+template <typename T1, typename T2, typename T3, typename Op>
+void distributed_elementwise(const distributed_array<T1>& input1,
+		const distributed_array<T2>& input2,
+		distributed_array<T3>& output, Op op)
+{
+	assert(input1.get_bounds() == input2.get_bounds());
+	assert(input1.get_bounds() == output.get_bounds());
+	assert(&input1.get_group() == &output.get_group());
+	assert(&input2.get_group() == &output.get_group());
+
+	device_group& g = output.get_group();
+	for (std::size_t i=0; i<output.num_partitions(); i++) {
+		if (output.is_empty(i)) {
+			continue;
+		}
+		op(input1.get_partition(i), input2.get_partition(i),
+				output.get_partition(i), g.get_feed(i));
+	}
+	g.synchronize();
+}
+
+/**
+ * apply a reduction to all partitions, every partition is reduced to a
+ * single value on its device, the values are combined on the host
+ */
+template <typename R, typename Group, typename Op>
+std::vector<R> distributed_reduce(Group& g,
+		const std::vector<bool>& empty, Op op)
+{
+	std::vector<device_array<R> > partial(g.size());
+	std::vector<R> r(g.size(), R());
+	for (std::size_t i=0; i<g.size(); i++) {
+		if (empty[i]) {
+			continue;
+		}
+		partial[i] = device_array<R>(1, g.get_device(i));
+		op(i, partial[i], g.get_feed(i));
+		backend::copy(&r[i], partial[i].begin(), 1, g.get_feed(i));
+	}
+	g.synchronize();
+	return r;
+}
+
+template <typename T>
+std::vector<bool> empty_partitions(const distributed_array<T>& a)
+{
+	std::vector<bool> r(a.num_partitions());
+	for (std::size_t i=0; i<r.size(); i++) {
+		r[i] = a.is_empty(i);
+	}
+	return r;
+}
+
+} // namespace detail
+
+template <typename T1, typename T2, typename T3>
+void add(const distributed_array<T1>& input1,
+		const distributed_array<T2>& input2,
+		distributed_array<T3>& output)
+{
+	detail::distributed_elementwise(input1, input2, output,
+		[](const device_array<T1>& i1, const device_array<T2>& i2,
+			device_array<T3>& o, feed& f) {
+			add(i1, i2, o, f);
+		});
+}
+
+template <typename T1, typename T2, typename T3>
+void sub(const distributed_array<T1>& input1,
+		const distributed_array<T2>& input2,
+		distributed_array<T3>& output)
+{
+	detail::distributed_elementwise(input1, input2, output,
+		[](const device_array<T1>& i1, const device_array<T2>& i2,
+			device_array<T3>& o, feed& f) {
+			sub(i1, i2, o, f);
+		});
+}
+
+template <typename T1, typename T2, typename T3>
+void mul(const distributed_array<T1>& input1,
+		const distributed_array<T2>& input2,
+		distributed_array<T3>& output)
+{
+	detail::distributed_elementwise(input1, input2, output,
+		[](const device_array<T1>& i1, const device_array<T2>& i2,
+			device_array<T3>& o, feed& f) {
+			mul(i1, i2, o, f);
+		});
+}
+
+template <typename T1, typename T2, typename T3>
+void div(const distributed_array<T1>& input1,
+		const distributed_array<T2>& input2,
+		distributed_array<T3>& output)
+{
+	detail::distributed_elementwise(input1, input2, output,
+		[](const device_array<T1>& i1, const device_array<T2>& i2,
+			device_array<T3>& o, feed& f) {
+			div(i1, i2, o, f);
+		});
+}
+
+/// sum of all elements
+template <typename T>
+T sum(const distributed_array<T>& input)
+{
+	std::vector<T> partial = detail::distributed_reduce<T>(
+		input.get_group(), detail::empty_partitions(input),
+		[&input](std::size_t i, device_array<T>& o, feed& f) {
+			sum(input.get_partition(i), o, f);
+		});
+	T r = T();
+	for (auto& p : partial) {
+		r += p;
+	}
+	return r;
+}
+
+/// dot product (conjugated for complex types)
+template <typename T>
+T dot(const distributed_array<T>& input1,
+		const distributed_array<T>& input2)
+{
+	assert(input1.get_bounds() == input2.get_bounds());
+	assert(&input1.get_group() == &input2.get_group());
+	std::vector<T> partial = detail::distributed_reduce<T>(
+		input1.get_group(), detail::empty_partitions(input1),
+		[&input1, &input2](std::size_t i, device_array<T>& o, feed& f) {
+			dot(input1.get_partition(i), input2.get_partition(i), o, f);
+		});
+	T r = T();
+	for (auto& p : partial) {
+		r += p;
+	}
+	return r;
+}
+
+/// euclidean norm
+template <typename T>
+float norm2(const distributed_array<T>& input)
+{
+	std::vector<float> partial = detail::distributed_reduce<float>(
+		input.get_group(), detail::empty_partitions(input),
+		[&input](std::size_t i, device_array<float>& o, feed& f) {
+			norm2(input.get_partition(i), o, f);
+		});
+	// partial norms are combined as sum of squares
+	float r = 0.;
+	for (auto& p : partial) {
+		r += p*p;
+	}
+	return std::sqrt(r);
+}
+
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_DISTRIBUTED_HPP
+
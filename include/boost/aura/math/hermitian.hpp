@@ -0,0 +1,175 @@
+#ifndef AURA_MATH_HERMITIAN_HPP
+#define AURA_MATH_HERMITIAN_HPP
+
+#include <tuple>
+#include <cassert>
+
+#include <boost/aura/meta/traits.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/bounds.hpp>
+#include <boost/aura/math/complex.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+namespace detail
+{
+
+inline std::tuple<const char*,const char*> get_hermitian_expand_kernel(
+		cfloat, cfloat)
+{
+	return std::make_tuple("hermitian_expand_cfloat",
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void hermitian_expand_cfloat(AURA_GLOBAL cfloat* src,
+			AURA_GLOBAL cfloat* dst,
+			unsigned long n0,
+			unsigned long n1,
+			unsigned long n2)
+	{
+		AURA_INDEX id = get_mesh_id();
+		if (id >= n0*n1*n2) {
+			return;
+		}
+		unsigned long h0 = n0/2+1;
+		unsigned long i0 = id % n0;
+		unsigned long i1 = (id / n0) % n1;
+		unsigned long i2 = id / (n0*n1);
+		if (i0 < h0) {
+			dst[id] = src[i0 + h0*(i1 + n1*i2)];
+		} else {
+			// X[k] = conj(X[-k]) for real input
+			i0 = n0 - i0;
+			i1 = (n1 - i1) % n1;
+			i2 = (n2 - i2) % n2;
+			dst[id] = conjf(src[i0 + h0*(i1 + n1*i2)]);
+		}
+	}
+
+		)aura_kernel");
+}
+
+inline std::tuple<const char*,const char*> get_hermitian_compress_kernel(
+		cfloat, cfloat)
+{
+	return std::make_tuple("hermitian_compress_cfloat",
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void hermitian_compress_cfloat(AURA_GLOBAL cfloat* src,
+			AURA_GLOBAL cfloat* dst,
+			unsigned long n0,
+			unsigned long n1,
+			unsigned long n2)
+	{
+		AURA_INDEX id = get_mesh_id();
+		unsigned long h0 = n0/2+1;
+		if (id >= h0*n1*n2) {
+			return;
+		}
+		unsigned long i0 = id % h0;
+		unsigned long rest = id / h0;
+		dst[id] = src[i0 + n0*rest];
+	}
+
+		)aura_kernel");
+}
+
+/// pad bounds to 3 dimensions
+inline std::tuple<std::size_t, std::size_t, std::size_t> hermitian_dims(
+		const bounds& b)
+{
+	assert(b.size() >= 1 && b.size() <= 3);
+	return std::make_tuple((std::size_t)b[0],
+			(std::size_t)(b.size() > 1 ? b[1] : 1),
+			(std::size_t)(b.size() > 2 ? b[2] : 1));
+}
+
+} // namespace detail
+
+/**
+ * expand the packed spectrum of a real fourier transform to the full
+ * spectrum
+ *
+ * @param input_range packed spectrum (fft_hermitian_bounds(b))
+ * @param output_range full spectrum, the bounds b of this range are
+ * the bounds of the real data
+ * @param f feed the expansion is calculated in
+ */
+template <typename DeviceRangeType1, typename DeviceRangeType2>
+void hermitian_expand(const DeviceRangeType1& input_range,
+		DeviceRangeType2& output_range, feed& f)
+{
+	bounds b = aura::traits::bounds(output_range);
+	assert((std::size_t)product(fft_hermitian_bounds(b)) ==
+			aura::traits::size(input_range));
+	assert(aura::traits::get_device(input_range) ==
+			aura::traits::get_device(output_range));
+
+	auto kernel_data = detail::get_hermitian_expand_kernel(
+			aura::traits::get_value_type(input_range),
+			aura::traits::get_value_type(output_range));
+
+	backend::kernel k = aura::traits::get_device(output_range).
+		load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+
+	auto n = detail::hermitian_dims(b);
+	invoke(k, b,
+			args(aura::traits::begin_raw(input_range),
+				aura::traits::begin_raw(output_range),
+				std::get<0>(n), std::get<1>(n), std::get<2>(n)),
+			f);
+	return;
+}
+
+/**
+ * compress the full spectrum of a real fourier transform to the packed
+ * spectrum
+ *
+ * @param input_range full spectrum, the bounds b of this range are
+ * the bounds of the real data
+ * @param output_range packed spectrum (fft_hermitian_bounds(b))
+ * @param f feed the compression is calculated in
+ */
+template <typename DeviceRangeType1, typename DeviceRangeType2>
+void hermitian_compress(const DeviceRangeType1& input_range,
+		DeviceRangeType2& output_range, feed& f)
+{
+	bounds b = aura::traits::bounds(input_range);
+	bounds h = fft_hermitian_bounds(b);
+	assert((std::size_t)product(h) == aura::traits::size(output_range));
+	assert(aura::traits::get_device(input_range) ==
+			aura::traits::get_device(output_range));
+
+	auto kernel_data = detail::get_hermitian_compress_kernel(
+			aura::traits::get_value_type(input_range),
+			aura::traits::get_value_type(output_range));
+
+	backend::kernel k = aura::traits::get_device(output_range).
+		load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+
+	auto n = detail::hermitian_dims(b);
+	invoke(k, h,
+			args(aura::traits::begin_raw(input_range),
+				aura::traits::begin_raw(output_range),
+				std::get<0>(n), std::get<1>(n), std::get<2>(n)),
+			f);
+	return;
+}
+
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_HERMITIAN_HPP
+
@@ -30,11 +30,16 @@
 #include <boost/aura/math/memset_zero.hpp>
 #include <boost/aura/math/memset_ones.hpp>
 #include <boost/aura/math/split_interleaved.hpp>
+#include <boost/aura/math/planar.hpp>
+#include <boost/aura/math/hermitian.hpp>
 #include <boost/aura/math/support_functions.hpp>
 
 // numerical optimization
 #include <boost/aura/math/conjgrad.hpp>
 #include <boost/aura/math/gauss_newton.hpp>
 
+// multi-device
+#include <boost/aura/math/distributed.hpp>
+
 #endif // BOOST_AURA_MATH_MATH_HPP
 
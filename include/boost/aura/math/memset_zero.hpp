@@ -42,7 +42,7 @@ inline std::tuple<const char*,const char*> memset_zero_kernel_name(
 
         AURA_KERNEL void memset_zero_cfloat(AURA_GLOBAL cfloat* dst_ptr)
         {
-            unsigned long id = get_mesh_id();
+            AURA_INDEX id = get_mesh_id();
                 dst_ptr[id] = make_cfloat(0.,0.);
         }
 
@@ -3,7 +3,8 @@
 
 #include <tuple>
 
-#include <stdio.h>
+#include <vector>
+#include <cstddef>
 #include <boost/aura/meta/traits.hpp>
 #include <boost/aura/backend.hpp>
 #include <boost/aura/math/complex.hpp>
@@ -15,68 +16,60 @@ namespace aura
 namespace math
 {
 
-void partition_mesh(std::vector<std::size_t> & mesh_size, 
+namespace detail
+{
+
+/// n/m rounded up
+inline std::size_t partition_mesh_ceil(std::size_t n, std::size_t m)
+{
+	return (n + m - 1) / m;
+}
+
+} // namespace detail
+
+/**
+ * partition numel fibers into a 3 dimensional mesh
+ *
+ * the fastest dimension is a multiple of bundle_size, the mesh holds at
+ * least numel fibers, sizes are calculated with integers so the mesh
+ * is exact for more than 2^31 elements, the fastest dimension grows
+ * if the other two are exhausted
+ */
+inline void partition_mesh(std::vector<std::size_t> & mesh_size, 
 		std::size_t numel, std::size_t bundle_size)
 {
+	const std::size_t max0 = AURA_OPENCL_MAX_MESH0;
+	const std::size_t max1 = AURA_OPENCL_MAX_MESH1;
+	const std::size_t max2 = AURA_OPENCL_MAX_MESH2;
+
 	// multiple of BUNDLE_SIZE in entire Volume
 	std::size_t numbs = (numel/bundle_size+1)*bundle_size;		
 	
 	// partition the mesh in multiples of BUNDLE_SIZE 
 	// while activating only as many fibers as needed
-	if ((float)numbs / (float)(AURA_OPENCL_MAX_MESH0 * 
-				AURA_OPENCL_MAX_MESH1) <= 1) {
+	if (numbs <= max0*max1) {
 	
 		mesh_size[2] = 1;
 		
 		// everything fits into one dimension	
-		if ((float)numbs / (float)(AURA_OPENCL_MAX_MESH0) <= 1){	
+		if (numbs <= max0) {	
 			mesh_size[1] = 1;			
 			mesh_size[0] = numbs;
 		} else {	
 			// we need two dimensions
-			mesh_size[0] = ceil( (float)numel / 
-					(float)(AURA_OPENCL_MAX_MESH1 * 
-						bundle_size) ) * 
-				bundle_size;
-			mesh_size[1] = ceil( (float)numel / 
-					(float)(mesh_size[0]));
-			// in case of rounding errors
-			if (mesh_size[0]*mesh_size[1] < numel ) {
-				mesh_size[0] = (numel /
-						(AURA_OPENCL_MAX_MESH1 *
-						 bundle_size)+1) * bundle_size;
-				mesh_size[1] = ( numel / (mesh_size[0]) +1);
-			}
+			mesh_size[0] = detail::partition_mesh_ceil(numel,
+					max1*bundle_size) * bundle_size;
+			mesh_size[1] = detail::partition_mesh_ceil(numel,
+					mesh_size[0]);
 		}
 	} else { 	
 		// we need three dimensions
-		if((float)numbs / (float)(AURA_OPENCL_MAX_MESH0 * 
-					AURA_OPENCL_MAX_MESH1 * 
-					AURA_OPENCL_MAX_MESH2) > 1) {
-			printf("Input array is too large. Aborting...");
-			return;
-		}
-		mesh_size[0] = ceil( (float)numel / 
-				(float)(AURA_OPENCL_MAX_MESH1 * 
-					AURA_OPENCL_MAX_MESH2 * 
-					bundle_size)  ) * bundle_size;				
-		mesh_size[1] = ceil( (float)numel / 
-				(float)(mesh_size[0] * 
-					AURA_OPENCL_MAX_MESH2) );
-		mesh_size[2] = ceil( (float)numel / 
-				(float)(mesh_size[0] * mesh_size[1]) );
-		// in case of rounding errors
-		if (mesh_size[0]*mesh_size[1]*mesh_size[2] < numel ) {
-			mesh_size[0] = ( numel / 
-					(AURA_OPENCL_MAX_MESH1 * 
-					 AURA_OPENCL_MAX_MESH2 * 
-					 bundle_size)+1) *
-				bundle_size;				
-			mesh_size[1] = ( numel / (mesh_size[0] * 
-						AURA_OPENCL_MAX_MESH2) +1);
-			mesh_size[2] = ( numel / 
-					(mesh_size[0] * mesh_size[1]) +1);
-		}
+		mesh_size[0] = detail::partition_mesh_ceil(numel,
+				max1*max2*bundle_size) * bundle_size;
+		mesh_size[1] = detail::partition_mesh_ceil(numel,
+				mesh_size[0]*max2);
+		mesh_size[2] = detail::partition_mesh_ceil(numel,
+				mesh_size[0]*mesh_size[1]);
 	}
 }
 
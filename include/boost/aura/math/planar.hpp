@@ -0,0 +1,206 @@
+#ifndef AURA_MATH_PLANAR_HPP
+#define AURA_MATH_PLANAR_HPP
+
+#include <tuple>
+#include <cassert>
+
+#include <boost/aura/meta/traits.hpp>
+#include <boost/aura/backend.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+
+/**
+ * planar (split) complex data, real and imaginary part are stored in
+ * two ranges of float
+ *
+ * planar is a view, it is cheap to copy and passed by value, the
+ * ranges must outlive it
+ */
+template <typename DeviceRangeType>
+struct planar
+{
+	planar(DeviceRangeType& r, DeviceRangeType& i) : real(&r), imag(&i)
+	{
+		assert(aura::traits::size(r) == aura::traits::size(i));
+	}
+
+	/// number of complex elements
+	std::size_t size() const
+	{
+		return aura::traits::size(*real);
+	}
+
+	DeviceRangeType* real;
+	DeviceRangeType* imag;
+};
+
+/// create planar view of two ranges
+template <typename DeviceRangeType>
+planar<DeviceRangeType> make_planar(DeviceRangeType& r, DeviceRangeType& i)
+{
+	return planar<DeviceRangeType>(r, i);
+}
+
+namespace detail
+{
+
+inline std::tuple<const char*,const char*> get_planar_kernel(const char* op)
+{
+	return std::make_tuple(op,
+		R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	#define AURA_PLANAR_BINARY(name, re, im) \
+	AURA_KERNEL void name(AURA_GLOBAL float* re1, \
+			AURA_GLOBAL float* im1, \
+			AURA_GLOBAL float* re2, \
+			AURA_GLOBAL float* im2, \
+			AURA_GLOBAL float* re3, \
+			AURA_GLOBAL float* im3, \
+			unsigned long N) \
+	{ \
+		AURA_INDEX i = get_mesh_id(); \
+		if (i < N) { \
+			float a = re1[i]; \
+			float b = im1[i]; \
+			float c = re2[i]; \
+			float d = im2[i]; \
+			re3[i] = re; \
+			im3[i] = im; \
+		} \
+	}
+
+	AURA_PLANAR_BINARY(add_planar_float, a+c, b+d)
+	AURA_PLANAR_BINARY(sub_planar_float, a-c, b-d)
+	AURA_PLANAR_BINARY(mul_planar_float, a*c-b*d, a*d+b*c)
+	AURA_PLANAR_BINARY(div_planar_float,
+			(a*c+b*d)/(c*c+d*d), (b*c-a*d)/(c*c+d*d))
+
+	AURA_KERNEL void conj_planar_float(AURA_GLOBAL float* re1,
+			AURA_GLOBAL float* im1,
+			AURA_GLOBAL float* re2,
+			AURA_GLOBAL float* im2,
+			unsigned long N)
+	{
+		AURA_INDEX i = get_mesh_id();
+		if (i < N) {
+			re2[i] = re1[i];
+			im2[i] = -im1[i];
+		}
+	}
+
+		)aura_kernel");
+}
+
+template <typename DeviceRangeType1, typename DeviceRangeType2,
+	 typename DeviceRangeType3>
+void planar_binary(const char* op,
+		planar<DeviceRangeType1> input1,
+		planar<DeviceRangeType2> input2,
+		planar<DeviceRangeType3> output, feed& f)
+{
+	// asserts to make sure vectors have same size
+	assert(input1.size() == input2.size());
+	assert(input1.size() == output.size());
+	// and vectors life on the same device
+	assert(aura::traits::get_device(*input1.real) ==
+			aura::traits::get_device(*output.real));
+	assert(aura::traits::get_device(*input2.real) ==
+			aura::traits::get_device(*output.real));
+	// deactivate these asserts by defining NDEBUG
+
+	auto kernel_data = get_planar_kernel(op);
+	backend::kernel k = aura::traits::get_device(*output.real).
+		load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+
+	invoke(k, aura::traits::bounds(*input1.real),
+			args(aura::traits::begin_raw(*input1.real),
+				aura::traits::begin_raw(*input1.imag),
+				aura::traits::begin_raw(*input2.real),
+				aura::traits::begin_raw(*input2.imag),
+				aura::traits::begin_raw(*output.real),
+				aura::traits::begin_raw(*output.imag),
+				input1.size()),
+			f, bounds_fit::padded);
+}
+
+} // namespace detail
+
+/// elementwise addition of planar complex data
+template <typename DeviceRangeType1, typename DeviceRangeType2,
+	 typename DeviceRangeType3>
+void add(planar<DeviceRangeType1> input1,
+		planar<DeviceRangeType2> input2,
+		planar<DeviceRangeType3> output, feed& f)
+{
+	detail::planar_binary("add_planar_float", input1, input2, output, f);
+}
+
+/// elementwise subtraction of planar complex data
+template <typename DeviceRangeType1, typename DeviceRangeType2,
+	 typename DeviceRangeType3>
+void sub(planar<DeviceRangeType1> input1,
+		planar<DeviceRangeType2> input2,
+		planar<DeviceRangeType3> output, feed& f)
+{
+	detail::planar_binary("sub_planar_float", input1, input2, output, f);
+}
+
+/// elementwise multiplication of planar complex data
+template <typename DeviceRangeType1, typename DeviceRangeType2,
+	 typename DeviceRangeType3>
+void mul(planar<DeviceRangeType1> input1,
+		planar<DeviceRangeType2> input2,
+		planar<DeviceRangeType3> output, feed& f)
+{
+	detail::planar_binary("mul_planar_float", input1, input2, output, f);
+}
+
+/// elementwise division of planar complex data
+template <typename DeviceRangeType1, typename DeviceRangeType2,
+	 typename DeviceRangeType3>
+void div(planar<DeviceRangeType1> input1,
+		planar<DeviceRangeType2> input2,
+		planar<DeviceRangeType3> output, feed& f)
+{
+	detail::planar_binary("div_planar_float", input1, input2, output, f);
+}
+
+/// elementwise complex conjugate of planar complex data
+template <typename DeviceRangeType1, typename DeviceRangeType2>
+void conj(planar<DeviceRangeType1> input, planar<DeviceRangeType2> output,
+		feed& f)
+{
+	assert(input.size() == output.size());
+	assert(aura::traits::get_device(*input.real) ==
+			aura::traits::get_device(*output.real));
+
+	auto kernel_data = detail::get_planar_kernel("conj_planar_float");
+	backend::kernel k = aura::traits::get_device(*output.real).
+		load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data),
+				AURA_BACKEND_COMPILE_FLAGS);
+
+	invoke(k, aura::traits::bounds(*input.real),
+			args(aura::traits::begin_raw(*input.real),
+				aura::traits::begin_raw(*input.imag),
+				aura::traits::begin_raw(*output.real),
+				aura::traits::begin_raw(*output.imag),
+				input.size()),
+			f, bounds_fit::padded);
+}
+
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_PLANAR_HPP
+
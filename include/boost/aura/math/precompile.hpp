@@ -0,0 +1,266 @@
+#ifndef AURA_MATH_PRECOMPILE_HPP
+#define AURA_MATH_PRECOMPILE_HPP
+
+#include <tuple>
+#include <vector>
+#include <initializer_list>
+
+#include <boost/aura/backend.hpp>
+#include <boost/aura/precompile.hpp>
+#include <boost/aura/math/complex.hpp>
+#include <boost/aura/math/reduction_config.hpp>
+
+#include <boost/aura/math/basic/add.hpp>
+#include <boost/aura/math/basic/conj.hpp>
+#include <boost/aura/math/basic/div.hpp>
+#include <boost/aura/math/basic/exp.hpp>
+#include <boost/aura/math/basic/fma.hpp>
+#include <boost/aura/math/basic/mul.hpp>
+#include <boost/aura/math/basic/sqrt.hpp>
+#include <boost/aura/math/basic/sub.hpp>
+#include <boost/aura/math/blas/axpy.hpp>
+#include <boost/aura/math/blas/dot.hpp>
+#include <boost/aura/math/blas/norm2.hpp>
+#include <boost/aura/math/blas/sum.hpp>
+#include <boost/aura/math/special/ndmul.hpp>
+#include <boost/aura/math/special/reduced_sum.hpp>
+#include <boost/aura/math/memset_zero.hpp>
+#include <boost/aura/math/memset_ones.hpp>
+#include <boost/aura/math/split_interleaved.hpp>
+#include <boost/aura/math/planar.hpp>
+#include <boost/aura/math/hermitian.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+
+/// math operations whose kernels can be precompiled
+enum class op
+{
+	add,
+	sub,
+	mul,
+	div,
+	conj,
+	exp,
+	sqrt,
+	fma,
+	axpy,
+	dot,
+	norm2,
+	sum,
+	ndmul,
+	reduced_sum,
+	memset_zero,
+	memset_ones,
+	split_interleaved,
+	planar,
+	hermitian
+};
+
+namespace detail
+{
+
+typedef std::tuple<const char*, const char*> kernel_data;
+
+inline void add_kernels(std::vector<kernel_source>& r,
+		std::initializer_list<kernel_data> kernels)
+{
+	for (auto& k : kernels) {
+		r.push_back(kernel_source(std::get<0>(k), std::get<1>(k)));
+	}
+}
+
+/// reductions are built for their default launch configuration
+inline void add_reduction_kernels(std::vector<kernel_source>& r,
+		device& d, std::size_t bundle,
+		std::initializer_list<std::tuple<kernel_data, std::size_t> >
+			kernels)
+{
+	for (auto& k : kernels) {
+		launch_config c = get_reduction_default(d, bundle,
+				std::get<1>(k));
+		r.push_back(kernel_source(std::get<0>(std::get<0>(k)),
+					get_reduction_source(
+						std::get<1>(std::get<0>(k)), c)));
+	}
+}
+
+} // namespace detail
+
+/**
+ * kernels of an operation for all value types
+ *
+ * @param d device the kernels are built for
+ * @param o operation
+ */
+inline std::vector<kernel_source> get_kernel_sources(device& d, op o)
+{
+	const float f = 0.;
+	const cfloat c(0., 0.);
+	std::vector<kernel_source> r;
+	switch (o) {
+		case op::add:
+			detail::add_kernels(r, {
+				detail::get_add_kernel(f, f, f),
+				detail::get_add_kernel(c, c, c),
+				detail::get_add_kernel(f, c, c),
+				detail::get_add_kernel(c, f, c)});
+			break;
+		case op::sub:
+			detail::add_kernels(r, {
+				detail::get_sub_kernel(f, f, f),
+				detail::get_sub_kernel(c, c, c),
+				detail::get_sub_kernel(f, c, c),
+				detail::get_sub_kernel(c, f, c)});
+			break;
+		case op::mul:
+			detail::add_kernels(r, {
+				detail::get_mul_kernel(f, f, f),
+				detail::get_mul_kernel(c, c, c),
+				detail::get_mul_kernel(f, c, c),
+				detail::get_mul_kernel(c, f, c),
+				detail::get_scal_mul_kernel(f, f, f),
+				detail::get_scal_mul_kernel(c, c, c),
+				detail::get_scal_mul_kernel(f, c, c),
+				detail::get_scal_mul_kernel(c, f, c)});
+			break;
+		case op::div:
+			detail::add_kernels(r, {
+				detail::get_div_kernel(f, f, f),
+				detail::get_div_kernel(c, c, c),
+				detail::get_div_kernel(f, c, c),
+				detail::get_div_kernel(c, f, c),
+				detail::get_scal_div_kernel(f, f, f),
+				detail::get_scal_div_kernel(c, c, c),
+				detail::get_scal_div_kernel(f, c, c),
+				detail::get_scal_div_kernel(c, f, c)});
+			break;
+		case op::conj:
+			detail::add_kernels(r, {detail::get_conj_kernel(c, c)});
+			break;
+		case op::exp:
+			detail::add_kernels(r, {
+				detail::exp_kernel_name(f, f),
+				detail::exp_kernel_name(c, c)});
+			break;
+		case op::sqrt:
+			detail::add_kernels(r, {
+				detail::sqrt_kernel_name(f, f),
+				detail::sqrt_kernel_name(c, c)});
+			break;
+		case op::fma:
+			detail::add_kernels(r, {
+				detail::get_fma_kernel(f, f, f),
+				detail::get_fma_kernel(c, c, c)});
+			break;
+		case op::axpy:
+			detail::add_kernels(r, {
+				detail::get_axpy_kernel(f, f, f),
+				detail::get_axpy_kernel(c, c, c)});
+			break;
+		case op::dot:
+			detail::add_reduction_kernels(r, d,
+				detail::dot_bundle_size, {
+				std::make_tuple(detail::get_dot_kernel(f, f, f),
+					sizeof(float)),
+				std::make_tuple(detail::get_dot_kernel(c, c, c),
+					sizeof(cfloat))});
+			break;
+		case op::norm2:
+			detail::add_reduction_kernels(r, d,
+				detail::norm2_bundle_size, {
+				std::make_tuple(detail::norm2_kernel_name(f),
+					sizeof(float)),
+				std::make_tuple(detail::norm2_kernel_name(c),
+					sizeof(float))});
+			break;
+		case op::sum:
+			detail::add_reduction_kernels(r, d,
+				detail::sum_bundle_size, {
+				std::make_tuple(detail::sum_kernel_name(f),
+					sizeof(float)),
+				std::make_tuple(detail::sum_kernel_name(c),
+					sizeof(cfloat))});
+			break;
+		case op::ndmul:
+			detail::add_kernels(r, {
+				detail::get_ndmul_kernel(f, f, f),
+				detail::get_ndmul_kernel(f, c, c),
+				detail::get_ndmul_kernel(c, c, c)});
+			break;
+		case op::reduced_sum:
+			detail::add_kernels(r, {
+				detail::get_reduced_sum_kernel(c, c)});
+			break;
+		case op::memset_zero:
+			detail::add_kernels(r, {
+				detail::memset_zero_kernel_name(f),
+				detail::memset_zero_kernel_name(c)});
+			break;
+		case op::memset_ones:
+			detail::add_kernels(r, {
+				detail::memset_ones_kernel_name(f),
+				detail::memset_ones_kernel_name(c)});
+			break;
+		case op::split_interleaved:
+			detail::add_kernels(r, {
+				detail::get_s2i_kernel(f, f, c),
+				detail::get_i2s_kernel(c, f, f)});
+			break;
+		case op::planar:
+			detail::add_kernels(r, {
+				detail::get_planar_kernel("add_planar_float")});
+			break;
+		case op::hermitian:
+			detail::add_kernels(r, {
+				detail::get_hermitian_expand_kernel(c, c),
+				detail::get_hermitian_compress_kernel(c, c)});
+			break;
+	}
+	return r;
+}
+
+/**
+ * build the kernels of math operations in the background
+ *
+ * the first call of an operation does not block on the compiler if its
+ * kernels were built before, print_build_report prints the build times
+ *
+ * @param d device the kernels are built for
+ * @param ops operations
+ */
+template <typename... Ops>
+precompiler precompile(device& d, Ops... ops)
+{
+	std::vector<kernel_source> kernels;
+	for (op o : {ops...}) {
+		std::vector<kernel_source> k = get_kernel_sources(d, o);
+		kernels.insert(kernels.end(), k.begin(), k.end());
+	}
+	return precompiler(d, kernels);
+}
+
+/**
+ * build the kernels of all math operations in the background
+ *
+ * @param d device the kernels are built for
+ */
+inline precompiler precompile_all(device& d)
+{
+	return precompile(d, op::add, op::sub, op::mul, op::div, op::conj,
+			op::exp, op::sqrt, op::fma, op::axpy, op::dot,
+			op::norm2, op::sum, op::ndmul, op::reduced_sum,
+			op::memset_zero, op::memset_ones,
+			op::split_interleaved, op::planar, op::hermitian);
+}
+
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_PRECOMPILE_HPP
+
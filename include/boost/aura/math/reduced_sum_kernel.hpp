@@ -31,7 +31,7 @@ inline std::tuple<const char*,const char*> get_reduced_sum_kernel(cfloat, cfloat
 			unsigned long n)
 	{
         int dimensions = N/n; 
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
                 for (int j = 0; j < dimensions; j++) {
                   if (i < n)
                        dst[i] += src[i+j*n] ; 
@@ -0,0 +1,138 @@
+#ifndef AURA_MATH_REDUCTION_CONFIG_HPP
+#define AURA_MATH_REDUCTION_CONFIG_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/aura/backend.hpp>
+#include <boost/aura/autotune.hpp>
+#include <boost/aura/math/partition_mesh.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+namespace detail
+{
+
+/**
+ * default launch configuration of a reduction on a device
+ *
+ * the bundle size is limited by the maximum bundle size and the local
+ * memory of the device, CPU devices run few fibers that sum many
+ * elements each, their local memory is ordinary cached memory
+ *
+ * @param d device
+ * @param bundle preferred bundle size (a power of two)
+ * @param size size of an element of the local memory buffer
+ */
+inline launch_config get_reduction_default(device& d, std::size_t bundle,
+		std::size_t size)
+{
+	device_info di = device_get_info(d);
+	while (bundle > 1 && (bundle > di.max_fibers_per_bundle ||
+				bundle*size > di.local_memory)) {
+		bundle /= 2;
+	}
+	return launch_config(bundle, 1, di.cpu ? 16 : 1);
+}
+
+/**
+ * launch configurations tried for reductions (sum, norm2, dot), bundle
+ * sizes from 64 to 512 and 1, 4 or 16 elements per fiber, the default
+ * configuration comes first
+ *
+ * @param d device
+ * @param bundle preferred bundle size (a power of two)
+ * @param size size of an element of the local memory buffer
+ */
+inline std::vector<launch_config> get_reduction_candidates(device& d,
+		std::size_t bundle, std::size_t size)
+{
+	const launch_config first = get_reduction_default(d, bundle, size);
+	std::vector<launch_config> r(1, first);
+	device_info di = device_get_info(d);
+	const std::size_t epf[] = {1, 4, 16};
+	for (std::size_t b=64; b<=512 && b<=di.max_fibers_per_bundle &&
+			b*size<=di.local_memory; b*=2) {
+		for (auto e : epf) {
+			launch_config c(b, 1, e);
+			if (c != first) {
+				r.push_back(c);
+			}
+		}
+	}
+	return r;
+}
+
+/**
+ * specialize the source of a reduction kernel for a configuration, the
+ * kernel uses AURA_BUNDLE_SIZE and AURA_ELEMENTS_PER_FIBER, every
+ * configuration is compiled to its own module
+ */
+inline std::string get_reduction_source(const char* source,
+		const launch_config& c)
+{
+	return std::string("#define AURA_BUNDLE_SIZE ") +
+		std::to_string(c.bundle) + "\n" +
+		"#define AURA_ELEMENTS_PER_FIBER " +
+		std::to_string(c.elements_per_fiber) + "\n" + source;
+}
+
+/**
+ * launch configuration and specialized source of a reduction
+ *
+ * the configuration chosen for a device and size class is kept in the
+ * launch cache of the device context, the tuning database is asked and
+ * the candidates are computed only the first time
+ *
+ * @param d device
+ * @param f feed run issues its commands to
+ * @param name kernel identity
+ * @param source kernel source
+ * @param n number of elements
+ * @param bundle preferred bundle size (a power of two)
+ * @param size size of an element of the local memory buffer
+ * @param run issue the reduction using a configuration
+ */
+template <typename Run>
+inline const aura::detail::tuned_launch& get_reduction_launch(device& d,
+		feed& f, const char* name, const char* source, std::size_t n,
+		std::size_t bundle, std::size_t size, Run run)
+{
+	auto& cache = d.get_context()->get_launch_cache();
+	std::size_t sc = aura::detail::get_size_class(n);
+	const aura::detail::tuned_launch* l = cache.find_launch(name, sc);
+	if (nullptr == l) {
+		launch_config c = tuned_config(d, f, name, n,
+				get_reduction_candidates(d, bundle, size), run);
+		aura::detail::tuned_launch t;
+		t.config = c;
+		t.source = get_reduction_source(source, c);
+		l = cache.set_launch(name, sc, t);
+	}
+	return *l;
+}
+
+/**
+ * mesh of a reduction of n elements, every bundle reduces
+ * bundle*elements_per_fiber consecutive elements
+ */
+inline mesh get_reduction_mesh(std::size_t n, const launch_config& c)
+{
+	std::size_t per_bundle = c.bundle * c.elements_per_fiber;
+	std::size_t bundles = (n + per_bundle - 1) / per_bundle;
+	std::vector<std::size_t> mesh_size(3,1);
+	partition_mesh(mesh_size, bundles*c.bundle, c.bundle);
+	return mesh(mesh_size[0], mesh_size[1], mesh_size[2]);
+}
+
+} // namespace detail
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_REDUCTION_CONFIG_HPP
+
@@ -2,11 +2,13 @@
 #define AURA_MATH_SPECIAL_NDMUL_HPP
 
 #include <tuple>
+#include <string>
 #include <cassert>
 
 #include <boost/aura/meta/traits.hpp>
 #include <boost/aura/backend.hpp>
 #include <boost/aura/math/complex.hpp>
+#include <boost/aura/math/specialize.hpp>
 
 namespace boost
 {
@@ -31,7 +33,11 @@ inline std::tuple<const char*,const char*> get_ndmul_kernel(float, float, float)
 			unsigned long n,
 			unsigned long N_nd)
 	{
-		unsigned int i = get_mesh_id();
+	#ifdef AURA_NDMUL_N
+		n = AURA_NDMUL_N;
+		N_nd = AURA_NDMUL_N_ND;
+	#endif
+		AURA_INDEX i = get_mesh_id();
 		if (i < N_nd) {
 			dst_nd[i] = src[i%n] * src_nd[i];
 		}		
@@ -53,7 +59,11 @@ inline std::tuple<const char*,const char*> get_ndmul_kernel(float, cfloat, cfloa
             unsigned long n,
             unsigned long N_nd)
     {
-        unsigned int i = get_mesh_id();
+    #ifdef AURA_NDMUL_N
+        n = AURA_NDMUL_N;
+        N_nd = AURA_NDMUL_N_ND;
+    #endif
+        AURA_INDEX i = get_mesh_id();
         if (i < N_nd) {
             dst_nd[i] = cmulf(make_cfloat(src[i%n],0), src_nd[i]);
         }
@@ -75,7 +85,11 @@ inline std::tuple<const char*,const char*> get_ndmul_kernel(cfloat, cfloat, cflo
 			unsigned long n,
 			unsigned long N_nd)
 	{
-		unsigned int i = get_mesh_id();
+	#ifdef AURA_NDMUL_N
+		n = AURA_NDMUL_N;
+		N_nd = AURA_NDMUL_N_ND;
+	#endif
+		AURA_INDEX i = get_mesh_id();
 		if (i < N_nd) {
 			dst_nd[i] = cmulf(src[i%n], src_nd[i]);
 		}		
@@ -116,9 +130,16 @@ void ndmul(const DeviceRangeType1& input_range1,
 			aura::traits::get_value_type(input_range2),
 			aura::traits::get_value_type(output_range));
 
+	// sizes are constants of the kernel if specialization is enabled
+	std::string source = detail::specialize_source(
+			std::get<1>(kernel_data), {
+				{"AURA_NDMUL_N", aura::traits::size(input_range1)},
+				{"AURA_NDMUL_N_ND",
+					aura::traits::size(input_range2)}});
+
 	backend::kernel k = aura::traits::get_device(output_range).
 		load_from_string(std::get<0>(kernel_data),
-				std::get<1>(kernel_data),
+				source.c_str(),
 				AURA_BACKEND_COMPILE_FLAGS, true);
 
 	// input_range2 > input_range1 
@@ -127,7 +148,8 @@ void ndmul(const DeviceRangeType1& input_range1,
 				aura::traits::begin_raw(input_range2),
 				aura::traits::begin_raw(output_range),
 				aura::traits::size(input_range1),
-				aura::traits::size(input_range2)), f);
+				aura::traits::size(input_range2)),
+			f, bounds_fit::padded);
 	return;
 }
 
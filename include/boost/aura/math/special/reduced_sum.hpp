@@ -2,11 +2,13 @@
 #define AURA_MATH_SPECIAL_REDUCED_SUM_HPP
 
 #include <tuple>
+#include <string>
 #include <cassert>
 
 #include <boost/aura/meta/traits.hpp>
 #include <boost/aura/backend.hpp>
 #include <boost/aura/math/complex.hpp>
+#include <boost/aura/math/specialize.hpp>
 
 namespace boost
 {
@@ -30,8 +32,12 @@ inline std::tuple<const char*,const char*> get_reduced_sum_kernel(cfloat, cfloat
 			unsigned long N,
 			unsigned long n)
 	{
+	#ifdef AURA_REDUCED_SUM_SIZE
+		N = AURA_REDUCED_SUM_SIZE;
+		n = AURA_REDUCED_SUM_OUTPUT_SIZE;
+	#endif
 		int dimensions = N/n; 
-		unsigned int i = get_mesh_id();
+		AURA_INDEX i = get_mesh_id();
 
         if (i < n)
             dst[i] = make_cfloat(0.,0.);
@@ -63,9 +69,17 @@ void reduced_sum(const DeviceRangeType1& input_range,
 			aura::traits::get_value_type(input_range),
 			aura::traits::get_value_type(output_range));
 
+	// sizes are constants of the kernel if specialization is enabled
+	std::string source = detail::specialize_source(
+			std::get<1>(kernel_data), {
+				{"AURA_REDUCED_SUM_SIZE",
+					aura::traits::size(input_range)},
+				{"AURA_REDUCED_SUM_OUTPUT_SIZE",
+					aura::traits::size(output_range)}});
+
 	backend::kernel k = aura::traits::get_device(output_range).
 		load_from_string(std::get<0>(kernel_data),
-				std::get<1>(kernel_data),
+				source.c_str(),
 				AURA_BACKEND_COMPILE_FLAGS, true);
 
 	invoke(k, aura::traits::bounds(input_range), 
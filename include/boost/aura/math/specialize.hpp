@@ -0,0 +1,54 @@
+#ifndef AURA_MATH_SPECIALIZE_HPP
+#define AURA_MATH_SPECIALIZE_HPP
+
+#include <string>
+#include <utility>
+#include <cstddef>
+#include <initializer_list>
+
+#include <boost/aura/config.hpp>
+
+namespace boost
+{
+namespace aura
+{
+namespace math
+{
+namespace detail
+{
+
+/// name and value of a problem constant of a kernel
+typedef std::pair<const char*, std::size_t> kernel_constant;
+
+/**
+ * specialize the source of a kernel for problem constants
+ *
+ * if AURA_MATH_SPECIALIZE is 1 every constant is defined at the top of
+ * the source, the kernel uses the defines instead of its arguments,
+ * modules are cached by their source, so every shape is built once per
+ * device, otherwise the source is returned unchanged
+ *
+ * @param source kernel source
+ * @param constants names and values of the defines
+ */
+inline std::string specialize_source(const char* source,
+		std::initializer_list<kernel_constant> constants)
+{
+	if (!AURA_MATH_SPECIALIZE) {
+		return source;
+	}
+	std::string r;
+	for (auto& c : constants) {
+		r += std::string("#define ") + c.first + " " +
+			std::to_string(c.second) + "UL\n";
+	}
+	return r + source;
+}
+
+} // namespace detail
+} // namespace math
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MATH_SPECIALIZE_HPP
+
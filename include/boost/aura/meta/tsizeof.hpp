@@ -1,6 +1,8 @@
 #ifndef AURA_META_TSIZEOF_HPP
 #define AURA_META_TSIZEOF_HPP
 
+#include <cstddef>
+
 namespace boost {
 namespace aura {
 
@@ -8,6 +10,12 @@ namespace aura {
 template<typename... Targs>
 struct tsizeof;
 
+template<>
+struct tsizeof<>
+{
+	enum ts : size_t {sz = 0};
+};
+
 template<typename T0>
 struct tsizeof<T0>
 {
@@ -20,6 +28,70 @@ struct tsizeof<T0,Targs...>
 	enum ts : size_t { sz = sizeof(T0) + tsizeof<Targs...>::sz };
 };
 
+/// Compiletime largest alignment of pack of types.
+template<typename... Targs>
+struct talignof;
+
+template<>
+struct talignof<>
+{
+	enum ta : size_t {al = 1};
+};
+
+template<typename T0, typename... Targs>
+struct talignof<T0,Targs...>
+{
+	enum ta : size_t { al = alignof(T0) > talignof<Targs...>::al ?
+		alignof(T0) : talignof<Targs...>::al };
+};
+
+/**
+ * Compiletime layout of pack of types stored one after another, each
+ * type at an offset that is a multiple of its alignment, Offset is the
+ * offset of the first type.
+ */
+template<std::size_t Offset, typename... Targs>
+struct tlayout;
+
+template<std::size_t Offset>
+struct tlayout<Offset>
+{
+	enum tl : size_t {sz = Offset};
+
+	static constexpr std::size_t offset(std::size_t)
+	{
+		return Offset;
+	}
+
+	static constexpr std::size_t size(std::size_t)
+	{
+		return 0;
+	}
+};
+
+template<std::size_t Offset, typename T0, typename... Targs>
+struct tlayout<Offset,T0,Targs...>
+{
+	enum tl : size_t {
+		begin = (Offset + alignof(T0) - 1) / alignof(T0) * alignof(T0),
+		sz = tlayout<begin + sizeof(T0), Targs...>::sz
+	};
+
+	/// offset of type i
+	static constexpr std::size_t offset(std::size_t i)
+	{
+		return 0 == i ? (std::size_t)begin :
+			tlayout<begin + sizeof(T0), Targs...>::offset(i-1);
+	}
+
+	/// size of type i
+	static constexpr std::size_t size(std::size_t i)
+	{
+		return 0 == i ? sizeof(T0) :
+			tlayout<begin + sizeof(T0), Targs...>::size(i-1);
+	}
+};
+
 } // namespace aura
 } // namespace boost
 
@@ -11,11 +11,34 @@
 #define AURA_MISC_COO_HPP
 
 #include <tuple>
+#include <array>
+#include <string>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <complex>
 #include <vector>
+#include <new>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <cstdio>
+#include <cstdlib>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <boost/move/move.hpp>
+#include <boost/aura/config.hpp>
 #include <boost/aura/bounds.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/copy.hpp>
+#include <boost/aura/host_allocator.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/misc/lz.hpp>
 
 namespace boost
 {
@@ -41,27 +64,118 @@ inline void fill_stride_end(std::vector<coo_index>& result)
 	}
 }
 
-inline std::array<char, 4096> coo_build_header(const std::vector<coo_index>& data)
+/// payload types of coo files
+enum coo_type
+{
+	coo_unknown = 0,
+	coo_float,
+	coo_cfloat,
+	coo_double,
+	coo_cdouble,
+	coo_int16
+};
+
+/// compression of chunks
+enum coo_codec
+{
+	coo_uncompressed = 0,
+	/// LZ4 block format, see misc/lz.hpp
+	coo_lz4
+};
+
+/// current version of the coo format written by coo_write
+static const int coo_version = 2;
+
+/**
+ * parsed coo header
+ *
+ * version 1 files have no version line and always say "Type: float",
+ * the type is derived from the cardinality of dimension 0
+ *
+ * version 2 files add a version line and optionally a chunk line
+ * after the dimensions, readers of version 1 ignore both, a chunked
+ * file is laid out as header (4096 bytes), chunks, chunk index
+ * (chunks pairs of 64 bit byte offset and byte size)
+ */
+struct coo_header
+{
+	inline coo_header() : version(1), type(coo_unknown), cardinality(1),
+		codec(coo_uncompressed), planes(0), chunks(0), index(0) {}
+
+	/// true if chunks are compressed
+	bool compressed() const
+	{
+		return coo_uncompressed != codec;
+	}
+
+	int version;
+	coo_type type;
+	/// size of dimension 0 (2 for complex data)
+	unsigned long cardinality;
+	/// bounds without dimension 0, higher dimensions of size 1 squeezed
+	bounds b;
+	coo_codec codec;
+	/// planes (slowest dimension of b) per chunk, 0 if no chunk index
+	std::size_t planes;
+	/// number of chunks
+	std::size_t chunks;
+	/// byte offset of the chunk index
+	std::uint64_t index;
+};
+
+inline const char* coo_type_name(coo_type t)
+{
+	switch (t) {
+		case coo_float: return "float";
+		case coo_cfloat: return "cfloat";
+		case coo_double: return "double";
+		case coo_cdouble: return "cdouble";
+		case coo_int16: return "int16";
+		default: return "unknown";
+	}
+}
+
+inline const char* coo_codec_name(coo_codec c)
+{
+	return coo_lz4 == c ? "lz4" : "none";
+}
+
+inline std::array<char, 4096> coo_build_header(
+		const std::vector<coo_index>& data,
+		const coo_header& h = coo_header())
 {
 	std::array<char, 4096> header;
         header.fill(0);
 	int p = 0;
+	// version 1 only knew float
+	const char* type = 1 == h.version ? "float" : coo_type_name(h.type);
         p += snprintf(&header[0], 4096, 
-			"Type: float\nDimensions: %lu\n", data.size());
+			"Type: %s\nDimensions: %lu\n", type, data.size());
 
         for (std::size_t n = 0; n < data.size(); n++) {
                 p += snprintf(&header[0] + p, 4096 - p, 
 			"[%ld\t%ld\t%ld\t%ld]\n", data[n].start, data[n].end, 
 			data[n].size, data[n].stride);
 	}
+	if (h.version > 1) {
+		p += snprintf(&header[0] + p, 4096 - p,
+				"Version: %d\n", h.version);
+	}
+	if (h.chunks > 0) {
+		p += snprintf(&header[0] + p, 4096 - p,
+				"Chunks: %lu %lu %s %llu\n",
+				(unsigned long)h.chunks, (unsigned long)h.planes,
+				coo_codec_name(h.codec),
+				(unsigned long long)h.index);
+	}
 	return header;
 }
 
-inline bounds coo_parse_header(const std::array<char, 4096>& header)
+inline coo_header coo_parse(const std::array<char, 4096>& header)
 {
-	bounds b;
+	coo_header h;
 	unsigned int dims = 0;
-	char name[10];
+	char name[10] = { 0 };
 	int pos = 0;
 	int c = 0;
 
@@ -78,21 +192,60 @@ inline bounds coo_parse_header(const std::array<char, 4096>& header)
 		sscanf(&header[pos], "[%ld %ld %ld %ld]\n%n",
 			&start, &end, &size, &stride, &c);
 		if (i>0) {
-			b.push_back(size);
+			h.b.push_back(size);
+		} else {
+			h.cardinality = size;
 		}
 		pos += c;
 		assert(pos <= 4096);
 	}
 
 	// squeeze higher dimensions
-	for (unsigned int i=b.size()-1; i>=0; i--) {
-		if (b[i] == 1) {
-			(void)b.pop_back();	
-		} else {
-			break;	
+	while (h.b.size() > 0 && h.b[h.b.size()-1] == 1) {
+		(void)h.b.pop_back();	
+	}
+
+	// optional version 2 lines
+	c = 0;
+	if (1 == sscanf(&header[pos], "Version: %d\n%n", &h.version, &c)) {
+		pos += c;
+	}
+	unsigned long chunks = 0;
+	unsigned long planes = 0;
+	unsigned long long index = 0;
+	char codec[16] = { 0 };
+	if (4 == sscanf(&header[pos], "Chunks: %lu %lu %15s %llu\n",
+				&chunks, &planes, codec, &index)) {
+		h.chunks = chunks;
+		h.planes = planes;
+		h.index = index;
+		if (0 == strcmp(codec, "lz4")) {
+			h.codec = coo_lz4;
+		} else if (0 != strcmp(codec, "none")) {
+			throw std::runtime_error("unknown coo compression");
 		}
 	}
-	return b;
+
+	if (h.version < 2) {
+		// the type field of version 1 files is meaningless
+		h.type = 2 == h.cardinality ? coo_cfloat : coo_float;
+	} else if (0 == strcmp(name, "float")) {
+		h.type = coo_float;
+	} else if (0 == strcmp(name, "cfloat")) {
+		h.type = coo_cfloat;
+	} else if (0 == strcmp(name, "double")) {
+		h.type = coo_double;
+	} else if (0 == strcmp(name, "cdouble")) {
+		h.type = coo_cdouble;
+	} else if (0 == strcmp(name, "int16")) {
+		h.type = coo_int16;
+	}
+	return h;
+}
+
+inline bounds coo_parse_header(const std::array<char, 4096>& header)
+{
+	return coo_parse(header).b;
 }
 
 template <typename T>
@@ -108,27 +261,92 @@ struct coo_cardinality<std::complex<T> > {
     static const int cardinality = 2;
 };
 
-template <typename InputIt, typename Bounds>
-void coo_write(const InputIt first, const Bounds& b, const char* filename)
+/// coo payload type of T
+template <typename T>
+struct coo_type_of
+{
+	static const coo_type value = coo_unknown;
+};
+
+template <>
+struct coo_type_of<float>
+{
+	static const coo_type value = coo_float;
+};
+
+template <>
+struct coo_type_of<std::complex<float> >
+{
+	static const coo_type value = coo_cfloat;
+};
+
+template <>
+struct coo_type_of<double>
+{
+	static const coo_type value = coo_double;
+};
+
+template <>
+struct coo_type_of<std::complex<double> >
+{
+	static const coo_type value = coo_cdouble;
+};
+
+template <>
+struct coo_type_of<std::int16_t>
+{
+	static const coo_type value = coo_int16;
+};
+
+/// throw if a file holding type t can not be read as T
+template <typename T>
+void coo_check_type(const coo_header& h)
+{
+	if (coo_unknown != coo_type_of<T>::value && coo_unknown != h.type &&
+			coo_type_of<T>::value != h.type) {
+		throw std::runtime_error(std::string("coo file holds ") +
+				coo_type_name(h.type) + " data");
+	}
+}
+
+/// build the index dimensions of a coo file
+template <typename T, typename Bounds>
+std::vector<coo_index> coo_build_index(const Bounds& b)
 {
-	// build a coo index object
 	std::vector<coo_index> ci(16, coo_index());
-	ci[0].size = coo_cardinality<typename InputIt::value_type>::cardinality;
+	ci[0].size = coo_cardinality<T>::cardinality;
 	for (std::size_t s=0; s<b.size(); s++) {
 		ci[s+1].size = b[s];
 	}
 	fill_stride_end(ci);
+	return ci;
+}
 
+/// open coo file for writing and write the header for type T
+template <typename T, typename Bounds>
+void coo_open(std::ofstream& stream, const Bounds& b, const char* filename)
+{
 	// create the header
-	auto header = coo_build_header(ci);
+	coo_header h;
+	h.version = coo_version;
+	h.type = coo_type_of<T>::value;
+	auto header = coo_build_header(coo_build_index<T>(b), h);
 
 	// open the file
-	std::ofstream stream(filename, std::ios::out|std::ios::binary);
+	stream.open(filename, std::ios::out|std::ios::binary);
 	// tell the stream to throw on problems, like a non-existing file.
 	stream.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
 	
 	// write the header
 	stream.write(&header[0], header.size());
+}
+
+template <typename InputIt, typename Bounds>
+void coo_write(const InputIt first, const Bounds& b, const char* filename)
+{
+	std::ofstream stream;
+	coo_open<typename std::iterator_traits<InputIt>::value_type>(
+			stream, b, filename);
 
 	// write the data
 	stream.write((char*)std::addressof(*first), 
@@ -139,42 +357,450 @@ void coo_write(const InputIt first, const Bounds& b, const char* filename)
 			product(b));
 }
 
-// coo_write for standard aura device_arrays
+/**
+ * write a chunked coo file, chunks are planes along the slowest dimension
+ * and are compressed individually, a chunk index is appended
+ *
+ * uncompressed chunked files can be read by version 1 readers
+ *
+ * @param first iterator to contiguous data
+ * @param b bounds of the data
+ * @param filename file to write
+ * @param planes number of planes (slowest dimension) per chunk
+ * @param codec compression of the chunks
+ */
+template <typename InputIt, typename Bounds>
+void coo_write(const InputIt first, const Bounds& b, const char* filename,
+		std::size_t planes, coo_codec codec = coo_lz4)
+{
+	typedef typename std::iterator_traits<InputIt>::value_type T;
+	assert(planes > 0);
+	std::size_t slowest = b.size() > 0 ? b[b.size()-1] : 1;
+	std::size_t plane = product(b) / std::max<std::size_t>(1, slowest);
+
+	coo_header h;
+	h.version = coo_version;
+	h.type = coo_type_of<T>::value;
+	h.codec = codec;
+	h.planes = std::min(planes, std::max<std::size_t>(1, slowest));
+	h.chunks = (slowest + h.planes - 1) / h.planes;
+	std::vector<coo_index> ci = coo_build_index<T>(b);
+
+	std::ofstream stream(filename, std::ios::out|std::ios::binary);
+	stream.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
+	// header is rewritten once the index offset is known
+	auto header = coo_build_header(ci, h);
+	stream.write(&header[0], header.size());
+
+	const T* data = (const T*)std::addressof(*first);
+	std::vector<std::uint64_t> index(2*h.chunks);
+	std::vector<char> buffer;
+	std::uint64_t offset = header.size();
+	for (std::size_t i=0; i<h.chunks; i++) {
+		std::size_t n = plane * std::min(h.planes, slowest - i*h.planes);
+		const char* src = (const char*)(data + i*h.planes*plane);
+		std::size_t size = n*sizeof(T);
+		if (h.compressed()) {
+			buffer.clear();
+			size = lz_compress(src, size, buffer);
+			src = buffer.data();
+		}
+		stream.write(src, size);
+		index[2*i] = offset;
+		index[2*i+1] = size;
+		offset += size;
+	}
+	h.index = offset;
+	stream.write((const char*)index.data(),
+			index.size()*sizeof(std::uint64_t));
+	header = coo_build_header(ci, h);
+	stream.seekp(0);
+	stream.write(&header[0], header.size());
+}
+
+/// read the chunk index of a chunked coo file
+inline std::vector<std::uint64_t> coo_read_index(std::istream& stream,
+		const coo_header& h)
+{
+	std::vector<std::uint64_t> index(2*h.chunks);
+	stream.seekg(h.index);
+	stream.read((char*)index.data(), index.size()*sizeof(std::uint64_t));
+	return index;
+}
+
+/**
+ * read the chunks of a compressed coo file
+ *
+ * @param stream file, positioned anywhere
+ * @param h parsed header
+ * @param dst output, holds product(h.b) elements
+ */
+template <typename T>
+void coo_read_chunks(std::istream& stream, const coo_header& h, T* dst)
+{
+	std::size_t slowest = h.b.size() > 0 ? h.b[h.b.size()-1] : 1;
+	std::size_t plane = product(h.b) / std::max<std::size_t>(1, slowest);
+	std::vector<std::uint64_t> index = coo_read_index(stream, h);
+	std::vector<char> buffer;
+	for (std::size_t i=0; i<h.chunks; i++) {
+		std::size_t n = plane * std::min(h.planes, slowest - i*h.planes);
+		buffer.resize(index[2*i+1]);
+		stream.seekg(index[2*i]);
+		stream.read(buffer.data(), buffer.size());
+		char* out = (char*)(dst + i*h.planes*plane);
+		if (n*sizeof(T) != lz_decompress(buffer.data(), buffer.size(),
+					out, n*sizeof(T))) {
+			throw std::runtime_error("coo chunk is truncated");
+		}
+	}
+}
+
+namespace detail
+{
+
+/**
+ * copy device memory to a stream in chunks through two pinned staging
+ * buffers, the transfer of chunk k+1 overlaps with writing chunk k,
+ * the staging buffers come from the pinned host pool of the device
+ */
 template <typename T>
-void coo_write(const boost::aura::device_array<T> &gpuData, const char* filename, feed &f)
+void coo_stream_from_device(std::ofstream& stream, device_ptr<T> src,
+		std::size_t n, feed& f)
 {
-    // get data dimension
-    aura::bounds b = gpuData.get_bounds();
+	std::size_t chunk = std::max<std::size_t>(1,
+			AURA_COO_CHUNK_SIZE / sizeof(T));
+	std::size_t size = std::min(chunk, n);
+	host_allocator<T> alloc(f);
+	std::array<T*, 2> staging = {{
+		alloc.allocate(size),
+		alloc.allocate(size)
+	}};
+	std::array<backend::mark, 2> done;
+	std::size_t chunks = (n + chunk - 1) / chunk;
+	try {
+		for (std::size_t i=0; i<=chunks; i++) {
+			if (i < chunks) {
+				std::size_t c = std::min(chunk, n - i*chunk);
+				backend::copy(staging[i%2], src + i*chunk, c, f);
+				backend::insert(f, done[i%2]);
+			}
+			if (i > 0) {
+				std::size_t p = i-1;
+				std::size_t c = std::min(chunk, n - p*chunk);
+				backend::wait_for(done[p%2]);
+				stream.write((char*)staging[p%2], c*sizeof(T));
+			}
+		}
+	} catch (...) {
+		wait_for(f);
+		alloc.deallocate(staging[0], size);
+		alloc.deallocate(staging[1], size);
+		throw;
+	}
+	alloc.deallocate(staging[0], size);
+	alloc.deallocate(staging[1], size);
+}
 
-    // create temporary cpu array
-    std::vector<T> cpuData(b);
+/**
+ * copy host memory to the device in chunks through two pinned staging
+ * buffers, the copy into one buffer overlaps with the transfer of the
+ * other, the source is typically a file mapping (coo_view), the staging
+ * buffers come from the pinned host pool of the device
+ */
+template <typename T>
+void coo_stream_to_device(const T* src, device_ptr<T> dst, std::size_t n,
+		feed& f)
+{
+	std::size_t chunk = std::max<std::size_t>(1,
+			AURA_COO_CHUNK_SIZE / sizeof(T));
+	std::size_t size = std::min(chunk, n);
+	host_allocator<T> alloc(f);
+	std::array<T*, 2> staging = {{
+		alloc.allocate(size),
+		alloc.allocate(size)
+	}};
+	std::array<backend::mark, 2> done;
+	try {
+		for (std::size_t o=0, i=0; o<n; o+=chunk, i++) {
+			std::size_t c = std::min(chunk, n-o);
+			// wait until the buffer is not used by a transfer anymore
+			if (i >= 2) {
+				backend::wait_for(done[i%2]);
+			}
+			std::memcpy(staging[i%2], src + o, c*sizeof(T));
+			backend::copy(dst + o, staging[i%2], c, f);
+			backend::insert(f, done[i%2]);
+		}
+	} catch (...) {
+		wait_for(f);
+		alloc.deallocate(staging[0], size);
+		alloc.deallocate(staging[1], size);
+		throw;
+	}
+	wait_for(f);
+	alloc.deallocate(staging[0], size);
+	alloc.deallocate(staging[1], size);
+}
 
-    // copy data to cpu
-    boost::aura::copy(gpuData, cpuData, f);
-    boost::aura::wait_for(f);
+} // namespace detail
 
-    // call standard coo_write
-    coo_write(cpuData.begin(), b, filename);
+// coo_write for standard aura device_arrays, streams the data in chunks
+template <typename T>
+void coo_write(const boost::aura::device_array<T> &gpuData, const char* filename, feed &f)
+{
+	std::ofstream stream;
+	coo_open<T>(stream, gpuData.get_bounds(), filename);
+	detail::coo_stream_from_device(stream, gpuData.begin(),
+			gpuData.size(), f);
 }
 
 // more generic coo_write, accepting device ranges
 template <typename DeviceRangeType>
 void coo_write(const DeviceRangeType &gpuData, const char* filename, feed &f)
 {
-    // get data dimension
-    aura::bounds b = gpuData.get_bounds();
+	std::ofstream stream;
+	coo_open<typename DeviceRangeType::value_type>(stream,
+			gpuData.get_bounds(), filename);
+	detail::coo_stream_from_device(stream, gpuData.begin(),
+			gpuData.size(), f);
+}
+
+/// options for mapping coo files
+enum coo_map_flags
+{
+	/// map lazily, pages are read on first access
+	coo_map_default = 0,
+	/// read the whole file while mapping (MAP_POPULATE, Linux only)
+	coo_map_populate = 1,
+	/// access will be sequential, read ahead aggressively
+	coo_map_sequential = 2,
+	/// start reading the whole file in the background
+	coo_map_willneed = 4
+};
+
+/**
+ * coo_view class
+ *
+ * read-only view of the payload of a memory mapped coo file, no host
+ * memory is allocated, pages are shared with the page cache (on Windows
+ * the file is read into host memory instead)
+ */
+template <typename T>
+class coo_view
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(coo_view)
+
+public:
+	typedef T value_type;
+	typedef const T* const_iterator;
+
+	/// create empty view
+	inline explicit coo_view() : base_(nullptr), length_(0) {}
+
+	/**
+	 * map coo file
+	 *
+	 * @param filename file to map
+	 * @param flags combination of coo_map_flags
+	 */
+	inline explicit coo_view(const char* filename,
+			int flags = coo_map_default) :
+		base_(nullptr), length_(0)
+	{
+#ifndef _WIN32
+		int fd = open(filename, O_RDONLY);
+		if (-1 == fd) {
+			throw std::system_error(errno, std::generic_category(),
+					filename);
+		}
+		struct stat st;
+		if (-1 == fstat(fd, &st)) {
+			int error = errno;
+			close(fd);
+			throw std::system_error(error, std::generic_category(),
+					filename);
+		}
+		if (st.st_size < 4096) {
+			close(fd);
+			throw std::runtime_error("coo file without header");
+		}
+		int mflags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+		if (flags & coo_map_populate) {
+			mflags |= MAP_POPULATE;
+		}
+#endif
+		void* base = mmap(NULL, st.st_size, PROT_READ, mflags, fd, 0);
+		int error = errno;
+		// the mapping keeps the file alive
+		close(fd);
+		if (MAP_FAILED == base) {
+			throw std::system_error(error, std::generic_category(),
+					filename);
+		}
+		base_ = base;
+		length_ = st.st_size;
+		if (flags & coo_map_sequential) {
+			madvise(base_, length_, MADV_SEQUENTIAL);
+		}
+		if (flags & coo_map_willneed) {
+			madvise(base_, length_, MADV_WILLNEED);
+		}
+#else
+		// no mmap, the file is read into host memory
+		(void)flags;
+		std::FILE* fp = std::fopen(filename, "rb");
+		if (nullptr == fp) {
+			throw std::system_error(errno, std::generic_category(),
+					filename);
+		}
+		// long is 32 bit on Windows, files may be larger
+		long long size = -1;
+		if (0 == _fseeki64(fp, 0, SEEK_END)) {
+			size = _ftelli64(fp);
+		}
+		if (size < 4096 || 0 != _fseeki64(fp, 0, SEEK_SET)) {
+			std::fclose(fp);
+			throw std::runtime_error("coo file without header");
+		}
+		base_ = std::malloc(size);
+		if (nullptr == base_) {
+			std::fclose(fp);
+			throw std::bad_alloc();
+		}
+		length_ = size;
+		std::size_t read = std::fread(base_, 1, length_, fp);
+		std::fclose(fp);
+		if (read != length_) {
+			finalize();
+			throw std::runtime_error("coo file can not be read");
+		}
+#endif
+
 
-    // create temporary cpu array
-    std::vector<typename DeviceRangeType::value_type> cpuData(b);
+		std::array<char, 4096> header;
+		std::memcpy(&header[0], base_, header.size());
+		coo_header h = coo_parse(header);
+		bounds_ = h.b;
+		if (h.compressed()) {
+			finalize();
+			throw std::runtime_error(
+					"compressed coo files can not be mapped");
+		}
+		try {
+			coo_check_type<T>(h);
+		} catch (...) {
+			finalize();
+			throw;
+		}
+		if (4096 + size()*sizeof(T) > length_) {
+			finalize();
+			throw std::runtime_error("coo file is truncated");
+		}
+	}
+
+	/**
+	 * move constructor, move view here, invalidate other
+	 *
+	 * @param v view to move here
+	 */
+	coo_view(BOOST_RV_REF(coo_view) v) :
+		base_(v.base_), length_(v.length_), bounds_(v.bounds_)
+	{
+		v.base_ = nullptr;
+		v.length_ = 0;
+	}
+
+	/**
+	 * move assignment, move view here, invalidate other
+	 *
+	 * @param v view to move here
+	 */
+	coo_view& operator=(BOOST_RV_REF(coo_view) v)
+	{
+		finalize();
+		base_ = v.base_;
+		length_ = v.length_;
+		bounds_ = v.bounds_;
+		v.base_ = nullptr;
+		v.length_ = 0;
+		return *this;
+	}
+
+	/// destroy view, unmap file
+	inline ~coo_view()
+	{
+		finalize();
+	}
+
+	/// pointer to the payload (page aligned)
+	const T* data() const
+	{
+		return (const T*)((const char*)base_ + 4096);
+	}
+
+	const_iterator begin() const
+	{
+		return data();
+	}
+
+	const_iterator end() const
+	{
+		return data() + size();
+	}
 
-    // copy data to cpu
-    boost::aura::copy(gpuData, cpuData, f);
-    boost::aura::wait_for(f);
+	/// number of elements
+	std::size_t size() const
+	{
+		return nullptr == base_ ? 0 : product(bounds_);
+	}
 
-    // call standard coo_write
-    coo_write(cpuData.begin(), b, filename);
+	/// bounds from the header
+	const bounds& get_bounds() const
+	{
+		return bounds_;
+	}
+
+private:
+	/// finalize object (called from dtor and move assign)
+	void finalize()
+	{
+		if (nullptr != base_) {
+#ifndef _WIN32
+			munmap(base_, length_);
+#else
+			std::free(base_);
+#endif
+			base_ = nullptr;
+			length_ = 0;
+		}
+	}
+
+	/// start of mapping (header)
+	void* base_;
+	/// length of mapping
+	std::size_t length_;
+	/// bounds from the header
+	bounds bounds_;
+};
+
+/// map coo file, see coo_view
+template <typename T>
+coo_view<T> coo_map(const char* filename, int flags = coo_map_default)
+{
+	return coo_view<T>(filename, flags);
 }
 
+/// upload mapped coo file to device through pinned staging buffers
+template <typename T>
+device_array<T> coo_upload(const coo_view<T>& v, aura::device& d, feed& f)
+{
+	device_array<T> r(v.get_bounds(), d);
+	detail::coo_stream_to_device(v.data(), r.begin(), v.size(), f);
+	return r;
+}
 
 template <typename T>
 std::tuple<std::vector<T>, bounds> coo_read(const char* filename)
@@ -192,32 +818,53 @@ std::tuple<std::vector<T>, bounds> coo_read(const char* filename)
 	stream.read(&header[0], header.size());
 
 	// parse header
-	std::get<1>(r) = coo_parse_header(header);
+	coo_header h = coo_parse(header);
+	coo_check_type<T>(h);
+	std::get<1>(r) = h.b;
 	// resize output
 	std::get<0>(r).resize(product(std::get<1>(r)));
 	// read data
-	stream.read((char*)(std::get<0>(r).data()), 
-			std::get<0>(r).size()*sizeof(T));
+	if (h.compressed()) {
+		coo_read_chunks(stream, h, std::get<0>(r).data());
+	} else {
+		stream.read((char*)(std::get<0>(r).data()), 
+				std::get<0>(r).size()*sizeof(T));
+	}
     return r;
 }
 
-// coo read into device array
+/// read and parse the header of a coo file
+inline coo_header coo_read_header(const char* filename)
+{
+	std::ifstream stream(filename, std::ios::in|std::ios::binary);
+	stream.exceptions ( std::ifstream::failbit | std::ifstream::badbit );
+	std::array<char, 4096> header;
+	stream.read(&header[0], header.size());
+	return coo_parse(header);
+}
+
+// coo read into device array, data is mapped and uploaded in chunks,
+// compressed files are decompressed on the host
 template <typename T>
 std::tuple<boost::aura::device_array<T>, bounds> coo_read(const char* filename, aura::device &d, feed &f)
 {
-    // load coo to host memory
-    boost::aura::bounds b;
-    std::vector<T> data;
-    std::tie(data, b) = coo_read<T>(filename);
+    if (coo_read_header(filename).compressed()) {
+        std::vector<T> data;
+        bounds b;
+        std::tie(data, b) = coo_read<T>(filename);
+        std::tuple<aura::device_array<T>, bounds> r;
+        std::get<0>(r) = device_array<T>(b, d);
+        std::get<1>(r) = b;
+        detail::coo_stream_to_device(data.data(), std::get<0>(r).begin(),
+                data.size(), f);
+        return r;
+    }
+    coo_view<T> v(filename, coo_map_sequential);
 
     // create output
     std::tuple<aura::device_array<T>, bounds> r;
-    std::get<0>(r) = aura::device_array<T>(b,d);
-    std::get<1>(r) = b;
-
-    //copy data to device
-    aura::copy(data, std::get<0>(r),f);
-    wait_for(f);
+    std::get<0>(r) = coo_upload(v, d, f);
+    std::get<1>(r) = v.get_bounds();
 
     return(r);
 }
@@ -0,0 +1,356 @@
+#ifndef AURA_MISC_COO_STREAM_HPP
+#define AURA_MISC_COO_STREAM_HPP
+
+#include <tuple>
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <system_error>
+#include <stdexcept>
+#include <algorithm>
+#include <cerrno>
+#include <cassert>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <boost/aura/bounds.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/misc/coo.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// a chunk of planes along the slowest dimension of a coo file
+template <typename T>
+struct coo_chunk
+{
+	/// position of the chunk in the file
+	std::size_t index;
+	/// offset of the first element of the chunk in the volume
+	std::size_t offset;
+	/// bounds of the chunk (slowest dimension is the number of planes)
+	bounds b;
+	/// chunk data, holds product(b) elements
+	std::vector<T> data;
+};
+
+/**
+ * coo_stream class
+ *
+ * reads a coo file as a sequence of chunks along the slowest dimension,
+ * chunks are read by a pool of threads into a bounded ring of buffers,
+ * the consumer can work on chunk 0 while the rest is read
+ *
+ * chunks are handed out in order by acquire() and must be given back
+ * in order by release(), at most depth chunks are held in memory,
+ * more than one chunk can be acquired at the same time (e.g. to keep a
+ * chunk alive until an asynchronous device upload has finished)
+ */
+template <typename T>
+class coo_stream
+{
+
+private:
+	coo_stream(const coo_stream&);
+	coo_stream& operator=(const coo_stream&);
+
+public:
+	/**
+	 * open coo file and start reading
+	 *
+	 * @param filename file to read
+	 * @param planes number of planes (slowest dimension) per chunk,
+	 * ignored for compressed files, they are read in their own chunks
+	 * @param threads number of threads reading concurrently
+	 * @param depth number of chunks buffered
+	 */
+	inline explicit coo_stream(const char* filename, std::size_t planes,
+			std::size_t threads = 2, std::size_t depth = 4) :
+		fd_(-1), depth_(depth), next_(0), acquired_(0), released_(0),
+		stop_(false)
+	{
+		assert(planes > 0 && threads > 0 && depth > 0);
+		fd_ = open(filename, O_RDONLY);
+		if (-1 == fd_) {
+			throw std::system_error(errno, std::generic_category(),
+					filename);
+		}
+#ifdef POSIX_FADV_SEQUENTIAL
+		posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+		std::array<char, 4096> header;
+		try {
+			read(&header[0], header.size(), 0);
+		} catch (...) {
+			close(fd_);
+			throw;
+		}
+		coo_header h = coo_parse(header);
+		compressed_ = h.compressed();
+		bounds_ = h.b;
+
+		// a chunk is a set of planes along the slowest dimension
+		std::size_t slowest = bounds_.size() > 0 ?
+			bounds_[bounds_.size()-1] : 1;
+		plane_ = bounds_.size() > 0 ? product(bounds_) / slowest : 1;
+		// compressed files can only be read in the chunks of the file
+		planes_ = compressed_ ? h.planes : std::min(planes, slowest);
+		count_ = (slowest + planes_ - 1) / planes_;
+		slowest_ = slowest;
+
+		try {
+			coo_check_type<T>(h);
+			if (compressed_) {
+				index_.resize(2*h.chunks);
+				read((char*)index_.data(),
+						index_.size()*sizeof(std::uint64_t), h.index);
+			}
+		} catch (...) {
+			close(fd_);
+			throw;
+		}
+
+		slots_.resize(depth_);
+		ready_.resize(depth_, false);
+		for (std::size_t i=0; i<depth_; i++) {
+			slots_[i].data.resize(plane_*planes_);
+		}
+		for (std::size_t i=0; i<threads; i++) {
+			threads_.push_back(std::thread(&coo_stream::work, this));
+		}
+	}
+
+	/// stop reading, wait for reading threads, close file
+	inline ~coo_stream()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+		for (auto& t : threads_) {
+			t.join();
+		}
+		close(fd_);
+	}
+
+	/// bounds of the volume
+	const bounds& get_bounds() const
+	{
+		return bounds_;
+	}
+
+	/// number of chunks
+	std::size_t get_chunk_count() const
+	{
+		return count_;
+	}
+
+	/**
+	 * wait for the next chunk
+	 *
+	 * rethrows errors from the reading threads
+	 *
+	 * @return the chunk, valid until it is released
+	 */
+	const coo_chunk<T>& acquire()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		assert(acquired_ < count_);
+		std::size_t s = acquired_ % depth_;
+		cv_.wait(lock, [&]() { return ready_[s] || error_; });
+		if (!ready_[s]) {
+			std::rethrow_exception(error_);
+		}
+		acquired_++;
+		return slots_[s];
+	}
+
+	/// release the oldest acquired chunk, its buffer is reused
+	void release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			assert(released_ < acquired_);
+			ready_[released_ % depth_] = false;
+			released_++;
+		}
+		cv_.notify_all();
+	}
+
+private:
+	/// read size bytes at offset from the file, retry partial reads
+	void read(char* dst, std::size_t size, off_t offset)
+	{
+		while (size > 0) {
+			ssize_t r = pread(fd_, dst, size, offset);
+			if (-1 == r && EINTR == errno) {
+				continue;
+			}
+			if (-1 == r) {
+				throw std::system_error(errno,
+						std::generic_category());
+			}
+			if (0 == r) {
+				throw std::runtime_error("coo file is truncated");
+			}
+			dst += r;
+			size -= r;
+			offset += r;
+		}
+	}
+
+	/// reading thread, claims chunks in order as long as buffers are free
+	void work()
+	{
+		// compressed chunk
+		std::vector<char> buffer;
+		while (true) {
+			std::size_t i;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				cv_.wait(lock, [&]() {
+					return stop_ || next_ >= count_ ||
+						next_ < released_ + depth_;
+				});
+				if (stop_ || next_ >= count_) {
+					return;
+				}
+				i = next_++;
+			}
+			coo_chunk<T>& c = slots_[i % depth_];
+			std::size_t planes = std::min(planes_, slowest_-i*planes_);
+			c.index = i;
+			c.offset = i*planes_*plane_;
+			c.b = bounds_;
+			if (c.b.size() > 0) {
+				c.b[c.b.size()-1] = planes;
+			}
+			c.data.resize(planes*plane_);
+			try {
+				if (compressed_) {
+					buffer.resize(index_[2*i+1]);
+					read(buffer.data(), buffer.size(), index_[2*i]);
+					std::size_t size = c.data.size()*sizeof(T);
+					if (size != lz_decompress(buffer.data(),
+								buffer.size(), &c.data[0], size)) {
+						throw std::runtime_error(
+								"coo chunk is truncated");
+					}
+				} else {
+					read((char*)&c.data[0], c.data.size()*sizeof(T),
+							4096 + c.offset*sizeof(T));
+				}
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex_);
+				error_ = std::current_exception();
+				stop_ = true;
+				cv_.notify_all();
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				ready_[i % depth_] = true;
+			}
+			cv_.notify_all();
+		}
+	}
+
+	/// file descriptor, pread is used concurrently by all threads
+	int fd_;
+	/// bounds of the volume
+	bounds bounds_;
+	/// number of elements in a plane
+	std::size_t plane_;
+	/// size of the slowest dimension
+	std::size_t slowest_;
+	/// planes per chunk
+	std::size_t planes_;
+	/// number of chunks
+	std::size_t count_;
+	/// number of buffered chunks
+	std::size_t depth_;
+	/// chunks are compressed
+	bool compressed_;
+	/// byte offset and size of compressed chunks
+	std::vector<std::uint64_t> index_;
+
+	/// next chunk to read
+	std::size_t next_;
+	/// chunks handed out to the consumer
+	std::size_t acquired_;
+	/// chunks given back by the consumer
+	std::size_t released_;
+	/// reading threads should exit
+	bool stop_;
+	/// first error of a reading thread
+	std::exception_ptr error_;
+
+	/// ring of chunk buffers
+	std::vector<coo_chunk<T>> slots_;
+	/// chunk in slot is read and not yet released
+	std::vector<bool> ready_;
+	/// reading threads
+	std::vector<std::thread> threads_;
+	/// protects counters and ready_
+	std::mutex mutex_;
+	/// signals changes of the counters and ready_
+	std::condition_variable cv_;
+};
+
+/**
+ * read coo file into device array, chunks are uploaded as soon as they
+ * are read
+ *
+ * @param filename file to read
+ * @param d device the array is allocated on
+ * @param f feed the upload is executed in
+ * @param planes number of planes (slowest dimension) per chunk
+ * @param threads number of threads reading concurrently
+ */
+template <typename T>
+std::tuple<device_array<T>, bounds> coo_read_streamed(const char* filename,
+		aura::device& d, feed& f, std::size_t planes = 1,
+		std::size_t threads = 2)
+{
+	coo_stream<T> s(filename, planes, threads);
+	std::tuple<device_array<T>, bounds> r;
+	std::get<0>(r) = device_array<T>(s.get_bounds(), d);
+	std::get<1>(r) = s.get_bounds();
+
+	// a chunk is released once the upload of the next one is enqueued
+	std::array<backend::mark, 2> done;
+	try {
+		for (std::size_t i=0; i<s.get_chunk_count(); i++) {
+			const coo_chunk<T>& c = s.acquire();
+			backend::copy(std::get<0>(r).begin() + c.offset,
+					&c.data[0], c.data.size(), f);
+			backend::insert(f, done[i%2]);
+			if (i > 0) {
+				backend::wait_for(done[(i-1)%2]);
+				s.release();
+			}
+		}
+	} catch (...) {
+		// chunk buffers must outlive the enqueued uploads
+		wait_for(f);
+		throw;
+	}
+	wait_for(f);
+	if (s.get_chunk_count() > 0) {
+		s.release();
+	}
+	return r;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MISC_COO_STREAM_HPP
+
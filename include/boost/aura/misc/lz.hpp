@@ -0,0 +1,210 @@
+#ifndef AURA_MISC_LZ_HPP
+#define AURA_MISC_LZ_HPP
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+namespace boost
+{
+namespace aura
+{
+
+/**
+ * fast byte oriented compression, the output is a block in the LZ4 block
+ * format (no frame) and can be decoded by any LZ4 block decoder
+ *
+ * the compressor is a greedy single-probe hash matcher, it trades ratio
+ * for speed
+ */
+
+namespace detail
+{
+
+static const std::size_t lz_min_match = 4;
+// the last match must start 12 bytes before the end of the block
+static const std::size_t lz_mf_limit = 12;
+// the last 5 bytes of a block are always literals
+static const std::size_t lz_last_literals = 5;
+static const std::size_t lz_hash_log = 12;
+static const std::size_t lz_max_offset = 65535;
+
+inline std::uint32_t lz_read32(const unsigned char* p)
+{
+	std::uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline std::size_t lz_hash(std::uint32_t v)
+{
+	return (v * 2654435761u) >> (32 - lz_hash_log);
+}
+
+/// write a length continuation (a sequence of 255 and a remainder)
+inline void lz_write_length(std::vector<char>& dst, std::size_t len)
+{
+	while (len >= 255) {
+		dst.push_back((char)255);
+		len -= 255;
+	}
+	dst.push_back((char)len);
+}
+
+/// write a sequence of literals followed by a match
+inline void lz_write_sequence(std::vector<char>& dst,
+		const unsigned char* literals, std::size_t literal_length,
+		std::size_t offset, std::size_t match_length)
+{
+	unsigned char token =
+		(unsigned char)((literal_length < 15 ? literal_length : 15) << 4);
+	if (match_length > 0) {
+		std::size_t m = match_length - lz_min_match;
+		token |= (unsigned char)(m < 15 ? m : 15);
+	}
+	dst.push_back((char)token);
+	if (literal_length >= 15) {
+		lz_write_length(dst, literal_length - 15);
+	}
+	dst.insert(dst.end(), literals, literals + literal_length);
+	if (match_length == 0) {
+		return;
+	}
+	dst.push_back((char)(offset & 0xff));
+	dst.push_back((char)(offset >> 8));
+	if (match_length - lz_min_match >= 15) {
+		lz_write_length(dst, match_length - lz_min_match - 15);
+	}
+}
+
+/// read a length continuation
+inline std::size_t lz_read_length(const unsigned char*& p,
+		const unsigned char* end)
+{
+	std::size_t len = 0;
+	unsigned char c;
+	do {
+		if (p >= end) {
+			throw std::runtime_error("lz: truncated input");
+		}
+		c = *p++;
+		len += c;
+	} while (c == 255);
+	return len;
+}
+
+} // namespace detail
+
+/**
+ * compress a block
+ *
+ * @param src data to compress
+ * @param size number of bytes to compress
+ * @param dst compressed data is appended here
+ * @return number of compressed bytes appended
+ */
+inline std::size_t lz_compress(const void* src, std::size_t size,
+		std::vector<char>& dst)
+{
+	using namespace detail;
+	const unsigned char* in = (const unsigned char*)src;
+	std::size_t start = dst.size();
+	std::size_t anchor = 0;
+
+	if (size > lz_mf_limit) {
+		// positions are stored +1, 0 is empty, blocks (chunks of
+		// planes) may be larger than 4 GiB
+		std::vector<std::size_t> table(1 << lz_hash_log, 0);
+		std::size_t limit = size - lz_mf_limit;
+		std::size_t match_limit = size - lz_last_literals;
+		std::size_t ip = 0;
+		while (ip < limit) {
+			std::uint32_t v = lz_read32(in + ip);
+			std::size_t h = lz_hash(v);
+			std::size_t ref = table[h];
+			table[h] = ip + 1;
+			if (0 == ref || ip - (ref-1) > lz_max_offset ||
+					lz_read32(in + ref-1) != v) {
+				ip++;
+				continue;
+			}
+			ref--;
+			std::size_t len = lz_min_match;
+			while (ip + len < match_limit && in[ref+len] == in[ip+len]) {
+				len++;
+			}
+			lz_write_sequence(dst, in + anchor, ip - anchor,
+					ip - ref, len);
+			ip += len;
+			anchor = ip;
+		}
+	}
+	lz_write_sequence(dst, in + anchor, size - anchor, 0, 0);
+	return dst.size() - start;
+}
+
+/**
+ * decompress a block
+ *
+ * @param src compressed data
+ * @param size number of compressed bytes
+ * @param dst decompressed data is written here
+ * @param capacity size of the decompressed data
+ * @return number of bytes written to dst
+ * @throw std::runtime_error if the input is corrupt
+ */
+inline std::size_t lz_decompress(const void* src, std::size_t size,
+		void* dst, std::size_t capacity)
+{
+	using namespace detail;
+	const unsigned char* ip = (const unsigned char*)src;
+	const unsigned char* end = ip + size;
+	unsigned char* out = (unsigned char*)dst;
+	std::size_t op = 0;
+
+	while (ip < end) {
+		unsigned char token = *ip++;
+		std::size_t literal_length = token >> 4;
+		if (literal_length == 15) {
+			literal_length += lz_read_length(ip, end);
+		}
+		if ((std::size_t)(end - ip) < literal_length ||
+				capacity - op < literal_length) {
+			throw std::runtime_error("lz: corrupt input");
+		}
+		std::memcpy(out + op, ip, literal_length);
+		ip += literal_length;
+		op += literal_length;
+		// the last sequence has no match
+		if (ip == end) {
+			break;
+		}
+		if (end - ip < 2) {
+			throw std::runtime_error("lz: truncated input");
+		}
+		std::size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		std::size_t match_length = (token & 15);
+		if (match_length == 15) {
+			match_length += lz_read_length(ip, end);
+		}
+		match_length += lz_min_match;
+		if (0 == offset || offset > op || capacity - op < match_length) {
+			throw std::runtime_error("lz: corrupt input");
+		}
+		// matches may overlap their own output
+		const unsigned char* m = out + op - offset;
+		for (std::size_t i=0; i<match_length; i++) {
+			out[op+i] = m[i];
+		}
+		op += match_length;
+	}
+	return op;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_MISC_LZ_HPP
+
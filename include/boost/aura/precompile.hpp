@@ -0,0 +1,285 @@
+#ifndef AURA_PRECOMPILE_HPP
+#define AURA_PRECOMPILE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <ostream>
+#include <iostream>
+#include <exception>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/move/move.hpp>
+#include <boost/aura/config.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/misc/now.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// kernel to build, name of a kernel and source of its module
+struct kernel_source
+{
+	inline kernel_source(const std::string& name,
+			const std::string& source) :
+		name(name), source(source) {}
+
+	/// kernel name
+	std::string name;
+	/// module source
+	std::string source;
+};
+
+/**
+ * time it took to build a module, kernels of the same module are built
+ * once and share a report
+ */
+struct build_report
+{
+	inline build_report() : time(0.), built(false) {}
+
+	/// name of the first kernel of the module
+	std::string name;
+	/// names of all kernels of the module that were asked for
+	std::vector<std::string> kernels;
+	/// build time in microseconds
+	double time;
+	/// false if the build failed or did not finish
+	bool built;
+};
+
+/**
+ * precompiler class
+ *
+ * builds kernels on a device in the background, a pool of threads loads
+ * the kernels into the device (see device::load_from_string), once a
+ * kernel is built, loading it again does not block on the compiler
+ *
+ * the device must outlive the precompiler, the destructor waits for the
+ * builds to finish
+ */
+class precompiler
+{
+
+private:
+	BOOST_MOVABLE_BUT_NOT_COPYABLE(precompiler)
+
+	/// shared by the building threads
+	struct state
+	{
+		state(device& d, const std::vector<kernel_source>& kernels,
+				const std::vector<std::vector<std::string> >&
+					names) :
+			d(d), kernels(kernels), names(names),
+			reports(kernels.size()), next(0), finished(0)
+		{}
+
+		device& d;
+		std::vector<kernel_source> kernels;
+		/// names of the kernels of each module
+		std::vector<std::vector<std::string> > names;
+		std::vector<build_report> reports;
+		/// next kernel to build
+		std::atomic<std::size_t> next;
+		/// number of kernels built
+		std::atomic<std::size_t> finished;
+		/// first error of a building thread
+		std::exception_ptr error;
+		/// protects error
+		std::mutex mutex;
+	};
+
+public:
+	/// create empty precompiler
+	inline explicit precompiler() {}
+
+	/**
+	 * start building kernels
+	 *
+	 * @param d device the kernels are built for
+	 * @param kernels kernels to build, kernels of the same module are
+	 * built once and reported together
+	 * @param threads number of building threads, 0 for one per hardware
+	 * thread
+	 */
+	inline explicit precompiler(device& d,
+			const std::vector<kernel_source>& kernels,
+			std::size_t threads = AURA_PRECOMPILE_THREADS)
+	{
+		std::vector<kernel_source> unique;
+		std::vector<std::vector<std::string> > names;
+		std::unordered_map<std::string, std::size_t> sources;
+		for (auto& k : kernels) {
+			auto it = sources.insert(std::make_pair(k.source,
+						unique.size()));
+			if (it.second) {
+				unique.push_back(k);
+				names.push_back(std::vector<std::string>());
+			}
+			std::vector<std::string>& n = names[it.first->second];
+			if (n.end() == std::find(n.begin(), n.end(), k.name)) {
+				n.push_back(k.name);
+			}
+		}
+		state_.reset(new state(d, unique, names));
+		if (0 == threads) {
+			threads = std::thread::hardware_concurrency();
+		}
+		if (threads > unique.size()) {
+			threads = unique.size();
+		}
+		if (0 == threads && !unique.empty()) {
+			threads = 1;
+		}
+		for (std::size_t i=0; i<threads; i++) {
+			threads_.push_back(std::thread(&precompiler::work,
+						state_.get()));
+		}
+	}
+
+	/**
+	 * move constructor, move precompiler here, invalidate other
+	 *
+	 * @param p precompiler to move here
+	 */
+	precompiler(BOOST_RV_REF(precompiler) p) :
+		state_(std::move(p.state_)),
+		threads_(std::move(p.threads_))
+	{}
+
+	/**
+	 * move assignment, wait for own builds, move precompiler here,
+	 * invalidate other
+	 *
+	 * @param p precompiler to move here
+	 */
+	precompiler& operator=(BOOST_RV_REF(precompiler) p)
+	{
+		join();
+		state_ = std::move(p.state_);
+		threads_ = std::move(p.threads_);
+		return *this;
+	}
+
+	/// wait for the builds to finish
+	inline ~precompiler()
+	{
+		join();
+	}
+
+	/// true if all kernels are built
+	bool done() const
+	{
+		return nullptr == state_ ||
+			state_->finished == state_->kernels.size();
+	}
+
+	/**
+	 * wait for the builds to finish
+	 *
+	 * rethrows the first error of the building threads
+	 *
+	 * @return build time of every module
+	 */
+	const std::vector<build_report>& wait()
+	{
+		static const std::vector<build_report> empty;
+		join();
+		if (nullptr == state_) {
+			return empty;
+		}
+		if (state_->error) {
+			std::rethrow_exception(state_->error);
+		}
+		return state_->reports;
+	}
+
+private:
+	/// building thread, claims kernels in order
+	static void work(state* s)
+	{
+		while (true) {
+			std::size_t i = s->next++;
+			if (i >= s->kernels.size()) {
+				return;
+			}
+			const kernel_source& k = s->kernels[i];
+			build_report& r = s->reports[i];
+			r.name = k.name;
+			r.kernels = s->names[i];
+			double t = now();
+			try {
+				s->d.load_from_string(k.name.c_str(),
+						k.source.c_str(),
+						AURA_BACKEND_COMPILE_FLAGS);
+				r.built = true;
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(s->mutex);
+				if (!s->error) {
+					s->error = std::current_exception();
+				}
+			}
+			r.time = now() - t;
+			s->finished++;
+		}
+	}
+
+	/// wait for the building threads
+	void join()
+	{
+		for (auto& t : threads_) {
+			t.join();
+		}
+		threads_.clear();
+	}
+
+	/// state shared with the building threads
+	std::unique_ptr<state> state_;
+	/// building threads
+	std::vector<std::thread> threads_;
+};
+
+/**
+ * build kernels on a device in the background
+ *
+ * @param d device the kernels are built for
+ * @param kernels kernels to build
+ * @param threads number of building threads, 0 for one per hardware thread
+ */
+inline precompiler precompile(device& d,
+		const std::vector<kernel_source>& kernels,
+		std::size_t threads = AURA_PRECOMPILE_THREADS)
+{
+	return precompiler(d, kernels, threads);
+}
+
+/**
+ * print build times, one module per line with the names of its kernels,
+ * and the sum of the build times
+ */
+inline void print_build_report(const std::vector<build_report>& reports,
+		std::ostream& os = std::cout)
+{
+	double total = 0.;
+	for (auto& r : reports) {
+		for (std::size_t i=0; i<r.kernels.size(); i++) {
+			os << (0 == i ? "" : ", ") << r.kernels[i];
+		}
+		os << ": " << r.time / 1000. << " ms" <<
+			(r.built ? "" : " (failed)") << std::endl;
+		total += r.time;
+	}
+	os << "total: " << total / 1000. << " ms (" << reports.size() <<
+		" modules)" << std::endl;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_PRECOMPILE_HPP
+
@@ -1,13 +1,14 @@
 #ifndef AURA_SLICE_HPP
 #define AURA_SLICE_HPP
 
+#include <cstdint>
 #include <boost/aura/detail/svec.hpp>
 
 namespace boost
 {
 namespace aura {
 
-typedef svec<int> slice;
+typedef svec<std::int64_t> slice;
 
 // let's try this and see if it blows up
 constexpr int _ = -1;
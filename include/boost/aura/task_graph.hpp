@@ -0,0 +1,175 @@
+#ifndef AURA_TASK_GRAPH_HPP
+#define AURA_TASK_GRAPH_HPP
+
+#include <vector>
+#include <cassert>
+#include <functional>
+#include <boost/aura/backend.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/**
+ * task_graph class
+ *
+ * collects copies and kernels together with their dependencies and
+ * issues them with explicit wait lists, tasks that do not depend on each
+ * other can run concurrently if the graph is run in an out_of_order feed
+ * or across several feeds
+ *
+ * a task is an operation that enqueues a command in a feed after the
+ * marks of a wait list and returns the mark of the command, e.g.
+ *
+ *   g.add([&](feed& f, const wait_list& w) {
+ *     return invoke(k, n, args(...), f, w);
+ *   }, {upload});
+ *
+ * tasks can only depend on tasks added before them, so the order tasks
+ * are added in is a valid execution order
+ */
+class task_graph
+{
+
+public:
+	/// task handle
+	typedef std::size_t task;
+	/// operation of a task
+	typedef std::function<backend::mark(feed&, const wait_list&)> operation;
+
+	/// create empty graph
+	inline explicit task_graph() {}
+
+	/**
+	 * add a task
+	 *
+	 * @param op operation of the task
+	 * @param deps tasks that must finish before the task starts
+	 * @return task handle
+	 */
+	task add(operation op, const std::vector<task>& deps = std::vector<task>())
+	{
+		for (auto d : deps) {
+			assert(d < ops_.size());
+			(void)d;
+		}
+		ops_.push_back(op);
+		deps_.push_back(deps);
+		return ops_.size()-1;
+	}
+
+	/// add a copy from host to device memory
+	template <typename T>
+	task add_copy(device_ptr<T> dst, const T* src, std::size_t size,
+			const std::vector<task>& deps = std::vector<task>())
+	{
+		return add([=](feed& f, const wait_list& w) {
+				return backend::copy(dst, src, size, f, w);
+			}, deps);
+	}
+
+	/// add a copy from device to host memory
+	template <typename T>
+	task add_copy(T* dst, device_ptr<T> src, std::size_t size,
+			const std::vector<task>& deps = std::vector<task>())
+	{
+		return add([=](feed& f, const wait_list& w) {
+				return backend::copy(dst, src, size, f, w);
+			}, deps);
+	}
+
+	/// add a copy from device to device memory
+	template <typename T>
+	task add_copy(device_ptr<T> dst, device_ptr<T> src, std::size_t size,
+			const std::vector<task>& deps = std::vector<task>())
+	{
+		return add([=](feed& f, const wait_list& w) {
+				return backend::copy(dst, src, size, f, w);
+			}, deps);
+	}
+
+	/// number of tasks
+	std::size_t size() const
+	{
+		return ops_.size();
+	}
+
+	/**
+	 * issue all tasks in a feed, a feed created with
+	 * feed_order::out_of_order runs independent tasks concurrently
+	 */
+	void run(feed& f)
+	{
+		std::vector<feed*> feeds(1, &f);
+		run(feeds);
+	}
+
+	/**
+	 * issue all tasks across several feeds of the same device
+	 *
+	 * a task runs in the feed of its first dependency (chains stay in
+	 * one feed), tasks without dependencies are distributed round robin
+	 */
+	void run(const std::vector<feed*>& feeds)
+	{
+		assert(!feeds.empty());
+		marks_.clear();
+		marks_.reserve(ops_.size());
+		placement_.assign(ops_.size(), 0);
+		std::size_t next = 0;
+		for (std::size_t i=0; i<ops_.size(); i++) {
+			wait_list w;
+			for (auto d : deps_[i]) {
+				w.add(marks_[d]);
+			}
+			if (deps_[i].empty()) {
+				placement_[i] = next++ % feeds.size();
+			} else {
+				placement_[i] = placement_[deps_[i][0]];
+			}
+			marks_.push_back(ops_[i](*feeds[placement_[i]], w));
+		}
+	}
+
+	/// mark of a task issued by the last run
+	backend::mark& get_mark(task t)
+	{
+		return marks_[t];
+	}
+
+	/// wait until all tasks issued by the last run have finished
+	void wait()
+	{
+		for (auto& m : marks_) {
+			if (!m.empty()) {
+				backend::wait_for(m);
+			}
+		}
+	}
+
+	/// remove all tasks
+	void clear()
+	{
+		ops_.clear();
+		deps_.clear();
+		marks_.clear();
+		placement_.clear();
+	}
+
+private:
+	/// operations
+	std::vector<operation> ops_;
+	/// dependencies of the operations
+	std::vector<std::vector<task> > deps_;
+	/// marks of the last run
+	std::vector<backend::mark> marks_;
+	/// feed index of the tasks of the last run
+	std::vector<std::size_t> placement_;
+};
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_TASK_GRAPH_HPP
+
@@ -0,0 +1,220 @@
+#ifndef AURA_TUNING_DB_HPP
+#define AURA_TUNING_DB_HPP
+
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <boost/aura/detail/launch_cache.hpp>
+
+namespace boost
+{
+namespace aura
+{
+
+/// file the tuned launch configurations are stored in (TMPDIR or /tmp)
+inline std::string get_tuning_db_name()
+{
+	const char* tmp = std::getenv("TMPDIR");
+	std::string p = (nullptr != tmp && 0 != *tmp) ? tmp : "/tmp";
+	return p + "/AURA_tuning_" + std::to_string(getuid());
+}
+
+/**
+ * tuning_db class
+ *
+ * fastest launch configurations of kernels, keyed by device identity,
+ * kernel and size class of the problem (see detail::get_size_class)
+ *
+ * the database is read when it is created and written each time a
+ * configuration is inserted, one configuration per line:
+ *
+ *   device<TAB>kernel<TAB>size class<TAB>bundle<TAB>vector width<TAB>
+ *   elements per fiber
+ *
+ * the file is written to a temporary created with mkstemp next to it
+ * and renamed, write failures are ignored (the database is an
+ * optimization only)
+ */
+class tuning_db
+{
+
+public:
+	/**
+	 * open database
+	 *
+	 * @param p file the configurations are stored in, empty for a
+	 * database that is not stored
+	 */
+	inline explicit tuning_db(const std::string& p = std::string()) :
+		path_(p)
+	{
+		load();
+	}
+
+	/**
+	 * find the configuration of a kernel
+	 *
+	 * @param device device identity
+	 * @param kernel kernel identity
+	 * @param n number of elements
+	 * @param c configuration, only set if found
+	 * @return true if found
+	 */
+	bool find(const std::string& device, const std::string& kernel,
+			std::size_t n, launch_config& c)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = entries_.find(std::make_tuple(device, kernel,
+					detail::get_size_class(n)));
+		if (entries_.end() == it) {
+			return false;
+		}
+		c = it->second;
+		return true;
+	}
+
+	/**
+	 * insert or replace the configuration of a kernel and store the
+	 * database
+	 *
+	 * @param device device identity
+	 * @param kernel kernel identity
+	 * @param n number of elements
+	 * @param c configuration
+	 */
+	void insert(const std::string& device, const std::string& kernel,
+			std::size_t n, const launch_config& c)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_[std::make_tuple(device, kernel,
+				detail::get_size_class(n))] = c;
+		store();
+	}
+
+	/**
+	 * all configurations of a kernel on a device
+	 *
+	 * @return pairs of size class and configuration
+	 */
+	std::vector<std::pair<std::size_t, launch_config> > get(
+			const std::string& device, const std::string& kernel)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::vector<std::pair<std::size_t, launch_config> > r;
+		for (auto& it : entries_) {
+			if (std::get<0>(it.first) == device &&
+					std::get<1>(it.first) == kernel) {
+				r.push_back(std::make_pair(
+						std::get<2>(it.first), it.second));
+			}
+		}
+		return r;
+	}
+
+	/// number of configurations
+	std::size_t size()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.size();
+	}
+
+	/// remove all configurations and store the empty database
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.clear();
+		store();
+	}
+
+private:
+	typedef std::tuple<std::string, std::string, std::size_t> key;
+
+	void load()
+	{
+		if (path_.empty()) {
+			return;
+		}
+		std::ifstream in(path_.c_str());
+		std::string line;
+		while (std::getline(in, line)) {
+			std::istringstream is(line);
+			std::string device, kernel;
+			std::size_t sc;
+			launch_config c;
+			if (!std::getline(is, device, '\t') ||
+					!std::getline(is, kernel, '\t') ||
+					!(is >> sc >> c.bundle >> c.vector_width >>
+						c.elements_per_fiber)) {
+				continue;
+			}
+			entries_[std::make_tuple(device, kernel, sc)] = c;
+		}
+	}
+
+	void store()
+	{
+		if (path_.empty()) {
+			return;
+		}
+		std::ostringstream out;
+		for (auto& it : entries_) {
+			out << std::get<0>(it.first) << "\t" <<
+				std::get<1>(it.first) << "\t" <<
+				std::get<2>(it.first) << "\t" <<
+				it.second.bundle << "\t" <<
+				it.second.vector_width << "\t" <<
+				it.second.elements_per_fiber << "\n";
+		}
+		const std::string data = out.str();
+		// mkstemp creates a new file with an unpredictable name that
+		// only the user can access, a planted file or link is never
+		// opened
+		std::vector<char> tmp(path_.begin(), path_.end());
+		const char suffix[] = ".XXXXXX";
+		tmp.insert(tmp.end(), suffix, suffix + sizeof(suffix));
+		int fd = mkstemp(&tmp[0]);
+		if (-1 == fd) {
+			return;
+		}
+		bool good = true;
+		for (std::size_t done = 0; good && done < data.size(); ) {
+			ssize_t r = write(fd, data.data() + done, data.size() - done);
+			if (r < 0) {
+				good = false;
+			} else {
+				done += r;
+			}
+		}
+		good = 0 == close(fd) && good;
+		if (!good || 0 != std::rename(&tmp[0], path_.c_str())) {
+			std::remove(&tmp[0]);
+		}
+	}
+
+	/// file the configurations are stored in
+	std::string path_;
+	/// configurations
+	std::map<key, launch_config> entries_;
+	/// protects entries_
+	std::mutex mutex_;
+};
+
+/// database used by autotune and the math operations
+inline tuning_db& get_tuning_db()
+{
+	static tuning_db db(get_tuning_db_name());
+	return db;
+}
+
+} // namespace aura
+} // namespace boost
+
+#endif // AURA_TUNING_DB_HPP
+
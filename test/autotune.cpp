@@ -0,0 +1,159 @@
+#define BOOST_TEST_MODULE autotune
+
+#include <cstdio>
+#include <vector>
+#include <sys/stat.h>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/autotune.hpp>
+#include <boost/aura/math/blas/sum.hpp>
+
+using namespace boost::aura;
+
+// database
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(database)
+{
+	std::string p = get_tuning_db_name() + "_test";
+	std::remove(p.c_str());
+	{
+		tuning_db db(p);
+		BOOST_CHECK(db.size() == 0);
+		db.insert("device a", "kernel", 1000, launch_config(64, 1, 4));
+		db.insert("device b", "kernel", 1000, launch_config(256));
+	}
+	// the file is only accessible by the user
+	struct stat st;
+	BOOST_CHECK(0 == stat(p.c_str(), &st) && 0 == (st.st_mode & 077));
+	tuning_db db(p);
+	BOOST_CHECK(db.size() == 2);
+	launch_config c;
+	BOOST_CHECK(db.find("device a", "kernel", 1000, c));
+	BOOST_CHECK(c == launch_config(64, 1, 4));
+	// same size class
+	BOOST_CHECK(db.find("device b", "kernel", 1023, c));
+	BOOST_CHECK(c == launch_config(256));
+	BOOST_CHECK(!db.find("device b", "kernel", 1024, c));
+	BOOST_CHECK(!db.find("device c", "kernel", 1000, c));
+	db.clear();
+	BOOST_CHECK(tuning_db(p).size() == 0);
+	std::remove(p.c_str());
+}
+
+// tune
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(tune)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		feed f(d);
+		tuning_db db;
+		std::vector<launch_config> candidates = {
+			launch_config(64), launch_config(128)
+		};
+		std::size_t runs = 0;
+		auto run = [&](const launch_config&) { runs++; };
+
+		// not tuned, the default is used
+		if (!AURA_AUTOTUNE) {
+			BOOST_CHECK(tuned_config(d, f, "test", 100, candidates,
+						run, db) == candidates[0]);
+			BOOST_CHECK(runs == 0);
+		}
+		launch_config c = autotune(d, f, "test", 100, candidates,
+				run, db);
+		BOOST_CHECK(runs == 2*(1+AURA_AUTOTUNE_RUNS));
+		BOOST_CHECK(tuned_config(d, f, "test", 100, candidates,
+					run, db) == c);
+	}
+}
+
+// reduction
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(reduction)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		feed f(d);
+		std::size_t n = 100003;
+		std::vector<float> h(n, 1.);
+		device_array<float> a(n, d);
+		device_array<float> r(1, d);
+		backend::copy(a.begin(), &h[0], n, f);
+
+		// every configuration sums correctly
+		auto kernel_data = math::detail::sum_kernel_name(0.f);
+		for (auto& c : math::detail::get_reduction_candidates(d, 128,
+					sizeof(float))) {
+			math::memset_zero(r, f);
+			std::string source = math::detail::get_reduction_source(
+					std::get<1>(kernel_data), c);
+			kernel k = d.load_from_string(std::get<0>(kernel_data),
+					source.c_str(), AURA_BACKEND_COMPILE_FLAGS);
+			invoke(k, math::detail::get_reduction_mesh(n, c),
+					bundle(c.bundle), args(a.begin().get_base(),
+						r.begin().get_base(), n), f);
+			float s = 0;
+			backend::copy(&s, r.begin(), 1, f);
+			wait_for(f);
+			BOOST_CHECK_CLOSE(s, (float)n, 1e-3);
+		}
+	}
+}
+
+// tuned_invoke
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(tuned_invoke)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		auto kernel_data = math::detail::sum_kernel_name(0.f);
+		kernel k = d.load_from_string(std::get<0>(kernel_data),
+				std::get<1>(kernel_data), AURA_BACKEND_COMPILE_FLAGS);
+		auto& cache = d.get_context()->get_launch_cache();
+		std::size_t sc = detail::get_size_class(1000);
+		BOOST_CHECK(cache.get_bundle(k, sc) == 0);
+		cache.set_bundle(k, sc, 32);
+		// same size class
+		BOOST_CHECK(cache.get_bundle(k, detail::get_size_class(600)) == 32);
+		BOOST_CHECK(cache.get_bundle(k, detail::get_size_class(1024)) == 0);
+		cache.set_bundle(k, sc, 0);
+		BOOST_CHECK(cache.get_bundle(k, sc) == 0);
+	}
+}
+
+
+// cached_launch
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(cached_launch)
+{
+	detail::launch_cache cache;
+	std::size_t sc = detail::get_size_class(1000);
+	BOOST_CHECK(cache.find_launch("kernel", sc) == nullptr);
+	detail::tuned_launch t;
+	t.config = launch_config(64, 1, 4);
+	t.source = "source";
+	const detail::tuned_launch* l = cache.set_launch("kernel", sc, t);
+	BOOST_CHECK(l == cache.find_launch("kernel", sc));
+	BOOST_CHECK(l->config == launch_config(64, 1, 4));
+	BOOST_CHECK(l->source == "source");
+	// a configuration chosen before is kept
+	t.config = launch_config(256);
+	BOOST_CHECK(cache.set_launch("kernel", sc, t) == l);
+	BOOST_CHECK(l->config == launch_config(64, 1, 4));
+	BOOST_CHECK(cache.find_launch("kernel",
+				detail::get_size_class(1024)) == nullptr);
+	BOOST_CHECK(cache.find_launch("other", sc) == nullptr);
+}
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE backend.args
+
+#include <cstdint>
+#include <cstring>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/meta/tsizeof.hpp>
+
+using namespace boost::aura;
+using namespace boost::aura::backend;
+
+// pointer to packed argument i
+template <typename A>
+const char* arg_ptr(const A& a, std::size_t i)
+{
+#if AURA_BACKEND_OPENCL
+	return (const char*)a[i].first;
+#elif AURA_BACKEND_CUDA
+	return (const char*)a[i];
+#endif
+}
+
+// value of packed argument i
+template <typename T, typename A>
+T arg_value(const A& a, std::size_t i)
+{
+	T r;
+	std::memcpy(&r, arg_ptr(a, i), sizeof(T));
+	return r;
+}
+
+// layout
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(layout) 
+{
+	typedef tlayout<0, char, int, double, char, short> l;
+	BOOST_CHECK(l::offset(0) == 0);
+	BOOST_CHECK(l::offset(1) == alignof(int));
+	BOOST_CHECK(l::offset(2) == 8);
+	BOOST_CHECK(l::offset(3) == 16);
+	BOOST_CHECK(l::offset(4) == 16 + alignof(short));
+	BOOST_CHECK(l::size(0) == sizeof(char));
+	BOOST_CHECK(l::size(1) == sizeof(int));
+	BOOST_CHECK(l::size(2) == sizeof(double));
+	BOOST_CHECK(l::size(3) == sizeof(char));
+	BOOST_CHECK(l::size(4) == sizeof(short));
+	BOOST_CHECK(l::sz == 16 + alignof(short) + sizeof(short));
+
+	// every offset is a multiple of the alignment of its type
+	for (std::size_t i=0; i<5; i++) {
+		BOOST_CHECK(l::offset(i) % l::size(i) == 0);
+	}
+
+	BOOST_CHECK(talignof<>::al == 1);
+	BOOST_CHECK(talignof<char>::al == 1);
+	BOOST_CHECK((talignof<char, double, short>::al == alignof(double)));
+	BOOST_CHECK(tlayout<0>::sz == 0);
+	BOOST_CHECK((tlayout<3, int>::offset(0) == alignof(int)));
+}
+
+// pack
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(pack) 
+{
+	auto a = args((char)1, (double)2.5, (char)3, (int)4, (short)5,
+			(std::uint64_t)6);
+	BOOST_CHECK(a.size() == 6);
+	BOOST_CHECK(alignof(decltype(a)) >= alignof(double));
+	BOOST_CHECK(arg_value<char>(a, 0) == 1);
+	BOOST_CHECK(arg_value<double>(a, 1) == 2.5);
+	BOOST_CHECK(arg_value<char>(a, 2) == 3);
+	BOOST_CHECK(arg_value<int>(a, 3) == 4);
+	BOOST_CHECK(arg_value<short>(a, 4) == 5);
+	BOOST_CHECK(arg_value<std::uint64_t>(a, 5) == 6);
+
+	// arguments are aligned in memory and do not overlap
+	BOOST_CHECK((std::uintptr_t)arg_ptr(a, 1) % alignof(double) == 0);
+	BOOST_CHECK((std::uintptr_t)arg_ptr(a, 3) % alignof(int) == 0);
+	BOOST_CHECK((std::uintptr_t)arg_ptr(a, 4) % alignof(short) == 0);
+	BOOST_CHECK((std::uintptr_t)arg_ptr(a, 5) %
+			alignof(std::uint64_t) == 0);
+	BOOST_CHECK(arg_ptr(a, 0) + sizeof(char) <= arg_ptr(a, 1));
+	BOOST_CHECK(arg_ptr(a, 1) + sizeof(double) <= arg_ptr(a, 2));
+	BOOST_CHECK(arg_ptr(a, 2) + sizeof(char) <= arg_ptr(a, 3));
+	BOOST_CHECK(arg_ptr(a, 3) + sizeof(int) <= arg_ptr(a, 4));
+	BOOST_CHECK(arg_ptr(a, 4) + sizeof(short) <= arg_ptr(a, 5));
+}
+
+#if AURA_BACKEND_OPENCL
+
+// buffers
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(buffers) 
+{
+	cl_mem m = nullptr;
+	BOOST_CHECK(get_buffers(args(m, 1.0f, (unsigned long)8)) == 1);
+	BOOST_CHECK(get_buffers(args((unsigned long)8, m, m)) == 6);
+	BOOST_CHECK(get_buffers(args(1.0f, (std::uint64_t)8)) == 0);
+}
+
+#endif // AURA_BACKEND_OPENCL
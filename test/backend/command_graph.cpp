@@ -0,0 +1,156 @@
+#define BOOST_TEST_MODULE backend.command_graph
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+
+using namespace boost::aura::backend;
+
+const char * kernel_source = R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void command_graph_scale(AURA_GLOBAL float* A,
+			float alpha, unsigned long N)
+	{
+		unsigned int i = get_mesh_id();
+		if (i < N) {
+			A[i] *= alpha;
+		}
+	}
+
+	)aura_kernel";
+
+// record_replay
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(record_replay) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		const std::size_t n = 1024;
+		device d(0);
+		feed f(d);
+		kernel k = d.load_from_string("command_graph_scale",
+				kernel_source, AURA_BACKEND_COMPILE_FLAGS);
+		std::vector<float> h(n, 1.), r(n, 0.);
+		device_ptr<float> m = device_malloc<float>(n, d);
+
+		command_graph g;
+		begin_capture(f, g);
+		copy(m, &h[0], n, f);
+		invoke(k, n, args(m.get_base(), 2.0f, n), f);
+		command_graph::slot alpha = g.get_slot(1);
+		copy(&r[0], m, n, f);
+		end_capture(f);
+		BOOST_CHECK(g.size() == 3);
+
+		// nothing ran while capturing
+		wait_for(f);
+		BOOST_CHECK(r[0] == 0.);
+
+		g.replay(f);
+		wait_for(f);
+		for (auto x : r) {
+			BOOST_CHECK(x == 2.);
+		}
+
+		// host data and scalars are read on every replay
+		std::fill(h.begin(), h.end(), 3.);
+		g.set(alpha, 4.0f);
+		g.replay(f);
+		wait_for(f);
+		for (auto x : r) {
+			BOOST_CHECK(x == 12.);
+		}
+		device_free(m);
+	}
+}
+
+// out_of_order
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(out_of_order) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		const std::size_t n = 1024;
+		const std::size_t coils = 4;
+		device d(0);
+		feed f(d, boost::aura::feed_order::out_of_order);
+		kernel k = d.load_from_string("command_graph_scale",
+				kernel_source, AURA_BACKEND_COMPILE_FLAGS);
+		std::vector<std::vector<float> > h, r;
+		std::vector<device_ptr<float> > m;
+		command_graph g;
+		begin_capture(f, g);
+		for (std::size_t i=0; i<coils; i++) {
+			h.push_back(std::vector<float>(n, (float)i));
+			r.push_back(std::vector<float>(n, -1.));
+			m.push_back(device_malloc<float>(n, d));
+			copy(m[i], &h[i][0], n, f);
+			invoke(k, n, args(m[i].get_base(), 2.0f, n), f);
+			copy(&r[i][0], m[i], n, f);
+		}
+		end_capture(f);
+		// only commands on the same memory depend on each other,
+		// the scalar n is no memory object
+		for (std::size_t i=0; i<coils; i++) {
+			BOOST_CHECK(g.get_deps(3*i).empty());
+			BOOST_CHECK(g.get_deps(3*i+1) ==
+					std::vector<std::size_t>(1, 3*i));
+			BOOST_CHECK(g.get_deps(3*i+2) ==
+					std::vector<std::size_t>(1, 3*i+1));
+		}
+		g.replay(f);
+		wait_for(f);
+		for (std::size_t i=0; i<coils; i++) {
+			for (auto x : r[i]) {
+				BOOST_CHECK(x == 2.*i);
+			}
+			device_free(m[i]);
+		}
+	}
+}
+
+
+// replay_thread
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(replay_thread) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		const std::size_t n = 1024;
+		device d(0);
+		feed f(d);
+		kernel k = d.load_from_string("command_graph_scale",
+				kernel_source, AURA_BACKEND_COMPILE_FLAGS);
+		std::vector<float> h(n, 1.), r(n, 0.);
+		device_ptr<float> m = device_malloc<float>(n, d);
+
+		command_graph g;
+		begin_capture(f, g);
+		copy(m, &h[0], n, f);
+		invoke(k, n, args(m.get_base(), 2.0f, n), f);
+		copy(&r[0], m, n, f);
+		end_capture(f);
+
+		// another host thread replays with its own kernel
+		std::thread t([&]() {
+			feed f2(d);
+			g.replay(f2);
+			wait_for(f2);
+		});
+		t.join();
+		for (auto x : r) {
+			BOOST_CHECK(x == 2.);
+		}
+		device_free(m);
+	}
+}
@@ -27,6 +27,15 @@ BOOST_AUTO_TEST_CASE(extended)
 	  device_info di = device_get_info(d);
 	  std::cout << "device ordinal " << i << ": ";
 	  print_device_info(di);
+	  BOOST_CHECK(di.compute_units > 0);
+	  BOOST_CHECK(di.global_memory > 0);
+	  BOOST_CHECK(di.max_alloc > 0 && di.max_alloc <= di.global_memory);
+	  BOOST_CHECK(di.local_memory > 0);
+	  BOOST_CHECK(di.preferred_vector_width > 0);
+	  BOOST_CHECK(di.max_fibers_per_bundle > 0);
+	  // the info is cached
+	  BOOST_CHECK(&d.get_context()->get_info() ==
+			  &d.get_context()->get_info());
   }
 }
 
@@ -106,3 +106,42 @@ BOOST_AUTO_TEST_CASE(basic_opencl)
 
 }
 
+// prime
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(prime) 
+{
+	const std::array<std::size_t, 4> max_mb = {{
+		AURA_OPENCL_MAX_BUNDLE, 
+		AURA_OPENCL_MAX_MESH0, 
+		AURA_OPENCL_MAX_MESH1, 
+		AURA_OPENCL_MAX_MESH2 
+	}};
+	std::array<bool, 4> mask = {{false, true, false, false}};
+
+	// exact geometry of a large prime exceeds the maximum mesh size
+	std::array<std::size_t, 4> mesh_bundle = 
+		boost::aura::detail::calc_launch_geometry(1000003, max_mb,
+				mask, 64, boost::aura::bounds_fit::exact);
+	BOOST_CHECK((long int)(
+			boost::aura::product(mesh_bundle)/mesh_bundle[0]) ==
+			1000003);
+
+	// padded geometry uses full bundles and covers all elements
+	mesh_bundle = boost::aura::detail::calc_launch_geometry(1000003,
+			max_mb, mask, 64, boost::aura::bounds_fit::padded);
+	BOOST_CHECK(mesh_bundle[0] == AURA_OPENCL_MAX_BUNDLE);
+	BOOST_CHECK(mesh_bundle[1] % mesh_bundle[0] == 0);
+	BOOST_CHECK(mesh_bundle[1] <= max_mb[1]*max_mb[0]);
+	std::size_t covered = boost::aura::product(mesh_bundle)/mesh_bundle[0];
+	BOOST_CHECK(covered >= 1000003);
+	BOOST_CHECK(covered < 1000003 + 4*mesh_bundle[0]);
+
+	// sizes with a good exact geometry are not padded
+	mesh_bundle = boost::aura::detail::calc_launch_geometry(512*512,
+			max_mb, mask, 64, boost::aura::bounds_fit::padded);
+	BOOST_CHECK((long int)(
+			boost::aura::product(mesh_bundle)/mesh_bundle[0]) ==
+			512*512);
+}
+
@@ -68,3 +68,29 @@ BOOST_AUTO_TEST_CASE(multiple_vector)
 }
 
 
+
+// out_of_order
+// commands of an out-of-order feed are ordered by wait lists only
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(out_of_order) 
+{
+	int testsize = 512; 
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+	device d(0);  
+	feed f(d, boost::aura::feed_order::out_of_order);
+	BOOST_CHECK(boost::aura::feed_order::out_of_order == f.get_order());
+
+	std::vector<float> a(testsize, 42.), b(testsize, 0.);
+	device_ptr<float> m0 = device_malloc<float>(testsize, d);
+	device_ptr<float> m1 = device_malloc<float>(testsize, d);
+	mark up = copy(m0, &a[0], testsize, f, wait_list());
+	mark dd = copy(m1, m0, testsize, f, wait_list(up));
+	mark down = copy(&b[0], m1, testsize, f, wait_list(dd));
+	wait_for(down);
+	BOOST_CHECK(std::equal(a.begin(), a.end(), b.begin()));
+	device_free(m0);
+	device_free(m1);
+}
@@ -79,3 +79,75 @@ BOOST_AUTO_TEST_CASE(nasty)
 	BOOST_CHECK(&v1[0] == p3);
 }
 
+
+// pool 
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(pool) 
+{
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(num > 0);
+	device d0(0);
+	feed f0(d0);
+	boost::aura::host_allocator<float> a0(f0);
+	boost::aura::host_allocator<float> a1(f0);
+
+	// freed memory is reused by other allocators of the same device
+	float* p0 = a0.allocate(1000);
+	a0.deallocate(p0, 1000);
+	float* p1 = a1.allocate(1000);
+	BOOST_CHECK(p0 == p1);
+	memory m0 = a1.unmap(p1);
+	float* p2 = a1.map(m0);
+	BOOST_CHECK(a1.unmap(p2) == m0);
+	p2 = a1.map(m0);
+	a1.deallocate(p2, 1000);
+	
+	// sizes in the same size class share blocks
+	std::size_t pooled = d0.get_context()->get_host_pool().count();
+	{
+		std::vector<float, boost::aura::host_allocator<float>> v0(
+				1000, a0);
+		std::vector<float, boost::aura::host_allocator<float>> v1(
+				1010, a1);
+	}
+	{
+		std::vector<float, boost::aura::host_allocator<float>> v2(
+				1020, a0);
+		std::vector<float, boost::aura::host_allocator<float>> v3(
+				1000, a1);
+	}
+	BOOST_CHECK(d0.get_context()->get_host_pool().count() == pooled + 1);
+
+	// pooled blocks are shared by allocators with different tags
+	boost::aura::host_allocator<float> ro(f0,
+			boost::aura::memory_tag::ro);
+	float* p3 = ro.allocate(1000);
+	ro.deallocate(p3, 1000);
+	float* p4 = a0.allocate(1000);
+	BOOST_CHECK(p3 == p4);
+	p4[0] = 1.;
+	a0.deallocate(p4, 1000);
+}
+
+// pool_limit
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(pool_limit) 
+{
+	// the pool does not hold more than AURA_HOST_POOL_MAX_BYTES
+	boost::aura::detail::host_pool pool;
+	std::size_t size;
+	boost::aura::detail::host_pool::size_class(1<<20, size);
+	std::vector<char> dummy(AURA_HOST_POOL_MAX_BYTES/size + 1);
+	std::size_t inserted = 0;
+	for (std::size_t i=0; i<dummy.size(); i++) {
+		if (pool.insert(&dummy[i], i+1, size)) {
+			inserted++;
+		}
+	}
+	BOOST_CHECK(pool.size() <= AURA_HOST_POOL_MAX_BYTES);
+	BOOST_CHECK(inserted < dummy.size());
+	pool.clear([](void*, std::uintptr_t) {});
+}
@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE backend.kernel
 
 #include <cstring>
+#include <algorithm>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <boost/aura/backend.hpp>
 #include <boost/aura/config.hpp>
@@ -229,3 +232,52 @@ BOOST_AUTO_TEST_CASE(invoke_atomic)
 	device_free(mem);
 }
 
+// invoke_threads
+// _____________________________________________________________________________
+BOOST_AUTO_TEST_CASE(invoke_threads)
+{
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+	device d(0);
+	std::size_t xdim = 16;
+	std::size_t ydim = 16;
+	const std::size_t threads = 4;
+	const std::size_t iterations = 16;
+
+	std::vector<kernel> kernels(threads);
+	std::vector<std::vector<float> > results(threads);
+	auto work = [&](std::size_t t) {
+		feed f(d);
+		std::vector<float> a(xdim*ydim, 41.);
+		device_ptr<float> mem = device_malloc<float>(xdim*ydim, d);
+		copy(mem, &a[0], xdim*ydim, f);
+		for (std::size_t i=0; i<iterations; i++) {
+			kernels[t] = d.load_from_file("simple_add",
+					kernel_file, AURA_BACKEND_COMPILE_FLAGS);
+			invoke(kernels[t], mesh(ydim, xdim), bundle(xdim),
+					args(mem.get_base()), f);
+		}
+		results[t].resize(xdim*ydim);
+		copy(&results[t][0], mem, xdim*ydim, f);
+		wait_for(f);
+		device_free(mem);
+	};
+	std::vector<std::thread> pool;
+	for (std::size_t t=0; t<threads; t++) {
+		pool.push_back(std::thread(work, t));
+	}
+	for (auto& t : pool) {
+		t.join();
+	}
+	for (std::size_t t=0; t<threads; t++) {
+		BOOST_CHECK(std::all_of(results[t].begin(), results[t].end(),
+			[&](float x) { return x == 41. + iterations; }));
+	}
+	// a thread gets the same kernel again
+	kernel k = d.load_from_file("simple_add", kernel_file,
+			AURA_BACKEND_COMPILE_FLAGS);
+	BOOST_CHECK(k == d.load_from_file("simple_add", kernel_file,
+				AURA_BACKEND_COMPILE_FLAGS));
+}
+
@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE backend.kernel_binaries
+
+#include <vector>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+
+using namespace boost::aura::backend;
+
+const char * kernel_source = R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void kernel_binaries_add(AURA_GLOBAL float* A,
+			unsigned long N)
+	{
+		unsigned int i = get_mesh_id();
+		if (i < N) {
+			A[i] += 1.;
+		}
+	}
+
+	)aura_kernel";
+
+// same kernel name, different result
+const char * other_source = R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void kernel_binaries_add(AURA_GLOBAL float* A,
+			unsigned long N)
+	{
+		unsigned int i = get_mesh_id();
+		if (i < N) {
+			A[i] += 2.;
+		}
+	}
+
+	)aura_kernel";
+
+// run kernel_binaries_add of a module on zeros, return the first element
+float run(module& m, device& d, feed& f)
+{
+	const std::size_t n = 1024;
+	std::vector<float> h(n, 0.);
+	device_ptr<float> dm = device_malloc<float>(n, d);
+	copy(dm, &h[0], n, f);
+	kernel k = create_kernel(m, "kernel_binaries_add");
+	invoke(k, n, args(dm.get_base(), n), f);
+	copy(&h[0], dm, n, f);
+	wait_for(f);
+	device_free(dm);
+	for (auto x : h) {
+		BOOST_CHECK(x == h[0]);
+	}
+	return h[0];
+}
+
+// load_binary
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(load_binary) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		feed f(d);
+		// the registry keeps pointers to the binaries and tables
+		static std::vector<unsigned char> binary, other_binary;
+		{
+			module m(kernel_source, d, AURA_BACKEND_COMPILE_FLAGS);
+			BOOST_CHECK(run(m, d, f) == 1.);
+			binary = m.get_binary();
+			module o(other_source, d, AURA_BACKEND_COMPILE_FLAGS);
+			other_binary = o.get_binary();
+		}
+		BOOST_REQUIRE(!binary.empty());
+		BOOST_REQUIRE(!other_binary.empty());
+
+		static std::string name = detail::get_device_string(
+				get_backend_device(d), CL_DEVICE_NAME);
+		static std::string driver = detail::get_device_string(
+				get_backend_device(d), CL_DRIVER_VERSION);
+		static std::vector<detail::kernel_binary> table;
+		table.push_back(detail::kernel_binary {
+			name.c_str(), driver.c_str(),
+			detail::hash_kernel_source(kernel_source,
+					AURA_BACKEND_COMPILE_FLAGS),
+			&binary[0], binary.size()
+		});
+		detail::register_kernel_binaries r0(&table[0], 1);
+		BOOST_CHECK(nullptr != detail::get_kernel_binaries().find(
+				d.get_key(), get_backend_device(d), kernel_source,
+				AURA_BACKEND_COMPILE_FLAGS));
+		BOOST_CHECK(nullptr == detail::get_kernel_binaries().find(
+				d.get_key(), get_backend_device(d), kernel_source, "-DOTHER"));
+		{
+			module m(kernel_source, d, AURA_BACKEND_COMPILE_FLAGS);
+			BOOST_CHECK(run(m, d, f) == 1.);
+		}
+
+		// a binary registered for the source is used instead of the
+		// source, this one adds 2
+		static std::vector<detail::kernel_binary> other_table(1,
+				table[0]);
+		other_table[0].data = &other_binary[0];
+		other_table[0].size = other_binary.size();
+		detail::register_kernel_binaries r1(&other_table[0], 1);
+		{
+			module m(kernel_source, d, AURA_BACKEND_COMPILE_FLAGS);
+			BOOST_CHECK(run(m, d, f) == 2.);
+		}
+	}
+}
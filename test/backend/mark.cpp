@@ -25,3 +25,36 @@ BOOST_AUTO_TEST_CASE(basic) {
 }
 
 
+
+// timeline 
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(timeline_basic) {
+	initialize();
+	int num = device_get_count();
+	if(0 < num) {
+		device d(0);  
+		feed f(d);
+		feed f2(d);
+		// small ring so that events are recycled
+		timeline t(f, 4);
+		BOOST_CHECK(0 == t.get_value());
+		std::uint64_t v = 0;
+		for (int i=0; i<10; i++) {
+			v = t.signal();
+		}
+		BOOST_CHECK(10 == v);
+		t.enqueue_wait(f2, v);
+		t.wait(v);
+		BOOST_CHECK(t.reached(v));
+		// numbers whose events were recycled are reached too
+		BOOST_CHECK(t.reached(2));
+		wait_for(f2);
+
+		// marks hold their event by value
+		for (int i=0; i<100; i++) {
+			mark m(f);
+			wait_for(m);
+		}
+	}
+}
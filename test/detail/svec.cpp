@@ -3,6 +3,8 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/execution_monitor.hpp> 
 #include <boost/aura/detail/svec.hpp>
+#include <boost/aura/bounds.hpp>
+#include <boost/aura/slice.hpp>
 
 using namespace boost::aura;
 
@@ -165,3 +167,17 @@ BOOST_AUTO_TEST_CASE(split_at_test)
 
 }
 
+// large_bounds
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(large_bounds) 
+{
+	// multi-channel 3D time series with more than 2^31 elements
+	bounds b(512, 512, 128, 16, 8);
+	BOOST_CHECK(product(b) == (std::int64_t)1 << 32);
+	BOOST_CHECK(product(take(4, b)) == (std::int64_t)1 << 29);
+
+	slice s(_, _, _, _, 7);
+	BOOST_CHECK(s[4] * product(take(4, b)) == (std::int64_t)7 << 29);
+}
+
@@ -73,3 +73,33 @@ BOOST_AUTO_TEST_CASE(iteratorinterface) {
 	}
 }
 
+
+// zero_copy
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(zero_copy) {
+	initialize();
+	int num = device_get_count();
+	if(0 < num) {
+		device d(0);
+		feed f(d);
+		std::size_t s = 1024;
+		device_array<float> a(s, d);
+		BOOST_CHECK(a.is_zero_copy() == (AURA_ZERO_COPY &&
+					device_get_info(d).unified_memory));
+
+		// copies behave the same with or without zero copy
+		std::vector<float> data(s);
+		std::iota(data.begin(), data.end(), 0.);
+		copy(data, a, f);
+		device_array<float> b(s, d);
+		copy(a, b, f);
+		std::vector<float> result(s, 0.0);
+		copy(b, result, f);
+		wait_for(f);
+		BOOST_CHECK(std::equal(result.begin(), result.end(),
+					data.begin()));
+		a.set_value(3, 42., f);
+		BOOST_CHECK(a.get_value(3, f) == 42.);
+	}
+}
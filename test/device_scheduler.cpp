@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE device_scheduler
+
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/device_scheduler.hpp>
+
+using namespace boost::aura;
+
+// rank
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(rank) 
+{
+	initialize();
+	boost::filesystem::path cache = boost::filesystem::temp_directory_path() /
+		boost::filesystem::unique_path();
+
+	std::vector<device_rank> r0 = rank_devices(cache);
+	BOOST_CHECK(r0.size() == (std::size_t)device_get_count());
+	BOOST_CHECK(std::is_sorted(r0.begin(), r0.end()));
+
+	// second call is served from the cache
+	std::vector<device_rank> r1 = rank_devices(cache);
+	BOOST_REQUIRE(r0.size() == r1.size());
+	for (std::size_t i=0; i<r0.size(); i++) {
+		BOOST_CHECK(r0[i].ordinal == r1[i].ordinal);
+		BOOST_CHECK(r0[i].name == r1[i].name);
+	}
+	boost::filesystem::remove(cache);
+}
+
+// acquire
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(acquire) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		boost::filesystem::path cache =
+			boost::filesystem::temp_directory_path() /
+			boost::filesystem::unique_path();
+		std::vector<device> d = acquire_devices(1, cache);
+		BOOST_CHECK(d.size() == 1);
+		// the device is locked now
+		BOOST_CHECK(!create_device_lock(d[0].get_ordinal()));
+		BOOST_CHECK_THROW(acquire_devices(num, cache), std::runtime_error);
+		boost::filesystem::remove(cache);
+	}
+}
+
+// stale
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(stale) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		boost::filesystem::path cache =
+			boost::filesystem::temp_directory_path() /
+			boost::filesystem::unique_path();
+		device d(0);
+		device_info di = device_get_info(d);
+
+		// same number of devices but a different device 0
+		{
+			std::ofstream out(cache.c_str());
+			out << num << "\n" << "0 1e12 1e12\t" << di.driver <<
+				"\tanother device\n";
+		}
+		BOOST_CHECK(detail::load_probe_cache(cache, num).empty());
+
+		// same device but a different driver
+		{
+			std::ofstream out(cache.c_str());
+			out << num << "\n" << "0 1e12 1e12\tanother driver\t" <<
+				di.name << "\n";
+		}
+		BOOST_CHECK(detail::load_probe_cache(cache, num).empty());
+
+		// same device and driver
+		{
+			std::ofstream out(cache.c_str());
+			out << num << "\n" << "0 1e12 1e12\t" << di.driver <<
+				"\t" << di.name << "\n";
+		}
+		auto r = detail::load_probe_cache(cache, num);
+		BOOST_REQUIRE(r.size() == 1);
+		BOOST_CHECK(r[0].name == di.name);
+		BOOST_CHECK(r[0].driver == di.driver);
+		boost::filesystem::remove(cache);
+	}
+}
@@ -0,0 +1,162 @@
+#define BOOST_TEST_MODULE distributed_array
+
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_group.hpp>
+#include <boost/aura/distributed_array.hpp>
+#include <boost/aura/math/distributed.hpp>
+
+using namespace boost::aura;
+
+// partition
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(partition)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device_group g(std::vector<std::size_t>({0, 0, 0}));
+		BOOST_CHECK(g.size() == 3);
+		std::vector<std::size_t> p = g.partition(10);
+		BOOST_CHECK(std::accumulate(p.begin(), p.end(),
+					(std::size_t)0) == 10);
+		g.set_weights(std::vector<double>({2., 1., 1.}));
+		p = g.partition(8);
+		BOOST_CHECK(p[0] == 4 && p[1] == 2 && p[2] == 2);
+		// fewer planes than devices
+		p = g.partition(1);
+		BOOST_CHECK(std::accumulate(p.begin(), p.end(),
+					(std::size_t)0) == 1);
+	}
+}
+
+// scatter_gather
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(scatter_gather)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device_group g(std::vector<std::size_t>({0, 0}));
+		bounds b(16, 15);
+		std::vector<float> h(product(b));
+		std::iota(h.begin(), h.end(), 0.);
+		distributed_array<float> a(b, g);
+		BOOST_CHECK(a.num_partitions() == 2);
+		BOOST_CHECK(a.get_partition_offset(1) == 16*8);
+		a.scatter(&h[0]);
+		std::vector<float> r(h.size(), 0.);
+		a.gather(&r[0]);
+		g.synchronize();
+		BOOST_CHECK(std::equal(h.begin(), h.end(), r.begin()));
+	}
+}
+
+// operations
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(operations)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device_group g(std::vector<std::size_t>({0, 0}));
+		bounds b(128, 64);
+		std::size_t n = product(b);
+		std::vector<float> h1(n, 1.), h2(n, 2.), r(n, 0.);
+		distributed_array<float> a1(b, g), a2(b, g), a3(b, g);
+		a1.scatter(&h1[0]);
+		a2.scatter(&h2[0]);
+		g.synchronize();
+
+		math::add(a1, a2, a3);
+		a3.gather(&r[0]);
+		g.synchronize();
+		for (auto x : r) {
+			BOOST_CHECK(x == 3.);
+		}
+		math::mul(a2, a2, a3);
+		a3.gather(&r[0]);
+		g.synchronize();
+		for (auto x : r) {
+			BOOST_CHECK(x == 4.);
+		}
+
+		BOOST_CHECK_CLOSE(math::sum(a2), 2.*n, 1e-3);
+		BOOST_CHECK_CLOSE(math::dot(a1, a2), 2.*n, 1e-3);
+		BOOST_CHECK_CLOSE(math::norm2(a2), 2.*std::sqrt((float)n), 1e-3);
+	}
+}
+
+#if defined AURA_BACKEND_OPENCL && defined CL_VERSION_1_2
+
+// sub_devices
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(sub_devices)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		device_group g = create_sub_device_group(d, 2);
+		// only CPU devices can typically be partitioned
+		if (0 == g.size()) {
+			return;
+		}
+		// sub-devices are told apart from each other and the parent
+		BOOST_CHECK(g.get_device(0).get_key() != d.get_key());
+		BOOST_CHECK(g.get_device(0).get_key() !=
+				g.get_device(1).get_key());
+		BOOST_CHECK(get_device_key(g.get_device(0)) != get_device_key(d));
+		bounds b(64, 64);
+		std::size_t n = product(b);
+		std::vector<float> h(n, 1.);
+		distributed_array<float> a(b, g);
+		a.scatter(&h[0]);
+		g.synchronize();
+		BOOST_CHECK_CLOSE(math::sum(a), (float)n, 1e-3);
+	}
+}
+
+// numa
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(numa)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		device_group g = create_numa_device_group(d);
+		// not a CPU or no affinity domain partitioning
+		if (0 == g.size()) {
+			return;
+		}
+		bounds b(64, 64);
+		std::size_t n = product(b);
+
+		// placed arrays are zero after first touch
+		device_array<float> p = place_array<float>(b, g, g.size()-1);
+		std::vector<float> r(n, 1.);
+		backend::copy(&r[0], p.begin(), n, g.get_feed(g.size()-1));
+		g.synchronize();
+		for (auto x : r) {
+			BOOST_CHECK(x == 0.);
+		}
+
+		std::vector<float> h(n, 1.);
+		distributed_array<float> a(b, g);
+		a.scatter(&h[0]);
+		g.synchronize();
+		BOOST_CHECK_CLOSE(math::sum(a), (float)n, 1e-3);
+	}
+}
+
+#endif
+
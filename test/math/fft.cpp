@@ -7,6 +7,8 @@
 #include <boost/aura/config.hpp>
 #include <boost/aura/device_array.hpp>
 #include <boost/aura/fft.hpp>
+#include <boost/aura/fft_streamed.hpp>
+#include <boost/aura/math/hermitian.hpp>
 
 #include "fft_data.hpp"
 
@@ -359,3 +361,360 @@ BOOST_AUTO_TEST_CASE(range)
 	fft_terminate();
 }
 
+
+// _____________________________________________________________________________
+
+#ifdef AURA_BACKEND_OPENCL
+BOOST_AUTO_TEST_CASE(scratch) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	{
+		feed f1(d); 
+		feed f2(d); 
+
+		bounds b1(1024, 1024);
+		bounds b2(1031, 17);
+		device_array<cfloat> m1(b1, d);
+		device_array<cfloat> m2(b2, d);
+
+		fft fh1(d, f1, b1, fft::type::c2c);
+		fft fh2(d, f1, b2, fft::type::c2c);
+		std::size_t s = std::max(fh1.get_scratch_size(),
+				fh2.get_scratch_size());
+
+		// plans calculated in the same feed share scratch memory
+		fft_forward(m1, m1, fh1, f1);
+		fft_forward(m2, m2, fh2, f1);
+		fft_inverse(m1, m1, fh1, f1);
+		wait_for(f1);
+		BOOST_CHECK(fft_scratch_size(d) == s);
+
+		// another feed gets its own scratch memory
+		fft_forward(m2, m2, fh2, f2);
+		wait_for(f2);
+		BOOST_CHECK(fft_scratch_size(d) ==
+				s + fh2.get_scratch_size());
+	}
+	// scratch memory is released with the feeds
+	BOOST_CHECK(fft_scratch_size(d) == 0);
+	fft_terminate();
+}
+#endif // AURA_BACKEND_OPENCL
+
+// _____________________________________________________________________________
+
+#ifdef AURA_BACKEND_OPENCL
+BOOST_AUTO_TEST_CASE(scratch_out_of_order) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	feed f(d); 
+	feed fo(d, boost::aura::feed_order::out_of_order);
+	bounds b(1031, 17);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+	}
+	fft fh(d, f, b, fft::type::c2c);
+	device_array<cfloat> m(b, d);
+	std::vector<cfloat> reference(N);
+	copy(m.begin(), &signal[0], N, f);
+	fft_forward(m, m, fh, f);
+	copy(&reference[0], m.begin(), N, f);
+	wait_for(f);
+
+	// transforms that share the scratch memory of the feed do not
+	// run at the same time
+	std::vector<device_array<cfloat> > ms;
+	for (int i=0; i<4; i++) {
+		ms.push_back(device_array<cfloat>(b, d));
+		copy(ms[i].begin(), &signal[0], N, fo);
+	}
+	wait_for(fo);
+	for (int i=0; i<4; i++) {
+		fft_forward(ms[i], ms[i], fh, fo);
+	}
+	wait_for(fo);
+	std::vector<cfloat> r(N);
+	for (int i=0; i<4; i++) {
+		copy(&r[0], ms[i].begin(), N, fo);
+		wait_for(fo);
+		for (int j=0; j<N; j++) {
+			BOOST_CHECK(std::abs(r[j]-reference[j]) < 1e-3);
+		}
+	}
+	fft_terminate();
+}
+#endif // AURA_BACKEND_OPENCL
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(streamed) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	feed f(d); 
+
+	bounds b(16, 12, 10);
+	std::vector<cfloat> signal(product(b));
+	for (std::size_t i=0; i<signal.size(); i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%11);
+	}
+
+	// reference, whole volume on device
+	std::vector<cfloat> reference(product(b));
+	device_array<cfloat> m(b, d);
+	fft fh(d, f, b, fft::type::c2c);
+	copy(m.begin(), &signal[0], product(b), f);
+	fft_forward(m, m, fh, f);
+	copy(&reference[0], m.begin(), product(b), f);
+	wait_for(f);
+
+	// room for 3 planes per slab, slabs and pencils do not divide
+	std::vector<cfloat> o(signal);
+	fft_streamed sfh(d, b, 4*3*16*12*sizeof(cfloat));
+	BOOST_CHECK(sfh.get_slab_size() == 3);
+	BOOST_CHECK(sfh.get_pencil_size() == 57);
+	fft_forward(o, sfh);
+	for (std::size_t i=0; i<o.size(); i++) {
+		BOOST_CHECK(std::abs(o[i]-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+
+	fft_inverse(o, sfh);
+#ifdef AURA_BACKEND_CUDA
+	float scale = 1./product(b);
+#else
+	float scale = 1.;
+#endif
+	for (std::size_t i=0; i<o.size(); i++) {
+		BOOST_CHECK(std::abs(o[i]*scale-signal[i]) < 1e-3);
+	}
+
+	// not even a single plane fits
+	BOOST_CHECK_THROW(fft_streamed(d, b, 4*16*sizeof(cfloat)),
+			std::invalid_argument);
+	fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(real) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	feed f(d); 
+
+	bounds b(16, 6, 5);
+	bounds h = fft_hermitian_bounds(b);
+	BOOST_CHECK(h == bounds(9, 6, 5));
+	BOOST_CHECK(fft_padded_bounds(b) == bounds(18, 6, 5));
+
+	std::vector<float> signal(product(b));
+	std::vector<cfloat> csignal(product(b));
+	for (std::size_t i=0; i<signal.size(); i++) {
+		signal[i] = (i*7)%13;
+		csignal[i] = cfloat(signal[i], 0.);
+	}
+
+	// reference, complex transform of real data
+	std::vector<cfloat> reference(product(b));
+	device_array<cfloat> m(b, d);
+	fft fh(d, f, b, fft::type::c2c);
+	copy(m.begin(), &csignal[0], product(b), f);
+	fft_forward(m, m, fh, f);
+	copy(&reference[0], m.begin(), product(b), f);
+
+	// real transform, packed spectrum expanded to full spectrum
+	device_array<float> r(b, d);
+	device_array<cfloat> p(h, d);
+	device_array<cfloat> e(b, d);
+	fft rfh(d, f, b, fft::type::r2c);
+	fft ifh(d, f, b, fft::type::c2r);
+	copy(r.begin(), &signal[0], product(b), f);
+	fft_forward(r, p, rfh, f);
+	math::hermitian_expand(p, e, f);
+	std::vector<cfloat> o(product(b));
+	copy(&o[0], e.begin(), product(b), f);
+	wait_for(f);
+	for (std::size_t i=0; i<o.size(); i++) {
+		BOOST_CHECK(std::abs(o[i]-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+
+	// compress the full spectrum and transform back
+	math::hermitian_compress(m, p, f);
+	fft_inverse(p, r, ifh, f);
+	std::vector<float> ro(product(b));
+	copy(&ro[0], r.begin(), product(b), f);
+	wait_for(f);
+#ifdef AURA_BACKEND_CUDA
+	float scale = 1./product(b);
+#else
+	float scale = 1.;
+#endif
+	for (std::size_t i=0; i<ro.size(); i++) {
+		BOOST_CHECK(std::abs(ro[i]*scale-signal[i]) < 1e-3);
+	}
+	fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+#ifdef AURA_BACKEND_OPENCL
+BOOST_AUTO_TEST_CASE(centered) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	feed f(d); 
+
+	bounds b(8, 6, 4);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+	}
+
+	// reference: shift, transform, shift (half sizes, shifts are equal)
+	auto roll = [&](const std::vector<cfloat>& in) {
+		std::vector<cfloat> out(N);
+		for (int i2=0; i2<b[2]; i2++) {
+			for (int i1=0; i1<b[1]; i1++) {
+				for (int i0=0; i0<b[0]; i0++) {
+					int j0 = (i0 + b[0]/2) % b[0];
+					int j1 = (i1 + b[1]/2) % b[1];
+					int j2 = (i2 + b[2]/2) % b[2];
+					out[j0 + b[0]*(j1 + b[1]*j2)] =
+						in[i0 + b[0]*(i1 + b[1]*i2)];
+				}
+			}
+		}
+		return out;
+	};
+	std::vector<cfloat> reference = roll(signal);
+	device_array<cfloat> m(b, d);
+	fft fh(d, f, b, fft::type::c2c);
+	copy(m.begin(), &reference[0], N, f);
+	fft_forward(m, m, fh, f);
+	copy(&reference[0], m.begin(), N, f);
+	wait_for(f);
+	reference = roll(reference);
+
+	// out-of-place, scaled forward transform
+	device_array<cfloat> o(b, d);
+	fft cfh(d, f, b, fft::type::c2c);
+	cfh.set_centered(true);
+	cfh.set_scale(fft::fwd, 0.5);
+	copy(m.begin(), &signal[0], N, f);
+	fft_forward(m, o, cfh, f);
+	std::vector<cfloat> r(N);
+	copy(&r[0], o.begin(), N, f);
+	wait_for(f);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(r[i]-reference[i]*0.5f) < 1e-3);
+	}
+
+	// in-place inverse transform, default scale 1/N
+	fft_inverse(o, o, cfh, f);
+	copy(&r[0], o.begin(), N, f);
+	wait_for(f);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(r[i]*2.f-signal[i]) < 1e-3);
+	}
+
+	// the shift waits for the transform in an out-of-order feed
+	feed fo(d, boost::aura::feed_order::out_of_order);
+	copy(m.begin(), &signal[0], N, fo);
+	wait_for(fo);
+	fft_forward(m, o, cfh, fo);
+	wait_for(fo);
+	copy(&r[0], o.begin(), N, fo);
+	wait_for(fo);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(r[i]-reference[i]*0.5f) < 1e-3);
+	}
+	fft_terminate();
+}
+#endif // AURA_BACKEND_OPENCL
+
+// _____________________________________________________________________________
+
+#ifdef AURA_BACKEND_OPENCL
+BOOST_AUTO_TEST_CASE(planar) 
+{
+	initialize();
+	fft_initialize(); 
+	int num = device_get_count();
+	BOOST_REQUIRE(0 < num);
+
+	device d(0);
+	feed f(d); 
+
+	bounds b(16, 12);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	std::vector<float> re(N), im(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+		re[i] = signal[i].real();
+		im[i] = signal[i].imag();
+	}
+
+	// reference, interleaved
+	std::vector<cfloat> reference(N);
+	device_array<cfloat> m(b, d);
+	fft fh(d, f, b, fft::type::c2c);
+	copy(m.begin(), &signal[0], N, f);
+	fft_forward(m, m, fh, f);
+	copy(&reference[0], m.begin(), N, f);
+	wait_for(f);
+
+	device_array<float> sre(b, d), sim(b, d), dre(b, d), dim(b, d);
+	auto src = math::make_planar(sre, sim);
+	auto dst = math::make_planar(dre, dim);
+	fft pfh(d, f, b, fft::type::c2c);
+	pfh.set_planar(true, f);
+	copy(sre.begin(), &re[0], N, f);
+	copy(sim.begin(), &im[0], N, f);
+	fft_forward(src, dst, pfh, f);
+	copy(&re[0], dre.begin(), N, f);
+	copy(&im[0], dim.begin(), N, f);
+	wait_for(f);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(cfloat(re[i], im[i])-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+
+	// in-place inverse
+	fft_inverse(dst, dst, pfh, f);
+	copy(&re[0], dre.begin(), N, f);
+	copy(&im[0], dim.begin(), N, f);
+	wait_for(f);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(cfloat(re[i], im[i])-signal[i]) < 1e-3);
+	}
+	fft_terminate();
+}
+#endif // AURA_BACKEND_OPENCL
@@ -230,3 +230,220 @@ BOOST_AUTO_TEST_CASE(batched)
 
 }
 
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(real) 
+{
+	fftw::fft_initialize(); 
+
+	// dimension 0 is fastest and packed
+	bounds b(16, 6, 5);
+	bounds h = fft_hermitian_bounds(b);
+	int N = product(b);
+	
+	std::vector<float> signal(N);
+	std::vector<cfloat> csignal(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = (i*7)%13;
+		csignal[i] = cfloat(signal[i], 0.);
+	}
+
+	// reference, 3d complex transform in the same memory order
+	std::vector<cfloat> reference(N);
+	fftwf_plan rp = fftwf_plan_dft_3d(b[2], b[1], b[0],
+			reinterpret_cast<fftwf_complex*>(&csignal[0]),
+			reinterpret_cast<fftwf_complex*>(&reference[0]),
+			FFTW_FORWARD, FFTW_ESTIMATE);
+	fftwf_execute(rp);
+	fftwf_destroy_plan(rp);
+
+	std::vector<cfloat> p(product(h));
+	fftw::fft rfh(b, fftw::fft::type::r2c);
+	fftw::fft_forward(signal.begin(), p.begin(), rfh);
+	for (int i2=0; i2<b[2]; i2++) {
+		for (int i1=0; i1<b[1]; i1++) {
+			for (int i0=0; i0<h[0]; i0++) {
+				cfloat x = p[i0 + h[0]*(i1 + b[1]*i2)];
+				cfloat y = reference[i0 + b[0]*(i1 + b[1]*i2)];
+				BOOST_CHECK(std::abs(x-y) < 
+						1e-3*std::abs(reference[0]));
+			}
+		}
+	}
+
+	std::vector<float> o(N);
+	fftw::fft ifh(b, fftw::fft::type::c2r);
+	fftw::fft_inverse(p.begin(), o.begin(), ifh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(o[i]/N-signal[i]) < 1e-3);
+	}
+	fftw::fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(centered) 
+{
+	fftw::fft_initialize(); 
+
+	bounds b(8, 6);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+	}
+
+	// reference: shift, transform, shift (half sizes, shifts are equal)
+	auto roll = [&](const std::vector<cfloat>& in) {
+		std::vector<cfloat> out(N);
+		for (int i1=0; i1<b[1]; i1++) {
+			for (int i0=0; i0<b[0]; i0++) {
+				int j0 = (i0 + b[0]/2) % b[0];
+				int j1 = (i1 + b[1]/2) % b[1];
+				out[j0 + b[0]*j1] = in[i0 + b[0]*i1];
+			}
+		}
+		return out;
+	};
+	std::vector<cfloat> reference = roll(signal);
+	fftw::fft fh(b, fftw::fft::type::c2c);
+	fftw::fft_forward(reference.begin(), reference.begin(), fh);
+	reference = roll(reference);
+
+	std::vector<cfloat> o(N);
+	fftw::fft cfh(b, fftw::fft::type::c2c);
+	cfh.set_centered(true);
+	cfh.set_scale(fftw::fft::fwd, 0.5);
+	cfh.set_scale(fftw::fft::inv, 1./N);
+	fftw::fft_forward(signal.begin(), o.begin(), cfh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(o[i]-reference[i]*0.5f) < 1e-3);
+	}
+	
+	std::vector<cfloat> io(N);
+	fftw::fft_inverse(o.begin(), io.begin(), cfh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(io[i]*2.f-signal[i]) < 1e-3);
+	}
+	fftw::fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(planar) 
+{
+	fftw::fft_initialize(); 
+
+	bounds b(16, 12);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	std::vector<float> re(N), im(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+		re[i] = signal[i].real();
+		im[i] = signal[i].imag();
+	}
+
+	// reference, same memory order as the planar data
+	std::vector<cfloat> reference(N);
+	fftwf_plan rp = fftwf_plan_dft_2d(b[1], b[0],
+			reinterpret_cast<fftwf_complex*>(&signal[0]),
+			reinterpret_cast<fftwf_complex*>(&reference[0]),
+			FFTW_FORWARD, FFTW_ESTIMATE);
+	fftwf_execute(rp);
+	fftwf_destroy_plan(rp);
+
+	std::vector<float> ore(N), oim(N);
+	fftw::fft fh(b, fftw::fft::type::c2c);
+	fftw::fft_forward(re.begin(), im.begin(), ore.begin(), oim.begin(), fh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(cfloat(ore[i], oim[i])-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+
+	// in-place inverse
+	fftw::fft_inverse(ore.begin(), oim.begin(),
+			ore.begin(), oim.begin(), fh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(cfloat(ore[i], oim[i])/(float)N-signal[i]) <
+				1e-3);
+	}
+	fftw::fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(non_square) 
+{
+	fftw::fft_initialize(); 
+
+	// dimension 0 is fastest
+	bounds b(8, 6, 4);
+	int N = product(b);
+	std::vector<cfloat> signal(N);
+	for (int i=0; i<N; i++) {
+		signal[i] = cfloat((i*7)%13, (i*3)%5);
+	}
+
+	// reference, 3d complex transform in the same memory order
+	std::vector<cfloat> reference(N);
+	fftwf_plan rp = fftwf_plan_dft_3d(b[2], b[1], b[0],
+			reinterpret_cast<fftwf_complex*>(&signal[0]),
+			reinterpret_cast<fftwf_complex*>(&reference[0]),
+			FFTW_FORWARD, FFTW_ESTIMATE);
+	fftwf_execute(rp);
+	fftwf_destroy_plan(rp);
+
+	std::vector<cfloat> o(N);
+	fftw::fft fh(b, fftw::fft::type::c2c);
+	fftw::fft_forward(signal.begin(), o.begin(), fh);
+	for (int i=0; i<N; i++) {
+		BOOST_CHECK(std::abs(o[i]-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+	fftw::fft_terminate();
+}
+
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(non_square_embedded) 
+{
+	fftw::fft_initialize(); 
+
+	// dimension 0 is fastest, its rows are padded to 8 elements, the
+	// embed is given in the same order as the bounds
+	bounds b(6, 4);
+	const int pitch = 8;
+	const int batch = 2;
+	int N = product(b);
+	int dist = pitch*b[1];
+	std::vector<cfloat> signal(dist*batch, cfloat(0., 0.));
+	std::vector<cfloat> reference(N*batch);
+	for (int k=0; k<batch; k++) {
+		std::vector<cfloat> packed(N);
+		for (int i1=0; i1<b[1]; i1++) {
+			for (int i0=0; i0<b[0]; i0++) {
+				cfloat v((k*5+i0*7+i1*3)%13, (i0+i1*2)%5);
+				signal[k*dist + i0 + pitch*i1] = v;
+				packed[i0 + b[0]*i1] = v;
+			}
+		}
+		fftwf_plan rp = fftwf_plan_dft_2d(b[1], b[0],
+				reinterpret_cast<fftwf_complex*>(&packed[0]),
+				reinterpret_cast<fftwf_complex*>(&reference[k*N]),
+				FFTW_FORWARD, FFTW_ESTIMATE);
+		fftwf_execute(rp);
+		fftwf_destroy_plan(rp);
+	}
+
+	std::vector<cfloat> o(N*batch);
+	fftw::fft fh(b, fftw::fft::type::c2c, batch,
+			fftw::fft_embed(pitch, b[1]), 1, dist,
+			fftw::fft_embed(), 1, N);
+	fftw::fft_forward(signal.begin(), o.begin(), fh);
+	for (int i=0; i<N*batch; i++) {
+		BOOST_CHECK(std::abs(o[i]-reference[i]) <
+				1e-3*std::abs(reference[0]));
+	}
+	fftw::fft_terminate();
+}
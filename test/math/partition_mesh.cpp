@@ -23,11 +23,14 @@ BOOST_AUTO_TEST_CASE(partition_mesh)
 	BOOST_REQUIRE(num > 0);
 	device d(0);  
 
-	std::vector<int> sizes = {1,2,3,4,5,8,13,16,24,28,34,80,128,1011,
+	std::vector<std::size_t> sizes = {1,2,3,4,5,8,13,16,24,28,34,80,128,1011,
 		1024,1031,1024*256-1,1024*256,1024*256+1,1024*512-1,1024*512,
 		1024*512+1,1024*1024-1,1024*1024-3,1024*1024+1,1024*1024*2-1,
 		1024*1024*4-3,1024*1024*8-7,1024*1024*16-531,1024*1024*512-1,
-		1024*1024*512,1024*1024*512+1};
+		1024*1024*512,1024*1024*512+1,
+		// more than 2^31 elements
+		(std::size_t)1024*1024*1024*2+1,
+		(std::size_t)1024*1024*1024*8-7};
 	std::vector<int> bundles = {1,2,4,8,16,32,64,128,256,512,1024,
 		3,5,11,13,113,513};
 
@@ -48,11 +51,15 @@ BOOST_AUTO_TEST_CASE(partition_mesh)
 			
 			BOOST_CHECK(mesh_size[0]*mesh_size[1]*mesh_size[2] 
 					>= x);
+			// larger arrays grow the fastest dimension
 			BOOST_CHECK(mesh_size[0]*mesh_size[1]*mesh_size[2] <= 
+				std::max<std::size_t>(
 					AURA_OPENCL_MAX_MESH0*
 					AURA_OPENCL_MAX_MESH1*
-					AURA_OPENCL_MAX_MESH2
+					AURA_OPENCL_MAX_MESH2,
+					x + mesh_size[0]*mesh_size[1])
 				);
+			BOOST_CHECK(0 == mesh_size[0] % b);
 		}
 	}
 }
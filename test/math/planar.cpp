@@ -0,0 +1,82 @@
+#define BOOST_TEST_MODULE math.planar
+
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/copy.hpp>
+#include <boost/aura/math/planar.hpp>
+#include <boost/aura/math/complex.hpp>
+#include <boost/aura/device_array.hpp>
+
+using namespace boost::aura;
+using namespace boost::aura::math;
+
+
+// planar
+// _____________________________________________________________________________
+
+
+BOOST_AUTO_TEST_CASE(planar_float)
+{
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(num > 0);
+	device d(0);  
+	feed f(d);
+
+	std::default_random_engine generator(1);
+	std::uniform_real_distribution<float> distribution(1., 10.);
+	auto random_float = [&]() -> float { return distribution(generator);};
+
+	std::vector<int> sizes = {1,2,3,4,5,128,1024,1024*1024};
+	for (auto x : sizes) {
+		std::vector<float> re1(x), im1(x), re2(x), im2(x);
+		std::generate(re1.begin(), re1.end(), random_float);
+		std::generate(im1.begin(), im1.end(), random_float);
+		std::generate(re2.begin(), re2.end(), random_float);
+		std::generate(im2.begin(), im2.end(), random_float);
+
+		device_array<float> dre1(x, d), dim1(x, d);
+		device_array<float> dre2(x, d), dim2(x, d);
+		device_array<float> dre3(x, d), dim3(x, d);
+		copy(re1, dre1, f);
+		copy(im1, dim1, f);
+		copy(re2, dre2, f);
+		copy(im2, dim2, f);
+
+		auto a = make_planar(dre1, dim1);
+		auto b = make_planar(dre2, dim2);
+		auto c = make_planar(dre3, dim3);
+		std::vector<float> re3(x), im3(x);
+
+		auto check = [&](std::function<cfloat(cfloat, cfloat)> op) {
+			copy(dre3, re3, f);
+			copy(dim3, im3, f);
+			wait_for(f);
+			bool ok = true;
+			for (int i=0; i<x; i++) {
+				cfloat r = op(cfloat(re1[i], im1[i]),
+						cfloat(re2[i], im2[i]));
+				ok = ok && std::abs(cfloat(re3[i], im3[i]) - r) <
+					1e-5*std::abs(r);
+			}
+			return ok;
+		};
+
+		math::add(a, b, c, f);
+		BOOST_CHECK(check([](cfloat p, cfloat q) { return p+q; }));
+		math::sub(a, b, c, f);
+		BOOST_CHECK(check([](cfloat p, cfloat q) { return p-q; }));
+		math::mul(a, b, c, f);
+		BOOST_CHECK(check([](cfloat p, cfloat q) { return p*q; }));
+		math::div(a, b, c, f);
+		BOOST_CHECK(check([](cfloat p, cfloat q) { return p/q; }));
+		math::conj(a, c, f);
+		BOOST_CHECK(check([](cfloat p, cfloat) { return std::conj(p); }));
+	}
+}
+
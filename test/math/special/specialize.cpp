@@ -0,0 +1,102 @@
+#define BOOST_TEST_MODULE math.specialize
+
+// build one module per shape
+#define AURA_MATH_SPECIALIZE 1
+
+#include <vector>
+#include <complex>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/copy.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/math/special/ndmul.hpp>
+#include <boost/aura/math/special/reduced_sum.hpp>
+
+using namespace boost::aura;
+
+typedef std::complex<float> cfloat;
+
+// source
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(source)
+{
+	std::string s = math::detail::specialize_source("kernel", {
+			{"A", 3}, {"B", 12}});
+	BOOST_CHECK(s == "#define A 3UL\n#define B 12UL\nkernel");
+}
+
+// ndmul
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(ndmul)
+{
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(num > 0);
+	device d(0);
+	feed f(d);
+
+	// two shapes, two modules
+	for (std::size_t x : {3, 5}) {
+		std::size_t y = x*7;
+		std::vector<float> input1(x);
+		std::vector<float> input2(y);
+		std::vector<float> output(y, 0.);
+		for (std::size_t i=0; i<x; i++) {
+			input1[i] = i+1;
+		}
+		for (std::size_t i=0; i<y; i++) {
+			input2[i] = i;
+		}
+		device_array<float> device_input1(x, d);
+		device_array<float> device_input2(y, d);
+		device_array<float> device_output(y, d);
+		copy(input1, device_input1, f);
+		copy(input2, device_input2, f);
+
+		math::ndmul(device_input1, device_input2, device_output, f);
+		copy(device_output, output, f);
+		wait_for(f);
+
+		for (std::size_t i=0; i<y; i++) {
+			BOOST_CHECK(output[i] == input1[i%x] * input2[i]);
+		}
+	}
+}
+
+// reduced_sum
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(reduced_sum)
+{
+	initialize();
+	int num = device_get_count();
+	BOOST_REQUIRE(num > 0);
+	device d(0);
+	feed f(d);
+
+	std::size_t n = 16;
+	std::size_t dimensions = 4;
+	std::vector<cfloat> input(n*dimensions);
+	for (std::size_t i=0; i<input.size(); i++) {
+		input[i] = cfloat(i, 1.);
+	}
+	std::vector<cfloat> output(n);
+	device_array<cfloat> device_input(n*dimensions, d);
+	device_array<cfloat> device_output(n, d);
+	copy(input, device_input, f);
+
+	math::reduced_sum(device_input, device_output, f);
+	copy(device_output, output, f);
+	wait_for(f);
+
+	for (std::size_t i=0; i<n; i++) {
+		cfloat s(0., 0.);
+		for (std::size_t j=0; j<dimensions; j++) {
+			s += input[i+j*n];
+		}
+		BOOST_CHECK(output[i] == s);
+	}
+}
+
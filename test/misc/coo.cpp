@@ -4,9 +4,15 @@
 #include <algorithm>
 #include <vector>
 #include <complex>
+#include <cstdint>
+#include <fstream>
 #include <boost/test/unit_test.hpp>
+
+// small chunks to test chunked transfers
+#define AURA_COO_CHUNK_SIZE 4096
 #include <boost/aura/bounds.hpp>
 #include <boost/aura/misc/coo.hpp>
+#include <boost/aura/misc/coo_stream.hpp>
 
 
 // basic
@@ -29,3 +35,179 @@ BOOST_AUTO_TEST_CASE(basic)
 	BOOST_CHECK(b0 == b1);
 }
 
+
+// map
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(map) 
+{
+	boost::aura::bounds b0(16, 16, 100);
+	std::vector<float> d0(boost::aura::product(b0));
+	for (std::size_t i=0; i<d0.size(); i++) {
+		d0[i] = (float)i;
+	}
+	boost::aura::coo_write(d0.begin(), b0, "test_map.coo");
+
+	auto v = boost::aura::coo_map<float>("test_map.coo",
+			boost::aura::coo_map_populate |
+			boost::aura::coo_map_sequential);
+	boost::aura::bounds b1 = v.get_bounds();
+	BOOST_CHECK(b1 == b0);
+	BOOST_CHECK(v.size() == d0.size());
+	BOOST_CHECK(std::equal(v.begin(), v.end(), d0.begin()));
+}
+
+// upload
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(upload) 
+{
+	using namespace boost::aura;
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		feed f(d);
+		// not a multiple of the chunk size
+		bounds b0(17, 33, 5);
+		std::vector<std::complex<float>> d0(product(b0));
+		for (std::size_t i=0; i<d0.size(); i++) {
+			d0[i] = std::complex<float>((float)i, -(float)i);
+		}
+		device_array<std::complex<float>> a0(b0, d);
+		copy(d0, a0, f);
+		coo_write(a0, "test_device.coo", f);
+
+		bounds b1;
+		std::vector<std::complex<float>> d1;
+		std::tie(d1, b1) = 
+			coo_read<std::complex<float>>("test_device.coo");
+		BOOST_CHECK(b0 == b1);
+		BOOST_CHECK(std::equal(d1.begin(), d1.end(), d0.begin()));
+
+		device_array<std::complex<float>> a2;
+		std::tie(a2, b1) = 
+			coo_read<std::complex<float>>("test_device.coo", d, f);
+		std::vector<std::complex<float>> d2(product(b0));
+		copy(a2, d2, f);
+		wait_for(f);
+		BOOST_CHECK(b0 == b1);
+		BOOST_CHECK(std::equal(d2.begin(), d2.end(), d0.begin()));
+	}
+}
+
+// stream
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(stream) 
+{
+	boost::aura::bounds b0(16, 8, 37);
+	std::vector<float> d0(boost::aura::product(b0));
+	for (std::size_t i=0; i<d0.size(); i++) {
+		d0[i] = (float)i;
+	}
+	boost::aura::coo_write(d0.begin(), b0, "test_stream.coo");
+
+	// 37 planes in chunks of 5, last chunk is smaller
+	boost::aura::coo_stream<float> s("test_stream.coo", 5, 3, 2);
+	boost::aura::bounds b1 = s.get_bounds();
+	BOOST_CHECK(b1 == b0);
+	BOOST_CHECK(s.get_chunk_count() == 8);
+	std::vector<float> d1(d0.size());
+	for (std::size_t i=0; i<s.get_chunk_count(); i++) {
+		const boost::aura::coo_chunk<float>& c = s.acquire();
+		BOOST_CHECK(c.index == i);
+		BOOST_CHECK(c.data.size() == 
+				(std::size_t)boost::aura::product(c.b));
+		std::copy(c.data.begin(), c.data.end(), d1.begin() + c.offset);
+		s.release();
+	}
+	BOOST_CHECK(std::equal(d1.begin(), d1.end(), d0.begin()));
+
+	// upload while reading
+	using namespace boost::aura;
+	initialize();
+	if (0 < device_get_count()) {
+		device d(0);
+		feed f(d);
+		device_array<float> a;
+		std::tie(a, b1) = coo_read_streamed<float>("test_stream.coo",
+				d, f, 4);
+		std::vector<float> d2(d0.size());
+		copy(a, d2, f);
+		wait_for(f);
+		BOOST_CHECK(b1 == b0);
+		BOOST_CHECK(std::equal(d2.begin(), d2.end(), d0.begin()));
+	}
+}
+
+// compressed
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(compressed) 
+{
+	using namespace boost::aura;
+	bounds b0(32, 16, 9);
+	std::vector<std::complex<double>> d0(product(b0));
+	for (std::size_t i=0; i<d0.size(); i++) {
+		d0[i] = std::complex<double>((double)(i%13), 1.0);
+	}
+	coo_write(d0.begin(), b0, "test_lz4.coo", 4, coo_lz4);
+
+	std::array<char, 4096> header;
+	std::ifstream stream("test_lz4.coo", std::ios::in|std::ios::binary);
+	stream.read(&header[0], header.size());
+	coo_header h = coo_parse(header);
+	BOOST_CHECK(h.type == coo_cdouble);
+	BOOST_CHECK(h.compressed());
+	BOOST_CHECK(h.chunks == 3);
+	BOOST_CHECK(h.index < product(b0)*sizeof(std::complex<double>));
+
+	bounds b1;
+	std::vector<std::complex<double>> d1;
+	std::tie(d1, b1) = coo_read<std::complex<double>>("test_lz4.coo");
+	BOOST_CHECK(b0 == b1);
+	BOOST_CHECK(std::equal(d1.begin(), d1.end(), d0.begin()));
+
+	// type is checked
+	BOOST_CHECK_THROW(coo_read<float>("test_lz4.coo"), std::runtime_error);
+
+	coo_stream<std::complex<double>> s("test_lz4.coo", 1);
+	std::vector<std::complex<double>> d2(d0.size());
+	for (std::size_t i=0; i<s.get_chunk_count(); i++) {
+		const coo_chunk<std::complex<double>>& c = s.acquire();
+		std::copy(c.data.begin(), c.data.end(), d2.begin() + c.offset);
+		s.release();
+	}
+	BOOST_CHECK(std::equal(d2.begin(), d2.end(), d0.begin()));
+}
+
+// version
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(version) 
+{
+	using namespace boost::aura;
+	bounds b0(8, 8);
+	std::vector<std::int16_t> d0(product(b0), 7);
+
+	// uncompressed chunked files are readable by version 1 readers
+	coo_write(d0.begin(), b0, "test_chunked.coo", 3, coo_uncompressed);
+	std::array<char, 4096> header;
+	std::ifstream stream("test_chunked.coo", std::ios::in|std::ios::binary);
+	stream.read(&header[0], header.size());
+	bounds b1 = coo_parse_header(header);
+	BOOST_CHECK(b1 == b0);
+	BOOST_CHECK(coo_parse(header).type == coo_int16);
+	std::vector<std::int16_t> d1(product(b0));
+	stream.read((char*)d1.data(), d1.size()*sizeof(std::int16_t));
+	BOOST_CHECK(std::equal(d1.begin(), d1.end(), d0.begin()));
+
+	// version 1 headers say float for complex data
+	std::array<char, 4096> old = 
+		coo_build_header(coo_build_index<std::complex<float>>(b0));
+	coo_header h = coo_parse(old);
+	BOOST_CHECK(h.version == 1);
+	BOOST_CHECK(h.type == coo_cfloat);
+	BOOST_CHECK(h.b == b0);
+}
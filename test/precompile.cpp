@@ -0,0 +1,83 @@
+#define BOOST_TEST_MODULE precompile
+
+#include <vector>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/copy.hpp>
+#include <boost/aura/precompile.hpp>
+#include <boost/aura/math/precompile.hpp>
+
+using namespace boost::aura;
+
+// kernels
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(kernels)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		auto k1 = math::detail::get_add_kernel(0.f, 0.f, 0.f);
+		auto k2 = math::detail::get_sub_kernel(0.f, 0.f, 0.f);
+		std::vector<kernel_source> kernels = {
+			kernel_source(std::get<0>(k1), std::get<1>(k1)),
+			kernel_source(std::get<0>(k2), std::get<1>(k2)),
+			// same module, built once
+			kernel_source(std::get<0>(k1), std::get<1>(k1)),
+			// same module, another kernel, reported with it
+			kernel_source("other", std::get<1>(k1))
+		};
+		precompiler p = precompile(d, kernels, 2);
+		const std::vector<build_report>& r = p.wait();
+		BOOST_CHECK(p.done());
+		BOOST_CHECK(r.size() == 2);
+		for (auto& x : r) {
+			BOOST_CHECK(x.built);
+		}
+		BOOST_CHECK(r[0].name == "add_float");
+		BOOST_CHECK(r[0].kernels ==
+				std::vector<std::string>({"add_float", "other"}));
+		BOOST_CHECK(r[1].kernels ==
+				std::vector<std::string>(1, std::get<0>(k2)));
+		std::ostringstream os;
+		print_build_report(r, os);
+		BOOST_CHECK(os.str().find("add_float, other: ") !=
+				std::string::npos);
+
+		// empty
+		precompiler e;
+		BOOST_CHECK(e.done());
+		BOOST_CHECK(e.wait().empty());
+	}
+}
+
+// math_ops
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(math_ops)
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		device d(0);
+		feed f(d);
+		precompiler p = math::precompile(d, math::op::sum,
+				math::op::memset_zero);
+		// the application prepares its data while the kernels build
+		std::size_t n = 1000;
+		std::vector<float> h(n, 1.);
+		device_array<float> a(n, d);
+		device_array<float> r(1, d);
+		copy(h, a, f);
+		BOOST_CHECK(p.wait().size() == 4);
+		math::sum(a, r, f);
+		float s = 0;
+		copy(r, &s, f);
+		wait_for(f);
+		BOOST_CHECK_CLOSE(s, (float)n, 1e-3);
+	}
+}
+
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE task_graph
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/device_array.hpp>
+#include <boost/aura/task_graph.hpp>
+
+using namespace boost::aura;
+
+const char * kernel_source = R"aura_kernel(
+
+	#include <boost/aura/backend.hpp>
+
+	AURA_KERNEL void task_graph_increment(AURA_GLOBAL float* A,
+			unsigned long N)
+	{
+		unsigned int i = get_mesh_id();
+		if (i < N) {
+			A[i] += 1.0f;
+		}
+	}
+
+	)aura_kernel";
+
+// copies
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(copies) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		const std::size_t n = 1024;
+		const std::size_t chains = 4;
+		device d(0);
+		feed f(d, feed_order::out_of_order);
+		std::vector<std::vector<float> > in, out;
+		std::vector<device_array<float> > a, b;
+		task_graph g;
+		for (std::size_t i=0; i<chains; i++) {
+			in.push_back(std::vector<float>(n, (float)i));
+			out.push_back(std::vector<float>(n, -1.));
+			a.push_back(device_array<float>(n, d));
+			b.push_back(device_array<float>(n, d));
+		}
+		// independent chains: upload, device copy, download
+		for (std::size_t i=0; i<chains; i++) {
+			auto up = g.add_copy(a[i].begin(), &in[i][0], n);
+			auto dd = g.add_copy(b[i].begin(), a[i].begin(), n, {up});
+			g.add_copy(&out[i][0], b[i].begin(), n, {dd});
+		}
+		BOOST_CHECK(g.size() == 3*chains);
+		g.run(f);
+		g.wait();
+		for (std::size_t i=0; i<chains; i++) {
+			BOOST_CHECK(std::equal(in[i].begin(), in[i].end(),
+						out[i].begin()));
+		}
+
+		// same graph across two in-order feeds
+		feed f1(d), f2(d);
+		for (auto& o : out) {
+			std::fill(o.begin(), o.end(), -1.);
+		}
+		g.run(std::vector<feed*>({&f1, &f2}));
+		g.wait();
+		for (std::size_t i=0; i<chains; i++) {
+			BOOST_CHECK(std::equal(in[i].begin(), in[i].end(),
+						out[i].begin()));
+		}
+	}
+}
+
+// kernel 
+// _____________________________________________________________________________
+
+BOOST_AUTO_TEST_CASE(kernel_task) 
+{
+	initialize();
+	int num = device_get_count();
+	if (0 < num) {
+		const std::size_t n = 1024;
+		device d(0);
+		feed f(d, feed_order::out_of_order);
+		kernel k = d.load_from_string("task_graph_increment",
+				kernel_source, AURA_BACKEND_COMPILE_FLAGS);
+		std::vector<float> h(n, 1.), r(n, 0.);
+		device_array<float> a(n, d);
+		task_graph g;
+		auto up = g.add_copy(a.begin(), &h[0], n);
+		auto add = g.add([&](feed& f, const wait_list& w) {
+				return invoke(k, n, args(a.begin().get_base(), n), f, w);
+			}, {up});
+		g.add_copy(&r[0], a.begin(), n, {add});
+		g.run(f);
+		g.wait();
+		for (auto x : r) {
+			BOOST_CHECK(x == 2.);
+		}
+	}
+}
+
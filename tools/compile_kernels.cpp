@@ -0,0 +1,130 @@
+// compiles the library kernels ahead of time for the OpenCL devices of this
+// machine and writes the program binaries to a header
+
+// call it with:
+// compile_kernels <output header> [kernel files]
+// kernel files are modules loaded with device::load_from_file (e.g. the
+// kernels of the benchmarks), the math kernels are always compiled
+
+// include the generated header in one translation unit of an application,
+// modules that have a binary for the device and driver are then loaded
+// from the binary, all others are still compiled at runtime
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <unordered_set>
+#include <boost/aura/backend.hpp>
+#include <boost/aura/math/precompile.hpp>
+
+using namespace boost::aura;
+
+namespace
+{
+
+std::string read_file(const char* filename)
+{
+	std::ifstream in(filename, std::ios::in);
+	std::ostringstream os;
+	os << in.rdbuf();
+	return os.str();
+}
+
+// C string literal
+std::string quote(const std::string& s)
+{
+	std::string r = "\"";
+	for (char c : s) {
+		if ('"' == c || '\\' == c) {
+			r += '\\';
+		}
+		r += c;
+	}
+	return r + "\"";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	if (argc < 2) {
+		std::cerr << "usage: " << argv[0] <<
+			" <output header> [kernel files]" << std::endl;
+		return 1;
+	}
+	initialize();
+
+	std::vector<kernel_source> files;
+	for (int i=2; i<argc; i++) {
+		files.push_back(kernel_source(argv[i], read_file(argv[i])));
+	}
+
+	std::ostringstream data;
+	std::ostringstream table;
+	std::size_t num = 0;
+	for (int n=0; n<device_get_count(); n++) {
+		device d(n);
+		std::string name = d.get_key();
+		std::string driver = backend::detail::get_device_string(
+				d.get_backend_device(), CL_DRIVER_VERSION);
+		std::cout << "compiling kernels for " << name << " (" <<
+			driver << ")" << std::endl;
+
+		// the default launch configurations depend on the device
+		std::vector<kernel_source> kernels = files;
+		for (int o=0; o<=(int)math::op::hermitian; o++) {
+			std::vector<kernel_source> k =
+				math::get_kernel_sources(d, (math::op)o);
+			kernels.insert(kernels.end(), k.begin(), k.end());
+		}
+
+		std::unordered_set<std::string> sources;
+		for (auto& k : kernels) {
+			if (!sources.insert(k.source).second) {
+				continue;
+			}
+			backend::module m(k.source.c_str(), d,
+					AURA_BACKEND_COMPILE_FLAGS);
+			std::vector<unsigned char> binary = m.get_binary();
+			if (binary.empty()) {
+				std::cerr << "no binary for " << k.name <<
+					std::endl;
+				continue;
+			}
+			data << "static const unsigned char " <<
+				"aura_kernel_binary_" << num << "[] = {";
+			for (std::size_t i=0; i<binary.size(); i++) {
+				data << (0 == i % 16 ? "\n\t" : " ") <<
+					(unsigned int)binary[i] << ",";
+			}
+			data << "\n};\n\n";
+			table << "\t{" << quote(name) << ", " << quote(driver) <<
+				", " << backend::detail::hash_kernel_source(
+					k.source.c_str(),
+					AURA_BACKEND_COMPILE_FLAGS) << "ULL, " <<
+				"aura_kernel_binary_" << num << ", " <<
+				binary.size() << "},\n";
+			num++;
+		}
+	}
+
+	std::ofstream out(argv[1]);
+	out << "// generated by compile_kernels, do not edit\n\n" <<
+		"#include <boost/aura/backend/opencl/detail/" <<
+		"kernel_binaries.hpp>\n\n" << data.str() <<
+		"static const boost::aura::backend_detail::opencl::detail::" <<
+		"kernel_binary aura_kernel_binaries[] = {\n" << table.str();
+	if (0 == num) {
+		out << "\t{\"\", \"\", 0, nullptr, 0},\n";
+	}
+	out << "};\n\n" <<
+		"static const boost::aura::backend_detail::opencl::detail::" <<
+		"register_kernel_binaries aura_register_kernel_binaries(\n" <<
+		"\taura_kernel_binaries, " << num << ");\n";
+	std::cout << num << " kernel binaries written to " << argv[1] <<
+		std::endl;
+	return out.good() ? 0 : 1;
+}